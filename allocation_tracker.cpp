@@ -0,0 +1,233 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#if defined(__linux__) || defined(__GLIBC__)
+#include <malloc.h>
+#define TRACKER_BLOCK_SIZE(p) malloc_usable_size(p)
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define TRACKER_BLOCK_SIZE(p) malloc_size(p)
+#elif defined(_WIN32)
+#include <malloc.h>
+#define TRACKER_BLOCK_SIZE(p) _msize(p)
+#endif
+#include "allocation_tracker.h"
+
+static const size_t PHASE_COUNT = static_cast<size_t>(AllocationPhase::WRITER) + 1;
+static const char* const PHASE_NAMES[PHASE_COUNT] = { "other", "lexer", "loader", "parser", "writer" };
+
+// һ׶εļ߳ͬʱ
+struct PhaseState
+{
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> frees;
+    std::atomic<int64_t> peakLiveBytes;
+};
+
+// ǳʼ뵥Ԫľ̬ʼеoperator newʱҲѿ
+static std::atomic<bool> tracking(false);
+static std::atomic<int64_t> liveBytes(0);
+static std::atomic<int64_t> peakLiveBytes(0);
+static PhaseState phases[PHASE_COUNT];
+static thread_local AllocationPhase currentPhase = AllocationPhase::OTHER;
+
+// ĿʵʴСƽ̨֧ʱĴС㣬ͷʱΪ0
+static size_t blockSize(void* p, size_t requested)
+{
+#ifdef TRACKER_BLOCK_SIZE
+    (void)requested;
+    return TRACKER_BLOCK_SIZE(p);
+#else
+    (void)p;
+    return requested;
+#endif
+}
+
+static void raisePeak(std::atomic<int64_t>& peak, int64_t live)
+{
+    int64_t seen = peak.load(std::memory_order_relaxed);
+    while (live > seen && !peak.compare_exchange_weak(seen, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+static void recordAllocation(void* p, size_t requested)
+{
+    int64_t size = static_cast<int64_t>(blockSize(p, requested));
+    PhaseState& state = phases[static_cast<size_t>(currentPhase)];
+    state.allocations.fetch_add(1, std::memory_order_relaxed);
+    state.bytes.fetch_add(static_cast<uint64_t>(size), std::memory_order_relaxed);
+    int64_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    raisePeak(state.peakLiveBytes, live);
+    raisePeak(peakLiveBytes, live);
+}
+
+// ʼͳǰĿ֮ͷʱҲȥֽټ0
+static void recordFree(void* p)
+{
+    phases[static_cast<size_t>(currentPhase)].frees.fetch_add(1, std::memory_order_relaxed);
+    int64_t size = static_cast<int64_t>(blockSize(p, 0));
+    int64_t live = liveBytes.load(std::memory_order_relaxed);
+    while (!liveBytes.compare_exchange_weak(live, live > size ? live - size : 0, std::memory_order_relaxed))
+    {
+    }
+}
+
+// ׼Ҫ䣺ʧʱnew_handlerԣûnew_handlerʱnullptr
+static void* allocate(size_t size)
+{
+    if (size == 0) size = 1;
+    void* p = std::malloc(size);
+    while (p == nullptr)
+    {
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) return nullptr;
+        handler();
+        p = std::malloc(size);
+    }
+    if (tracking.load(std::memory_order_relaxed)) recordAllocation(p, size);
+    return p;
+}
+
+static void release(void* p)
+{
+    if (p == nullptr) return;
+    if (tracking.load(std::memory_order_relaxed)) recordFree(p);
+    std::free(p);
+}
+
+void* operator new(std::size_t size)
+{
+    void* p = allocate(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size)
+{
+    void* p = allocate(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void* p) noexcept
+{
+    release(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    release(p);
+}
+
+void enableAllocationTracking()
+{
+    if (tracking.exchange(true)) return;
+    std::atexit(printAllocationReport);
+}
+
+// ALLOCSTATSǿҲΪ0ʱ̬ʼ֮ǰʼͳƣ
+// ˺ͷŵĿ鶼ͳƹģֽͷֵӽ̿ʼʱ
+static void enableFromEnvironment()
+{
+    const char* value = std::getenv("ALLOCSTATS");
+    if (value != nullptr && value[0] != '\0' && !(value[0] == '0' && value[1] == '\0')) enableAllocationTracking();
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((constructor(101))) static void startTrackingEarly()
+{
+    enableFromEnvironment();
+}
+#else
+static const bool startedEarly = (enableFromEnvironment(), true);
+#endif
+
+bool allocationTrackingEnabled()
+{
+    return tracking.load(std::memory_order_relaxed);
+}
+
+void setAllocationPhase(AllocationPhase phase)
+{
+    currentPhase = phase;
+}
+
+AllocationCounters allocationCounters(AllocationPhase phase)
+{
+    const PhaseState& state = phases[static_cast<size_t>(phase)];
+    AllocationCounters counters;
+    counters.allocations = state.allocations.load(std::memory_order_relaxed);
+    counters.bytes = state.bytes.load(std::memory_order_relaxed);
+    counters.frees = state.frees.load(std::memory_order_relaxed);
+    counters.peakLiveBytes = state.peakLiveBytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+void printAllocationReport()
+{
+    std::fprintf(stderr, "%-8s %14s %16s %14s %18s\n", "phase", "allocations", "bytes", "frees", "peak live bytes");
+    AllocationCounters total;
+    for (size_t i = 0; i < PHASE_COUNT; ++i)
+    {
+        AllocationCounters counters = allocationCounters(static_cast<AllocationPhase>(i));
+        std::fprintf(stderr, "%-8s %14llu %16llu %14llu %18lld\n", PHASE_NAMES[i],
+            static_cast<unsigned long long>(counters.allocations), static_cast<unsigned long long>(counters.bytes),
+            static_cast<unsigned long long>(counters.frees), static_cast<long long>(counters.peakLiveBytes));
+        total.allocations += counters.allocations;
+        total.bytes += counters.bytes;
+        total.frees += counters.frees;
+    }
+    long long peak = static_cast<long long>(peakLiveBytes.load(std::memory_order_relaxed));
+    std::fprintf(stderr, "%-8s %14llu %16llu %14llu %18lld\n", "total",
+        static_cast<unsigned long long>(total.allocations), static_cast<unsigned long long>(total.bytes),
+        static_cast<unsigned long long>(total.frees), peak);
+    std::fprintf(stderr, "peak live heap: %.1f MB, live at exit: %lld bytes\n", static_cast<double>(peak) / (1024.0 * 1024.0),
+        static_cast<long long>(liveBytes.load(std::memory_order_relaxed)));
+}
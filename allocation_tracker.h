@@ -0,0 +1,42 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <cstdint>
+
+// Ľ׶Σ̼߳¼ˮ߷ʽ´ʷ̵߳ķLEXER
+enum class AllocationPhase
+{
+    OTHER, // гಿ
+    LEXER, // ʷд.dyd
+    LOADER, // .dydӳ.dydb
+    PARSER, // ﷨
+    WRITER, // ̱͵Ԫļ
+};
+
+// һ׶εķͳ
+struct AllocationCounters
+{
+    uint64_t allocations = 0; // 
+    uint64_t bytes = 0; // ֽ
+    uint64_t frees = 0; // ͷŴ
+    int64_t peakLiveBytes = 0; // ý׶νʱõĶֽķֵ
+};
+
+// ʼͳƾoperator new/deleteķ䣬ڽ˳ʱѻ׼
+// δʼͳʱoperator new/deleteֻһԭӶֽʵʸĿС㡣
+// ֽͷֵڿʼͳƵʱ̣֮ǰ䡢֮ͷŵĿҲͷŴмȥټ0
+// ڲпʼʱֵƫСALLOCSTATS=1ʹͳھ̬ʼ֮ǰͿʼǾȷ
+void enableAllocationTracking();
+
+bool allocationTrackingEnabled();
+
+// õǰ֮߳ķĽ׶
+void setAllocationPhase(AllocationPhase phase);
+
+// ȡһ׶εͳ
+AllocationCounters allocationCounters(AllocationPhase phase);
+
+// Ѹ׶εͳ׼󣬲ڴ
+void printAllocationReport();
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef AST_H
+#define AST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "symbol_table.h"
+
+// ڴ򣺷ֻƶָ룬ͷţreleaseʱһȫ黹
+// ֻſƽĶ﷨㡢ָȣǵ
+class Arena
+{
+private:
+    std::vector<std::unique_ptr<char[]>> blocks; // ڴ
+    char* next; // ǰһõλ
+    size_t remaining; // ǰʣֽ
+    size_t blockSize; // ͨĴС
+    size_t used; // ѷȥֽ
+
+    // һsizeֽڵ¿Ϊǰ
+    void grow(size_t size)
+    {
+        size_t bytes = size > blockSize ? size : blockSize;
+        blocks.emplace_back(new char[bytes]);
+        next = blocks.back().get();
+        remaining = bytes;
+    }
+
+    // nextҪҪֽ
+    size_t padding(size_t alignment) const
+    {
+        size_t misalign = reinterpret_cast<uintptr_t>(next) % alignment;
+        return misalign == 0 ? 0 : alignment - misalign;
+    }
+
+public:
+    static const size_t DEFAULT_BLOCK = 64 * 1024;
+
+    // 캯һηʱڴ
+    explicit Arena(size_t blockSize = DEFAULT_BLOCK)
+        :next(nullptr)
+        ,remaining(0)
+        ,blockSize(blockSize)
+        ,used(0)
+    {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // ƶԭΪգѷĽµУַ
+    Arena(Arena&& other) noexcept
+        :blocks(std::move(other.blocks))
+        ,next(other.next)
+        ,remaining(other.remaining)
+        ,blockSize(other.blockSize)
+        ,used(other.used)
+    {
+        other.blocks.clear();
+        other.next = nullptr;
+        other.remaining = 0;
+        other.used = 0;
+    }
+
+    Arena& operator=(Arena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            blocks = std::move(other.blocks);
+            next = other.next;
+            remaining = other.remaining;
+            blockSize = other.blockSize;
+            used = other.used;
+            other.blocks.clear();
+            other.next = nullptr;
+            other.remaining = 0;
+            other.used = 0;
+        }
+        return *this;
+    }
+
+    // sizeֽڣalignment
+    void* allocate(size_t size, size_t alignment)
+    {
+        if (next == nullptr || padding(alignment) + size > remaining)
+        {
+            grow(size + alignment);
+        }
+        size_t skip = padding(alignment);
+        char* result = next + skip;
+        next = result + size;
+        remaining -= skip + size;
+        used += size;
+        return result;
+    }
+
+    // иһ
+    template <typename T>
+    T* create(const T& value)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(value);
+    }
+
+    // иcountĶcountΪ0ʱnullptr
+    template <typename T>
+    T* createArray(const T* values, size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        if (count == 0) return nullptr;
+        T* result = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        for (size_t i = 0; i < count; ++i)
+        {
+            new (result + i) T(values[i]);
+        }
+        return result;
+    }
+
+    // һͷȫڴ棬֮ǰĶȫʧЧ
+    void release()
+    {
+        blocks.clear();
+        next = nullptr;
+        remaining = 0;
+        used = 0;
+    }
+
+    // ѷȥֽ
+    size_t bytesUsed() const
+    {
+        return used;
+    }
+
+    // ϵͳĿ
+    size_t blockCount() const
+    {
+        return blocks.size();
+    }
+};
+
+// ﷨㶼ArenaУͨԪ±Դеĵʣ
+// ڷʱͲ÷ţӽбָ顣
+// ﷨ʱֻʶĲ֣ʹǰӦȼϢ
+
+// ûҵʱŵ±
+const size_t UNRESOLVED = static_cast<size_t>(-1);
+
+// ʽ
+enum class ExpressionKind : unsigned char
+{
+    EMPTY, // ȱʧӣķΪգ0
+    CONSTANT, // 
+    VARIABLE, // ҲǺںбʾֵ
+    CALL, // 
+    MULTIPLY, // ˷
+    SUBTRACT, // 
+};
+
+// ϵ
+enum class RelationKind : unsigned char
+{
+    NONE, // ȱٹϵ
+    LESS,
+    LESS_OR_EQUALS,
+    GREATER,
+    GREATER_OR_EQUALS,
+    EQUALS,
+    NOT_EQUALS,
+};
+
+// ִ
+enum class StatementKind : unsigned char
+{
+    READ, // 
+    WRITE, // д
+    ASSIGN, // ֵ
+    IF, // 
+};
+
+// ʽ
+struct Expression
+{
+    ExpressionKind kind;
+    uint32_t token; // ֻڵԪ±
+    long long value; // ֵ
+    Symbol symbol; // 򱻵õĺҲʱindexΪUNRESOLVED
+    const Expression* left; // Ԫõʵ
+    const Expression* right; // ԪҲ
+};
+
+// ʽ
+struct Condition
+{
+    RelationKind relation; // ϵ
+    uint32_t token; // ϵڵԪ±
+    const Expression* left;
+    const Expression* right; // ȱٹϵʱΪnullptr
+};
+
+// ִ
+struct Statement
+{
+    StatementKind kind;
+    uint32_t token; // һԪ±
+    size_t line; // 
+    Symbol target; // дֵıֵʾ÷ֵҲʱindexΪUNRESOLVED
+    const Expression* value; // ֵұߵıʽ
+    const Condition* condition; // 
+    const Statement* thenBranch; // then䣬ȱʧʱΪnullptr
+    const Statement* elseBranch; // else䣬ûelseʱΪnullptr
+};
+
+struct FunctionDeclaration;
+
+// ֳ˵ִ
+struct Block
+{
+    const size_t* variables; // ˵ıڱеλ
+    size_t variableCount;
+    const FunctionDeclaration* const* functions; // ˵ĺ˳
+    size_t functionCount;
+    const Statement* const* statements; // ִ䣬˳
+    size_t statementCount;
+};
+
+// ˵
+struct FunctionDeclaration
+{
+    uint32_t token; // ڵԪ±
+    size_t procedure; // ڹ̱е±
+    size_t parameter; // βڱеλ
+    const Block* body; // 壬ȱbeginʱΪnullptr
+};
+
+// 
+struct Program
+{
+    const Block* body; // ķֳ
+    bool sharedExpressions; // ͬһͬӱʽͬһ㣨ӱʽ󣩣Ϊfalse
+};
+
+#endif
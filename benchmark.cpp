@@ -0,0 +1,208 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#include "benchmark.h"
+#include "diagnostics.h"
+#include "grammar_analyzer.h"
+#include "lexical_analyzer.h"
+
+// ¿ʼ¼ڴֵLinuxϰ/proc/self/statusеVmHWMΪǰֵƽ̨false
+static bool resetPeakRss()
+{
+#if defined(__linux__)
+    std::ofstream clear("/proc/self/clear_refs");
+    clear << "5";
+    clear.close();
+    return !clear.fail();
+#else
+    return false;
+#endif
+}
+
+// ǰ¼ڴֵKB
+static uint64_t peakRssKb()
+{
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return std::strtoull(line.c_str() + 6, nullptr, 10);
+        }
+    }
+    return 0;
+#elif defined(__APPLE__)
+    rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<uint64_t>(usage.ru_maxrss) / 1024 : 0;
+#elif defined(__unix__)
+    rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<uint64_t>(usage.ru_maxrss) : 0;
+#else
+    return 0;
+#endif
+}
+
+static uint64_t fileSize(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+    return file.is_open() ? static_cast<uint64_t>(file.tellg()) : 0;
+}
+
+// ʱ¼һ׶Σظʱ̵ʱķֵ
+class PhaseTimer
+{
+private:
+    PhaseMeasurement& measurement;
+    bool first;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    PhaseTimer(PhaseMeasurement& measurement, bool first)
+        :measurement(measurement)
+        ,first(first)
+    {
+        resetPeakRss();
+        start = std::chrono::steady_clock::now();
+    }
+
+    ~PhaseTimer()
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        uint64_t peak = peakRssKb();
+        if (first || seconds < measurement.seconds) measurement.seconds = seconds;
+        if (peak > measurement.peakRssKb) measurement.peakRssKb = peak;
+    }
+};
+
+static double perSecond(uint64_t amount, double seconds)
+{
+    return static_cast<double>(amount) / (seconds > 0 ? seconds : 1e-9);
+}
+
+static std::string quote(const std::string& text)
+{
+    std::string out = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+void BenchmarkReport::print(std::ostream& out) const
+{
+    out << "source: " << source << " (" << sourceBytes << " bytes, " << tokens << " tokens, "
+        << lexicalErrors << " lexical errors, " << grammarErrors << " grammar errors"
+        << (stopped ? ", stopped" : "") << ")\n"
+        << "runs: " << runs << (phasePeaks ? "" : ", peak RSS is since process start") << "\n";
+    out << std::left << std::setw(10) << "phase" << std::right
+        << std::setw(12) << "seconds" << std::setw(12) << "MB/s" << std::setw(16) << "tokens/s"
+        << std::setw(16) << "peak RSS KB" << "\n";
+    for (const PhaseMeasurement& phase : phases)
+    {
+        out << std::left << std::setw(10) << phase.phase << std::right << std::fixed
+            << std::setw(12) << std::setprecision(6) << phase.seconds
+            << std::setw(12) << std::setprecision(2) << perSecond(sourceBytes, phase.seconds) / 1e6
+            << std::setw(16) << std::setprecision(0) << perSecond(tokens, phase.seconds)
+            << std::setw(16) << phase.peakRssKb << "\n";
+    }
+    out << std::defaultfloat << std::setprecision(6);
+    out.flush();
+}
+
+bool BenchmarkReport::save(const std::string& fileName) const
+{
+    std::ostringstream out;
+    out << std::fixed;
+    out << "{\n"
+        << "  \"source\": " << quote(source) << ",\n"
+        << "  \"source_bytes\": " << sourceBytes << ",\n"
+        << "  \"dyd_bytes\": " << dydBytes << ",\n"
+        << "  \"table_bytes\": " << tableBytes << ",\n"
+        << "  \"tokens\": " << tokens << ",\n"
+        << "  \"lexical_errors\": " << lexicalErrors << ",\n"
+        << "  \"grammar_errors\": " << grammarErrors << ",\n"
+        << "  \"stopped\": " << (stopped ? "true" : "false") << ",\n"
+        << "  \"runs\": " << runs << ",\n"
+        << "  \"phase_peaks\": " << (phasePeaks ? "true" : "false") << ",\n"
+        << "  \"phases\": [\n";
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        const PhaseMeasurement& phase = phases[i];
+        out << "    {\n"
+            << "      \"phase\": " << quote(phase.phase) << ",\n"
+            << "      \"seconds\": " << std::setprecision(6) << phase.seconds << ",\n"
+            << "      \"mb_per_s\": " << std::setprecision(2) << perSecond(sourceBytes, phase.seconds) / 1e6 << ",\n"
+            << "      \"tokens_per_s\": " << std::setprecision(0) << perSecond(tokens, phase.seconds) << ",\n"
+            << "      \"peak_rss_kb\": " << phase.peakRssKb << "\n"
+            << "    }" << (i + 1 < phases.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n"
+        << "}\n";
+
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "Could not open the file - '" << fileName << "'" << std::endl;
+        return false;
+    }
+    file << out.str();
+    return file.good();
+}
+
+bool runFrontendBenchmark(const std::string& sourceFileName, const std::string& varPath, const std::string& proPath,
+    size_t runs, BenchmarkReport& report)
+{
+    report = BenchmarkReport();
+    report.source = sourceFileName;
+    report.sourceBytes = fileSize(sourceFileName);
+    report.runs = runs > 0 ? runs : 1;
+    report.phasePeaks = resetPeakRss();
+    report.phases = { PhaseMeasurement{ "lex" }, PhaseMeasurement{ "load_dyd" },
+        PhaseMeasurement{ "parse" }, PhaseMeasurement{ "print" } };
+    std::string dydFileName = sourceFileName.substr(0, sourceFileName.find_last_of(".")) + ".dyd";
+
+    for (size_t run = 0; run < report.runs; ++run)
+    {
+        bool first = run == 0;
+        TokenBuffer tokens;
+        Diagnostics lexicalDiagnostics;
+        {
+            PhaseTimer timer(report.phases[0], first);
+            if (!generateDydFile(sourceFileName, tokens, lexicalDiagnostics, dydFileName)) return false;
+        }
+        {
+            // صĶԪʽֻڼʱ漴ͷţ׶εڴ
+            TokenBuffer loaded;
+            PhaseTimer timer(report.phases[1], first);
+            if (!loadDydFile(dydFileName, loaded)) return false;
+        }
+        Diagnostics grammarDiagnostics;
+        GrammarAnalyzer analyzer(tokens.view(), grammarDiagnostics);
+        {
+            PhaseTimer timer(report.phases[2], first);
+            analyzer.parseProgram();
+        }
+        if (!analyzer.isStopped())
+        {
+            PhaseTimer timer(report.phases[3], first);
+            analyzer.printFiles(varPath, proPath);
+        }
+        report.tokens = tokens.view().count;
+        report.lexicalErrors = lexicalDiagnostics.count();
+        report.grammarErrors = grammarDiagnostics.count();
+        report.stopped = analyzer.isStopped();
+    }
+    report.dydBytes = fileSize(dydFileName);
+    report.tableBytes = report.stopped ? 0 : fileSize(varPath) + fileSize(proPath);
+    return true;
+}
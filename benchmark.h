@@ -0,0 +1,45 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// һ׶εĲظʱȡ̵ʱڴֵ
+struct PhaseMeasurement
+{
+    std::string phase;
+    double seconds = 0;
+    uint64_t peakRssKb = 0; // ý׶гפڴķֵKBƽ̨֧ʱΪ0
+};
+
+// ǰ˻׼ԵĽʶԴֽͶԪʽ㣬ڱȽϸ׶
+struct BenchmarkReport
+{
+    std::string source;
+    uint64_t sourceBytes = 0;
+    uint64_t dydBytes = 0; // д.dydļ
+    uint64_t tableBytes = 0; // дı͹̱
+    uint64_t tokens = 0;
+    uint64_t lexicalErrors = 0;
+    uint64_t grammarErrors = 0;
+    bool stopped = false; // ﷨Ƿֹ
+    size_t runs = 0;
+    bool phasePeaks = false; // ڴֵǷÿ׶οʼʱ¼Ϊfalseʱǽ̿ʼķֵ
+    std::vector<PhaseMeasurement> phases;
+
+    // Ϊ
+    void print(std::ostream& out) const;
+
+    // дΪJSONÿֵռһУͬ汾Ľֱdiff
+    bool save(const std::string& fileName) const;
+};
+
+// Դβǰ˸׶Σʷд.dydgenerateDydFile.dydloadDydFile
+// ﷨parseProgram͹̱printFilesظrunsΡ
+// ֻڴռдļԴļ.dydļ򲻿ʱfalse
+bool runFrontendBenchmark(const std::string& sourceFileName, const std::string& varPath, const std::string& proPath,
+    size_t runs, BenchmarkReport& report);
+
+#endif
@@ -0,0 +1,15 @@
+begin
+ integer m;
+ integer f;
+ integer function F(k);
+  begin
+   integer k;
+   integer j;
+   j:=0-1;
+   if k<=1 then F:=k
+   else F:=F(k-1)-j*F(k-2)
+  end;
+ read(m);
+ f:=F(m);
+ write(f)
+end
@@ -0,0 +1,127 @@
+// ʶ΢׼ԱʶΪϱȽlookupKeywordԭunordered_mapֱձ
+// ʼߵĽһ¡ڲֿĿ¼±У
+//     g++ -std=c++17 -O2 -pthread -I. benchmarks/keyword_lookup.cpp $(ls *.cpp | grep -v main.cpp) -o keyword_lookup
+//     ./keyword_lookup [] [ʶռİٷֱ]
+// һʱ1
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../lexical_analyzer.h"
+
+// ԭֱձEOLNEOFidentifierconstantȥЩڰʶ
+static std::unordered_map<std::string, TokenKind> makeTokenTable()
+{
+    std::unordered_map<std::string, TokenKind> table;
+    table["begin"] = TokenKind::BEGIN;
+    table["end"] = TokenKind::END;
+    table["integer"] = TokenKind::INTEGER;
+    table["if"] = TokenKind::IF;
+    table["then"] = TokenKind::THEN;
+    table["else"] = TokenKind::ELSE;
+    table["function"] = TokenKind::FUNCTION;
+    table["read"] = TokenKind::READ;
+    table["write"] = TokenKind::WRITE;
+    table["="] = TokenKind::EQUALS;
+    table["<>"] = TokenKind::NOT_EQUALS;
+    table["<="] = TokenKind::LESS_OR_EQUALS;
+    table["<"] = TokenKind::LESS;
+    table[">="] = TokenKind::GREATER_OR_EQUALS;
+    table[">"] = TokenKind::GREATER;
+    table["-"] = TokenKind::MINUS;
+    table["*"] = TokenKind::MULTIPLY;
+    table[":="] = TokenKind::ASSIGN;
+    table["("] = TokenKind::OPEN_PAREN;
+    table[")"] = TokenKind::CLOSE_PAREN;
+    table[";"] = TokenKind::SEMICOLON;
+    return table;
+}
+
+// ϣidentifierPercent%Ϊʶһ뱣ͬͬĸΪֺ
+static std::vector<std::string> makeCorpus(size_t count, unsigned identifierPercent)
+{
+    static const char* const keywords[] = { "begin", "end", "integer", "if", "then", "else", "function", "read", "write",
+        "=", "<>", "<=", "<", ">=", ">", "-", "*", ":=", "(", ")", ";" };
+    static const char* const nearMisses[] = { "begin1", "en", "endx", "integr", "iff", "than", "els", "functio", "reed", "writes",
+        "EOLN", "EOF", "identifier", "constant", "i", "e" };
+    static const char alnum[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    std::mt19937_64 random(42);
+    std::vector<std::string> corpus;
+    corpus.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (random() % 100 >= identifierPercent)
+        {
+            corpus.push_back(keywords[random() % (sizeof(keywords) / sizeof(keywords[0]))]);
+        }
+        else if (random() % 8 == 0)
+        {
+            corpus.push_back(nearMisses[random() % (sizeof(nearMisses) / sizeof(nearMisses[0]))]);
+        }
+        else
+        {
+            std::string word(1, alnum[random() % 52]);
+            size_t length = 1 + random() % 12;
+            while (word.size() < length) word += alnum[random() % 62];
+            corpus.push_back(word);
+        }
+    }
+    return corpus;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    unsigned identifierPercent = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 75;
+    const int rounds = 10;
+    std::unordered_map<std::string, TokenKind> table = makeTokenTable();
+    std::vector<std::string> corpus = makeCorpus(count, identifierPercent);
+
+    // һǱȽϺʱǰ
+    size_t mismatches = 0;
+    for (const std::string& word : corpus)
+    {
+        TokenKind kind = TokenKind::IDENTIFIER;
+        bool found = lookupKeyword(word.data(), word.size(), kind);
+        auto it = table.find(word);
+        if (found != (it != table.end()) || (found && kind != it->second))
+        {
+            if (mismatches++ < 10) std::fprintf(stderr, "mismatch: '%s'\n", word.c_str());
+        }
+    }
+
+    // ԭÿȹstd::stringٲͬ빹Ŀ
+    unsigned long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round)
+    {
+        for (const std::string& word : corpus)
+        {
+            std::string key(word.data(), word.size());
+            auto it = table.find(key);
+            checksum += it != table.end() ? static_cast<unsigned>(it->second) : 0;
+        }
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round)
+    {
+        for (const std::string& word : corpus)
+        {
+            TokenKind kind;
+            checksum += lookupKeyword(word.data(), word.size(), kind) ? static_cast<unsigned>(kind) : 0;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double words = static_cast<double>(count) * rounds;
+    double mapNs = std::chrono::duration<double, std::nano>(middle - start).count() / words;
+    double switchNs = std::chrono::duration<double, std::nano>(end - middle).count() / words;
+    std::printf("%zu words, %u%% identifiers, %d rounds (checksum %llu)\n", count, identifierPercent, rounds, checksum);
+    std::printf("unordered_map: %.1f ns/word\n", mapNs);
+    std::printf("lookupKeyword: %.1f ns/word (%.1fx)\n", switchNs, switchNs > 0 ? mapNs / switchNs : 0.0);
+    std::printf("mismatches: %zu\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
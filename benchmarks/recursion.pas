@@ -0,0 +1,13 @@
+begin
+ integer m;
+ integer s;
+ integer function N(k);
+  begin
+   integer k;
+   if k<=0 then N:=0
+   else N:=N(k-1)-k
+  end;
+ read(m);
+ s:=0-N(m);
+ write(s)
+end
@@ -0,0 +1,72 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <cstdint>
+#include <vector>
+
+// Ĵʽֽ롣ÿκռһ֡֡еļĴǣ
+// 0 ֵ1 ֱ̬㺯֡㣩2 βΣ֮ǾֲʱĴ
+// ֡0ʼͬǰĴã2ʼͨGET_GLOBAL/SET_GLOBAL
+
+// ֡й̶Ĵλ
+const uint32_t RETURN_SLOT = 0;
+const uint32_t STATIC_LINK_SLOT = 1;
+const uint32_t PARAMETER_SLOT = 2;
+
+// 룬r[x]ʾǰ֡ļĴx
+enum class Opcode : unsigned char
+{
+    MOVE, // r[a] = r[b]
+    CONSTANT, // r[a] = constants[b]
+    GET_GLOBAL, // r[a] = ֡ļĴb
+    SET_GLOBAL, // ֡ļĴb = r[a]
+    GET_OUTER, // r[a] = ؾ̬c֡ļĴb
+    SET_OUTER, // ؾ̬c֡ļĴb = r[a]
+    SUBTRACT, // r[a] = r[b] - r[c]
+    MULTIPLY, // r[a] = r[b] * r[c]
+    JUMP, // c
+    JUMP_IF_LESS, // r[a] < r[b] ʱc
+    JUMP_IF_LESS_OR_EQUALS,
+    JUMP_IF_GREATER,
+    JUMP_IF_GREATER_OR_EQUALS,
+    JUMP_IF_EQUALS,
+    JUMP_IF_NOT_EQUALS,
+    CALL, // r[a] = úbʵΪr[c]̬ɵǰκͺbĲ
+    CALL_MEMO, // кbr[c]ΪʵεĽʱr[a] = ýһָͬCALLһMEMO_STORE
+    MEMO_STORE, // r[a]Ϊbr[c]ΪʵεĽ뻺
+    RETURN, // r[0]
+    READ, // һr[a]
+    WRITE, // r[a]
+    HALT, // 
+};
+
+// һָ16ֽ
+struct Instruction
+{
+    Opcode op;
+    unsigned char reserved[3]; // 0
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+};
+
+// һĴϢ
+struct FunctionCode
+{
+    uint32_t entry; // һָλ
+    uint32_t level; // Ĳ
+    uint32_t variableCount; // ̶Ĵβκ;ֲռõļĴʱ
+    uint32_t frameSize; // ֡ļĴʱĴ
+};
+
+// ֽ룬ӵ0ָʼ
+struct BytecodeProgram
+{
+    std::vector<Instruction> code;
+    std::vector<long long> constants; // 
+    std::vector<FunctionCode> functions; // ̱е±
+    uint32_t mainVariableCount = 0;
+    uint32_t mainFrameSize = 0;
+};
+
+#endif
@@ -0,0 +1,578 @@
+#include <cstdint>
+#include <unordered_map>
+#include "code_generator.h"
+
+// û֡ļĴû㺯
+static const uint32_t NO_SLOT = UINT32_MAX;
+static const size_t NO_PROCEDURE = static_cast<size_t>(-1);
+// ıںаȫֱ
+static const uint32_t GLOBAL = UINT32_MAX;
+
+// ʱתָϵȡ
+static Opcode negatedJump(RelationKind relation)
+{
+    switch (relation)
+    {
+    case RelationKind::LESS:
+        return Opcode::JUMP_IF_GREATER_OR_EQUALS;
+    case RelationKind::LESS_OR_EQUALS:
+        return Opcode::JUMP_IF_GREATER;
+    case RelationKind::GREATER:
+        return Opcode::JUMP_IF_LESS_OR_EQUALS;
+    case RelationKind::GREATER_OR_EQUALS:
+        return Opcode::JUMP_IF_LESS;
+    case RelationKind::EQUALS:
+        return Opcode::JUMP_IF_NOT_EQUALS;
+    default:
+        return Opcode::JUMP_IF_EQUALS;
+    }
+}
+
+// ʽֵʱú
+static bool isLeaf(const Expression* node)
+{
+    return node->kind == ExpressionKind::EMPTY || node->kind == ExpressionKind::CONSTANT ||
+        node->kind == ExpressionKind::VARIABLE;
+}
+
+// дĴaָ
+static bool writesA(Opcode op)
+{
+    switch (op)
+    {
+    case Opcode::MOVE:
+    case Opcode::CONSTANT:
+    case Opcode::GET_GLOBAL:
+    case Opcode::GET_OUTER:
+    case Opcode::SUBTRACT:
+    case Opcode::MULTIPLY:
+    case Opcode::CALL:
+    case Opcode::READ:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// һ򡣺ȵ˳룬㺯ڲ֮ǰ
+// ͱʽʽջǶҲռõջ
+class CodeGenerator
+{
+private:
+    // ȴĺ˵ֱĺ
+    struct PendingFunction
+    {
+        const FunctionDeclaration* declaration;
+        size_t parent;
+    };
+
+    // ʽеһ㣺stateΪѴӽmarkΪʼʱʱĴλ
+    struct ExpressionTask
+    {
+        const Expression* node;
+        int state;
+        uint32_t mark;
+    };
+
+    // еһ㣺stateΪѷķ֧jumpΪתָ
+    struct StatementTask
+    {
+        const Statement* node;
+        int state;
+        size_t jump;
+    };
+
+    // ദõӱʽ̶ֵʱĴԼǷѾֵ
+    struct SharedValue
+    {
+        uint32_t reg;
+        bool computed;
+    };
+
+    const TokenView& tokens;
+    const std::vector<VarUnit>& varList;
+    const std::vector<ProUnit>& proList;
+    Diagnostics& diagnostics;
+    BytecodeProgram& output;
+    std::vector<uint32_t> slots; // ֡еļĴ±
+    std::vector<size_t> parents; // ֱĺʱΪNO_PROCEDURE
+    std::vector<PendingFunction> pending; // ˳еĺ˵
+    std::unordered_map<long long, uint32_t> constantIndex; // ڳеλ
+    std::vector<ExpressionTask> expressionTasks;
+    std::vector<uint32_t> values; // ֵӱʽڵļĴ
+    std::vector<StatementTask> statementTasks;
+    const std::vector<bool>* memoized; // ýʵλḻ́±
+    bool sharedExpressions; // ﷨Ƿбദõӱʽ
+    std::unordered_map<const Expression*, SharedValue> shared; // ǰбദõӱʽ
+    std::vector<const Expression*> sharedScan;
+
+    size_t currentProcedure; // ڷĺΪNO_PROCEDURE
+    uint32_t currentLevel; // ڷĺĲ
+    uint32_t variableCount; // ǰ֡й̶Ĵͱĸ֮ʱĴ
+    uint32_t nextRegister; // һеʱĴ
+    uint32_t frameSize; // ǰ֡õļĴ
+
+    // Ԫб
+    void report(ErrorType type, uint32_t token, const std::string& symbol)
+    {
+        diagnostics.report(type, tokens.tokens[token].line, 0, symbol);
+    }
+
+    // tokenʼĵһʶдԱֿʼʱ
+    std::string nameFrom(uint32_t token) const
+    {
+        for (size_t i = token; i < tokens.count; ++i)
+        {
+            if (tokens.tokens[i].kind == TokenKind::IDENTIFIER) return tokens.lexeme(i);
+        }
+        return std::string();
+    }
+
+    size_t emit(Opcode op, uint32_t a, uint32_t b, uint32_t c)
+    {
+        Instruction instruction = { op, { 0, 0, 0 }, a, b, c };
+        output.code.push_back(instruction);
+        return output.code.size() - 1;
+    }
+
+    // תָһҪɵָ
+    void patch(size_t jump)
+    {
+        output.code[jump].c = static_cast<uint32_t>(output.code.size());
+    }
+
+    uint32_t allocate()
+    {
+        uint32_t reg = nextRegister++;
+        if (nextRegister > frameSize) frameSize = nextRegister;
+        return reg;
+    }
+
+    uint32_t constant(long long value)
+    {
+        auto found = constantIndex.find(value);
+        if (found != constantIndex.end()) return found->second;
+        uint32_t index = static_cast<uint32_t>(output.constants.size());
+        output.constants.push_back(value);
+        constantIndex.emplace(value, index);
+        return index;
+    }
+
+    // ȷһɶдڵ֡ͼĴǰڵģ㣩ķֵ
+    // hopsΪؾ̬ĲзıʱΪGLOBAL
+    bool locate(const Symbol& symbol, const std::string& name, uint32_t token, uint32_t& hops, uint32_t& slot)
+    {
+        if (symbol.index == UNRESOLVED)
+        {
+            report(ErrorType::SYMBOL_NOT_DEFINED, token, "variable " + name);
+            return false;
+        }
+        if (symbol.isProcedure)
+        {
+            // ֻԼĺ壨Ƕ׵ĺбʾֵ
+            uint32_t distance = 0;
+            for (size_t p = currentProcedure; p != NO_PROCEDURE; p = parents[p], ++distance)
+            {
+                if (p == symbol.index)
+                {
+                    hops = distance;
+                    slot = RETURN_SLOT;
+                    return true;
+                }
+            }
+            report(ErrorType::SYMBOL_NOT_MATCH, token, "variable " + name);
+            return false;
+        }
+        const VarUnit& var = varList[symbol.index];
+        slot = slots[symbol.index];
+        if (slot == NO_SLOT || var.vLev > currentLevel)
+        {
+            report(ErrorType::SYMBOL_NOT_MATCH, token, "variable " + name);
+            return false;
+        }
+        hops = var.vLev == 0 && currentLevel > 0 ? GLOBAL : static_cast<uint32_t>(currentLevel - var.vLev);
+        return true;
+    }
+
+    // ȡֵֵǰ֡еıֱӷļĴȶʱĴ
+    uint32_t load(const Symbol& symbol, const std::string& name, uint32_t token)
+    {
+        uint32_t hops = 0;
+        uint32_t slot = 0;
+        if (!locate(symbol, name, token, hops, slot)) return allocate();
+        if (hops == 0) return slot;
+        uint32_t target = allocate();
+        if (hops == GLOBAL)
+        {
+            emit(Opcode::GET_GLOBAL, target, slot, 0);
+        }
+        else
+        {
+            emit(Opcode::GET_OUTER, target, slot, hops);
+        }
+        return target;
+    }
+
+    // ѼĴsourceֵ
+    void store(const Symbol& symbol, const std::string& name, uint32_t token, uint32_t source)
+    {
+        uint32_t hops = 0;
+        uint32_t slot = 0;
+        if (!locate(symbol, name, token, hops, slot)) return;
+        if (hops == GLOBAL)
+        {
+            emit(Opcode::SET_GLOBAL, source, slot, 0);
+        }
+        else if (hops > 0)
+        {
+            emit(Opcode::SET_OUTER, source, slot, hops);
+        }
+        else if (source != slot)
+        {
+            // ֵһָ㵽ʱĴʱΪֱд
+            if (source >= variableCount && !output.code.empty() &&
+                writesA(output.code.back().op) && output.code.back().a == source)
+            {
+                output.code.back().a = slot;
+            }
+            else
+            {
+                emit(Opcode::MOVE, slot, source, 0);
+            }
+        }
+    }
+
+    // ҳleftrightбദõķҶӽ㣬һвֵռõʱĴ
+    void reserveShared(const Expression* left, const Expression* right)
+    {
+        shared.clear();
+        if (!sharedExpressions) return;
+        std::unordered_map<const Expression*, bool> seen; // Ƿѱö
+        sharedScan.clear();
+        if (right != nullptr) sharedScan.push_back(right);
+        if (left != nullptr) sharedScan.push_back(left);
+        while (!sharedScan.empty())
+        {
+            const Expression* node = sharedScan.back();
+            sharedScan.pop_back();
+            if (isLeaf(node)) continue;
+            auto found = seen.find(node);
+            if (found != seen.end())
+            {
+                if (!found->second)
+                {
+                    found->second = true;
+                    shared.emplace(node, SharedValue{ allocate(), false });
+                }
+                continue;
+            }
+            seen.emplace(node, false);
+            if (node->right != nullptr) sharedScan.push_back(node->right);
+            if (node->left != nullptr) sharedScan.push_back(node->left);
+        }
+    }
+
+    // ӱʽֵ󣬱ദõİֵŵĹ̶Ĵ
+    uint32_t keep(const Expression* node, uint32_t target)
+    {
+        if (shared.empty()) return target;
+        auto found = shared.find(node);
+        if (found == shared.end()) return target;
+        found->second.computed = true;
+        uint32_t reg = found->second.reg;
+        if (!output.code.empty() && writesA(output.code.back().op) && output.code.back().a == target)
+        {
+            output.code.back().a = reg;
+        }
+        else
+        {
+            emit(Opcode::MOVE, reg, target, 0);
+        }
+        return reg;
+    }
+
+    // ʽؽڵļĴ
+    uint32_t compileExpression(const Expression* root)
+    {
+        size_t base = expressionTasks.size();
+        expressionTasks.push_back(ExpressionTask{ root, 0, 0 });
+        while (expressionTasks.size() > base)
+        {
+            size_t top = expressionTasks.size() - 1;
+            const Expression* node = expressionTasks[top].node;
+            if (!shared.empty() && expressionTasks[top].state == 0)
+            {
+                auto found = shared.find(node);
+                if (found != shared.end() && found->second.computed)
+                {
+                    values.push_back(found->second.reg);
+                    expressionTasks.pop_back();
+                    continue;
+                }
+            }
+            switch (node->kind)
+            {
+            case ExpressionKind::EMPTY:
+            case ExpressionKind::CONSTANT:
+            {
+                uint32_t target = allocate();
+                emit(Opcode::CONSTANT, target, constant(node->value), 0);
+                values.push_back(target);
+                expressionTasks.pop_back();
+                break;
+            }
+            case ExpressionKind::VARIABLE:
+                values.push_back(load(node->symbol, tokens.lexeme(node->token), node->token));
+                expressionTasks.pop_back();
+                break;
+            case ExpressionKind::CALL:
+                if (expressionTasks[top].state == 0)
+                {
+                    expressionTasks[top].state = 1;
+                    expressionTasks[top].mark = nextRegister;
+                    expressionTasks.push_back(ExpressionTask{ node->left, 0, 0 });
+                }
+                else
+                {
+                    uint32_t argument = values.back();
+                    values.pop_back();
+                    nextRegister = expressionTasks[top].mark;
+                    uint32_t target = allocate();
+                    if (node->symbol.index == UNRESOLVED)
+                    {
+                        report(ErrorType::SYMBOL_NOT_DEFINED, node->token, "function " + tokens.lexeme(node->token));
+                    }
+                    else if (!node->symbol.isProcedure)
+                    {
+                        report(ErrorType::SYMBOL_NOT_MATCH, node->token, "function " + tokens.lexeme(node->token));
+                    }
+                    else if (memoized != nullptr && node->symbol.index < memoized->size() && (*memoized)[node->symbol.index])
+                    {
+                        // MEMO_STOREҪõʵΣܷʵεļĴ
+                        if (target == argument) target = allocate();
+                        uint32_t procedure = static_cast<uint32_t>(node->symbol.index);
+                        emit(Opcode::CALL_MEMO, target, procedure, argument);
+                        emit(Opcode::MEMO_STORE, target, procedure, argument);
+                    }
+                    else
+                    {
+                        emit(Opcode::CALL, target, static_cast<uint32_t>(node->symbol.index), argument);
+                    }
+                    values.push_back(keep(node, target));
+                    expressionTasks.pop_back();
+                }
+                break;
+            case ExpressionKind::MULTIPLY:
+            case ExpressionKind::SUBTRACT:
+                if (expressionTasks[top].state == 0)
+                {
+                    expressionTasks[top].state = 1;
+                    expressionTasks[top].mark = nextRegister;
+                    expressionTasks.push_back(ExpressionTask{ node->left, 0, 0 });
+                }
+                else if (expressionTasks[top].state == 1)
+                {
+                    // ұ߿ܵú޸ֱõıȰߵֵƳ
+                    if (values.back() < variableCount && !isLeaf(node->right))
+                    {
+                        uint32_t copy = allocate();
+                        emit(Opcode::MOVE, copy, values.back(), 0);
+                        values.back() = copy;
+                    }
+                    expressionTasks[top].state = 2;
+                    expressionTasks.push_back(ExpressionTask{ node->right, 0, 0 });
+                }
+                else
+                {
+                    uint32_t right = values.back();
+                    values.pop_back();
+                    uint32_t left = values.back();
+                    values.pop_back();
+                    nextRegister = expressionTasks[top].mark;
+                    uint32_t target = allocate();
+                    Opcode op = node->kind == ExpressionKind::MULTIPLY ? Opcode::MULTIPLY : Opcode::SUBTRACT;
+                    emit(op, target, left, right);
+                    values.push_back(keep(node, target));
+                    expressionTasks.pop_back();
+                }
+                break;
+            }
+        }
+        uint32_t result = values.back();
+        values.pop_back();
+        return result;
+    }
+
+    // ʽʱתָɵ߻
+    size_t compileCondition(const Condition* condition)
+    {
+        uint32_t left = compileExpression(condition->left);
+        if (left < variableCount && !isLeaf(condition->right))
+        {
+            uint32_t copy = allocate();
+            emit(Opcode::MOVE, copy, left, 0);
+            left = copy;
+        }
+        uint32_t right = compileExpression(condition->right);
+        return emit(negatedJump(condition->relation), left, right, 0);
+    }
+
+    // һִ䣬Ƕ׵ѹstatementTasks
+    void compileStatement(const Statement* root)
+    {
+        size_t base = statementTasks.size();
+        statementTasks.push_back(StatementTask{ root, 0, 0 });
+        while (statementTasks.size() > base)
+        {
+            size_t top = statementTasks.size() - 1;
+            const Statement* node = statementTasks[top].node;
+            nextRegister = variableCount; // ʱĴֻһڲʹ
+            if (node == nullptr)
+            {
+                statementTasks.pop_back();
+                continue;
+            }
+            switch (node->kind)
+            {
+            case StatementKind::READ:
+            {
+                std::string name = nameFrom(node->token);
+                uint32_t hops = 0;
+                uint32_t slot = 0;
+                if (locate(node->target, name, node->token, hops, slot))
+                {
+                    uint32_t target = hops == 0 ? slot : allocate();
+                    emit(Opcode::READ, target, 0, 0);
+                    store(node->target, name, node->token, target);
+                }
+                statementTasks.pop_back();
+                break;
+            }
+            case StatementKind::WRITE:
+                emit(Opcode::WRITE, load(node->target, nameFrom(node->token), node->token), 0, 0);
+                statementTasks.pop_back();
+                break;
+            case StatementKind::ASSIGN:
+                reserveShared(node->value, nullptr);
+                store(node->target, tokens.lexeme(node->token), node->token, compileExpression(node->value));
+                statementTasks.pop_back();
+                break;
+            case StatementKind::IF:
+                if (statementTasks[top].state == 0)
+                {
+                    reserveShared(node->condition->left, node->condition->right);
+                    statementTasks[top].jump = compileCondition(node->condition);
+                    statementTasks[top].state = 1;
+                    statementTasks.push_back(StatementTask{ node->thenBranch, 0, 0 });
+                }
+                else if (statementTasks[top].state == 1 && node->elseBranch != nullptr)
+                {
+                    // then֧else֧
+                    size_t skip = emit(Opcode::JUMP, 0, 0, 0);
+                    patch(statementTasks[top].jump);
+                    statementTasks[top].jump = skip;
+                    statementTasks[top].state = 2;
+                    statementTasks.push_back(StatementTask{ node->elseBranch, 0, 0 });
+                }
+                else
+                {
+                    patch(statementTasks[top].jump);
+                    statementTasks.pop_back();
+                }
+                break;
+            }
+        }
+    }
+
+    // һֳ򣺸Ĵеĺ˵Ŷӣٷִ
+    void compileBlock(const Block& block, uint32_t firstSlot)
+    {
+        for (size_t i = 0; i < block.variableCount; ++i)
+        {
+            slots[block.variables[i]] = firstSlot + static_cast<uint32_t>(i);
+        }
+        variableCount = firstSlot + static_cast<uint32_t>(block.variableCount);
+        nextRegister = variableCount;
+        frameSize = variableCount;
+        for (size_t i = 0; i < block.functionCount; ++i)
+        {
+            pending.push_back(PendingFunction{ block.functions[i], currentProcedure });
+        }
+        for (size_t i = 0; i < block.statementCount; ++i)
+        {
+            compileStatement(block.statements[i]);
+        }
+    }
+
+public:
+    CodeGenerator(const TokenView& tokens, const std::vector<VarUnit>& varList,
+        const std::vector<ProUnit>& proList, Diagnostics& diagnostics, BytecodeProgram& output,
+        const std::vector<bool>* memoized)
+        :tokens(tokens)
+        ,varList(varList)
+        ,proList(proList)
+        ,diagnostics(diagnostics)
+        ,output(output)
+        ,slots(varList.size(), NO_SLOT)
+        ,parents(proList.size(), NO_PROCEDURE)
+        ,memoized(memoized)
+        ,sharedExpressions(false)
+        ,currentProcedure(NO_PROCEDURE)
+        ,currentLevel(0)
+        ,variableCount(0)
+        ,nextRegister(0)
+        ,frameSize(0)
+    {}
+
+    void generate(const Program& program)
+    {
+        output = BytecodeProgram();
+        output.functions.resize(proList.size(), FunctionCode{ 0, 0, 0, 0 });
+        sharedExpressions = program.sharedExpressions;
+
+        // 
+        if (program.body != nullptr)
+        {
+            compileBlock(*program.body, PARAMETER_SLOT);
+        }
+        emit(Opcode::HALT, 0, 0, 0);
+        output.mainVariableCount = variableCount;
+        output.mainFrameSize = frameSize;
+
+        // л׷ڲĺ
+        for (size_t i = 0; i < pending.size(); ++i)
+        {
+            PendingFunction item = pending[i];
+            const FunctionDeclaration& declaration = *item.declaration;
+            size_t procedure = declaration.procedure;
+            parents[procedure] = item.parent;
+            currentProcedure = procedure;
+            currentLevel = static_cast<uint32_t>(proList[procedure].pLev);
+            slots[declaration.parameter] = PARAMETER_SLOT;
+            FunctionCode& function = output.functions[procedure];
+            function.entry = static_cast<uint32_t>(output.code.size());
+            function.level = currentLevel;
+            if (declaration.body != nullptr)
+            {
+                compileBlock(*declaration.body, PARAMETER_SLOT + 1);
+            }
+            else
+            {
+                variableCount = nextRegister = frameSize = PARAMETER_SLOT + 1;
+            }
+            emit(Opcode::RETURN, 0, 0, 0);
+            function.variableCount = variableCount;
+            function.frameSize = frameSize;
+        }
+    }
+};
+
+bool generateBytecode(const Program& program, const TokenView& tokens,
+    const std::vector<VarUnit>& varList, const std::vector<ProUnit>& proList,
+    Diagnostics& diagnostics, BytecodeProgram& output, const std::vector<bool>* memoized)
+{
+    size_t errors = diagnostics.count();
+    CodeGenerator generator(tokens, varList, proList, diagnostics, output, memoized);
+    generator.generate(program);
+    return diagnostics.count() == errors;
+}
@@ -0,0 +1,20 @@
+#ifndef CODE_GENERATOR_H
+#define CODE_GENERATOR_H
+
+#include <vector>
+#include "ast.h"
+#include "bytecode.h"
+#include "diagnostics.h"
+#include "grammar_analyzer.h"
+#include "lexical_analyzer.h"
+
+// ﷨ΪĴʽֽ롣еvAdr䵽֡ļĴ
+// vLev뵱ǰεĲȷؾ̬Ĳ
+// ﷨÷δıѱáںʹúﱨ棬
+// дʱfalsetokensȡóʵƴдкţ﷨Ӧ﷨
+// memoizeḏ±ǵýʵλĺӦΪǵĵCALL_MEMOMEMO_STORE
+bool generateBytecode(const Program& program, const TokenView& tokens,
+    const std::vector<VarUnit>& varList, const std::vector<ProUnit>& proList,
+    Diagnostics& diagnostics, BytecodeProgram& output, const std::vector<bool>* memoized = nullptr);
+
+#endif
@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#include "compile_cache.h"
+
+namespace fs = std::filesystem;
+
+// ĿļļͷǱıԪʽӳ˴ӵ32ֽڿʼӳ4ֽڶ
+struct CacheEntryHeader
+{
+    char magic[4]; // ̶Ϊ"DYDC"
+    uint32_t version; // Ŀʽİ汾
+    uint64_t sourceSize; // Դֽ
+    uint64_t check; // ԴĵڶɢУļеɢӲͬ
+};
+
+// 汾2ļͷдԴĳȺУɢ
+static const uint32_t CACHE_ENTRY_VERSION = 2;
+static const char* const ENTRY_EXTENSION = ".cache";
+static const char* const STATISTICS_FILE = "statistics";
+
+// xxHash64ĳ
+static const uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+static const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+static const uint64_t PRIME3 = 0x165667B19E3779F9ull;
+static const uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+static const uint64_t PRIME5 = 0x27D4EB2F165667C5ull;
+
+static uint64_t rotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static uint64_t load64(const char* data)
+{
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t load32(const char* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint64_t hashRound(uint64_t accumulator, uint64_t input)
+{
+    accumulator += input * PRIME2;
+    return rotateLeft(accumulator, 31) * PRIME1;
+}
+
+static uint64_t mergeRound(uint64_t hash, uint64_t accumulator)
+{
+    hash ^= hashRound(0, accumulator);
+    return hash * PRIME1 + PRIME4;
+}
+
+// xxHash64ÿδ32ֽڣֽڵɢпһɢԴĿԶСڴʷ
+static uint64_t hashBytes(const char* data, size_t size, uint64_t seed)
+{
+    const char* end = data + size;
+    uint64_t hash;
+    if (size >= 32)
+    {
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        const char* limit = end - 32;
+        do
+        {
+            v1 = hashRound(v1, load64(data));
+            v2 = hashRound(v2, load64(data + 8));
+            v3 = hashRound(v3, load64(data + 16));
+            v4 = hashRound(v4, load64(data + 24));
+            data += 32;
+        } while (data <= limit);
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + PRIME5;
+    }
+    hash += static_cast<uint64_t>(size);
+    while (end - data >= 8)
+    {
+        hash ^= hashRound(0, load64(data));
+        hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+        data += 8;
+    }
+    if (end - data >= 4)
+    {
+        hash ^= static_cast<uint64_t>(load32(data)) * PRIME1;
+        hash = rotateLeft(hash, 23) * PRIME2 + PRIME3;
+        data += 4;
+    }
+    while (data < end)
+    {
+        hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*data)) * PRIME5;
+        hash = rotateLeft(hash, 11) * PRIME1;
+        ++data;
+    }
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// дͬһĿ¼еʱļٸҪôļҪôļ
+static bool writeAtomically(const fs::path& target, const char* data, size_t size)
+{
+    std::random_device random;
+    fs::path temporary = target;
+    temporary += ".tmp" + std::to_string(random()) + std::to_string(random());
+    {
+        std::ofstream output(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!output.is_open()) return false;
+        output.write(data, static_cast<std::streamsize>(size));
+        if (!output.good())
+        {
+            output.close();
+            std::remove(temporary.string().c_str());
+            return false;
+        }
+    }
+    std::error_code error;
+    fs::rename(temporary, target, error);
+    if (error)
+    {
+        fs::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+// Ŀ¼еһĿ
+struct CacheEntry
+{
+    fs::path path;
+    uint64_t size;
+    fs::file_time_type used;
+};
+
+// гĿ¼еĿֽ
+static uint64_t listEntries(const std::string& directory, std::vector<CacheEntry>& entries)
+{
+    uint64_t bytes = 0;
+    std::error_code error;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+    {
+        if (it->path().extension() != ENTRY_EXTENSION) continue; // ͳļдʱļ
+        std::error_code entryError;
+        uint64_t size = it->file_size(entryError);
+        fs::file_time_type used = it->last_write_time(entryError);
+        if (entryError) continue; // ѱɾ
+        entries.push_back(CacheEntry{ it->path(), size, used });
+        bytes += size;
+    }
+    return bytes;
+}
+
+void CacheStatistics::print(std::ostream& out, bool hit, uint64_t maxBytes) const
+{
+    uint64_t lookups = hits + misses;
+    char line[256];
+    std::snprintf(line, sizeof(line), "cache %s: %llu hits, %llu misses, hit rate %.1f%%, %llu entries, %.1f of %.1f MB",
+        hit ? "hit" : "miss", static_cast<unsigned long long>(hits), static_cast<unsigned long long>(misses),
+        lookups > 0 ? 100.0 * static_cast<double>(hits) / static_cast<double>(lookups) : 0.0,
+        static_cast<unsigned long long>(entries), static_cast<double>(bytes) / (1024.0 * 1024.0),
+        static_cast<double>(maxBytes) / (1024.0 * 1024.0));
+    out << line << std::endl;
+}
+
+CompileCache::CompileCache(const std::string& directory, uint64_t maxBytes)
+    :directory(directory)
+    ,maxBytes(maxBytes)
+{
+}
+
+std::string CompileCache::entryPath(const CacheKey& key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key.hash));
+    return (fs::path(directory) / (std::string(name) + ENTRY_EXTENSION)).string();
+}
+
+CacheKey CompileCache::key(const char* source, size_t size, size_t maxErrors, bool columns)
+{
+    // 汾޺кŶıһΪɢеӣУɢлһһ
+    std::string salt = std::string(COMPILER_VERSION) + '/' + std::to_string(maxErrors) + (columns ? "/columns" : "");
+    uint64_t seed = hashBytes(salt.data(), salt.size(), 0);
+    CacheKey key;
+    key.hash = hashBytes(source, size, seed);
+    key.check = hashBytes(source, size, ~seed * PRIME3);
+    key.size = size;
+    return key;
+}
+
+bool CompileCache::lookup(const CacheKey& key, SourceBuffer& entry, DecodedOutputs& outputs) const
+{
+    std::string path = entryPath(key);
+    if (!openSourceBuffer(path, entry)) return false;
+    CacheEntryHeader header;
+    if (entry.size < sizeof(header))
+    {
+        closeSourceBuffer(entry);
+        return false;
+    }
+    std::memcpy(&header, entry.data, sizeof(header));
+    if (std::memcmp(header.magic, "DYDC", 4) != 0 || header.version != CACHE_ENTRY_VERSION
+        || header.sourceSize != key.size || header.check != key.check
+        || !decodeCompileOutputs(entry.data + sizeof(header), entry.size - sizeof(header), outputs))
+    {
+        closeSourceBuffer(entry);
+        return false;
+    }
+    // ޸ʱ伴һʹõʱ䣬̭ʱݴ
+    std::error_code error;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    return true;
+}
+
+bool CompileCache::store(const CacheKey& key, const std::string& encoded) const
+{
+    CacheEntryHeader header;
+    std::memcpy(header.magic, "DYDC", 4);
+    header.version = CACHE_ENTRY_VERSION;
+    header.sourceSize = key.size;
+    header.check = key.check;
+    std::string image(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (image.size() + encoded.size() > maxBytes) return false; // ĿͳޣҲɾ
+    image += encoded;
+
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (!writeAtomically(entryPath(key), image.data(), image.size()))
+    {
+        std::cerr << "Could not write the cache entry in '" << directory << "'" << std::endl;
+        return false;
+    }
+    evict();
+    return true;
+}
+
+void CompileCache::evict() const
+{
+    std::vector<CacheEntry> entries;
+    uint64_t bytes = listEntries(directory, entries);
+    if (bytes <= maxBytes) return;
+    std::sort(entries.begin(), entries.end(), [](const CacheEntry& a, const CacheEntry& b) { return a.used < b.used; });
+    std::error_code error;
+    for (size_t i = 0; bytes > maxBytes && i < entries.size(); ++i)
+    {
+        fs::remove(entries[i].path, error);
+        bytes -= entries[i].size;
+    }
+}
+
+void CompileCache::countEntries(CacheStatistics& statistics) const
+{
+    std::vector<CacheEntry> entries;
+    statistics.bytes = listEntries(directory, entries);
+    statistics.entries = entries.size();
+}
+
+// ͳļԭдһдڼļͬʱʱν
+CacheStatistics CompileCache::record(bool hit) const
+{
+    CacheStatistics statistics;
+    std::error_code error;
+    fs::create_directories(directory, error);
+    std::string path = (fs::path(directory) / STATISTICS_FILE).string();
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return statistics;
+    while (::flock(fd, LOCK_EX) != 0)
+    {
+        if (errno != EINTR)
+        {
+            ::close(fd);
+            return statistics;
+        }
+    }
+    std::string text;
+    char buffer[256];
+    ssize_t count;
+    while ((count = ::pread(fd, buffer, sizeof(buffer), static_cast<off_t>(text.size()))) > 0)
+    {
+        text.append(buffer, static_cast<size_t>(count));
+    }
+    std::istringstream input(text);
+    std::string name;
+    uint64_t value;
+    while (input >> name >> value)
+    {
+        if (name == "hits") statistics.hits = value;
+        else if (name == "misses") statistics.misses = value;
+    }
+    if (hit) ++statistics.hits;
+    else ++statistics.misses;
+    text = "hits " + std::to_string(statistics.hits) + "\nmisses " + std::to_string(statistics.misses) + "\n";
+    if (::ftruncate(fd, 0) != 0 || ::pwrite(fd, text.data(), text.size(), 0) != static_cast<ssize_t>(text.size()))
+    {
+        std::cerr << "Could not update the cache statistics in '" << directory << "'" << std::endl;
+    }
+    ::close(fd); // رʱͷļ
+    return statistics;
+}
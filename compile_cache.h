@@ -0,0 +1,73 @@
+#ifndef COMPILE_CACHE_H
+#define COMPILE_CACHE_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "compile_outputs.h"
+
+// 뻺棺ԴݵɢΪѴʷ﷨ĽԪʽ̱Ϣ
+// encodeCompileOutputsĸʽһĿ¼УÿĿһļԴûиıʱֱȡд
+// ʷ﷨Ŀдʱļٸ̹ͬһĿ¼ʱĿģ
+// ʱĿļ޸ʱ䣬ܴСʱ޸ʱӾɵɾƵLRU
+
+// ĿļhashĿļĿлԴĳȺһӵɢУ
+// ȡʱ߶ͬУļɢײʱһĽ
+struct CacheKey
+{
+    uint64_t hash = 0;
+    uint64_t check = 0;
+    uint64_t size = 0; // Դֽ
+};
+
+// ĬϵĻܴС
+const uint64_t DEFAULT_CACHE_BYTES = 256ull << 20;
+
+// ͳƣкδдڻĿ¼УۼƣʱļʱҲᶪʧ
+struct CacheStatistics
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t entries = 0; // Ŀ
+    uint64_t bytes = 0; // Ŀֽ
+
+    // һͳƣhitΪǷ
+    void print(std::ostream& out, bool hit, uint64_t maxBytes) const;
+};
+
+class CompileCache
+{
+private:
+    std::string directory;
+    uint64_t maxBytes;
+
+    std::string entryPath(const CacheKey& key) const;
+    // ɾδõĿֱܴС
+    void evict() const;
+
+public:
+    CompileCache(const std::string& directory, uint64_t maxBytes = DEFAULT_CACHE_BYTES);
+
+    uint64_t capacity() const
+    {
+        return maxBytes;
+    }
+
+    // ĿļԴݡ汾޺ʹϢǷкŵ64λɢУԼԴĳ
+    static CacheKey key(const char* source, size_t size, size_t maxErrors, bool columns);
+
+    // Ŀʱӳentry뵽outputsʹʱ䣻entryɵ߹رա
+    // ûĿĿ𻵻ĿеĳȺУɢkeyʱfalse
+    bool lookup(const CacheKey& key, SourceBuffer& entry, DecodedOutputs& outputs) const;
+
+    // ĿencodedΪencodeCompileOutputsḼ֮̌ĿĿ¼ʱȽ
+    bool store(const CacheKey& key, const std::string& encoded) const;
+
+    // ǷмĿ¼еͳƣۼƺкδдֻдͳļɨĿ¼
+    CacheStatistics record(bool hit) const;
+
+    // ɨĿ¼ĿĸֽstatisticsֻҪͳʱ
+    void countEntries(CacheStatistics& statistics) const;
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "compile_outputs.h"
+#include "table_writer.h"
+
+static void appendUint32(std::string& out, uint32_t value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void patchUint32(std::string& out, size_t position, uint32_t value)
+{
+    std::memcpy(&out[position], &value, sizeof(value));
+}
+
+static uint32_t loadUint32(const char* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static bool appendSection(std::string& out, const std::string& section)
+{
+    if (section.size() > UINT32_MAX) return false;
+    appendUint32(out, static_cast<uint32_t>(section.size()));
+    out.append(section);
+    return true;
+}
+
+static bool writeFile(const std::string& fileName, const char* data, size_t size, bool binary)
+{
+    std::ofstream output(fileName, binary ? std::ios::out | std::ios::binary | std::ios::trunc : std::ios::out | std::ios::trunc);
+    if (!output.is_open())
+    {
+        std::cerr << "Could not open the file - '" << fileName << "'" << std::endl;
+        return false;
+    }
+    output.write(data, static_cast<std::streamsize>(size));
+    return output.good();
+}
+
+CompileStatus compileStatus(const CompileResult& result)
+{
+    return result.stopped ? CompileStatus::STOPPED
+        : result.succeeded() ? CompileStatus::SUCCEEDED : CompileStatus::FAILED;
+}
+
+bool encodeCompileOutputs(CompileStatus status, const TokenView& tokens, const std::vector<VarUnit>& varList,
+    const std::vector<ProUnit>& proList, const std::string& lexicalErrors, const std::string& grammarErrors,
+    std::string& out, std::string& scratch)
+{
+    out.push_back(static_cast<char>(status));
+    out.append(3, '\0');
+
+    size_t tokensAt = out.size();
+    appendUint32(out, 0);
+    if (!encodeBinaryTokens(tokens, out) || out.size() - tokensAt - sizeof(uint32_t) > UINT32_MAX) return false;
+    patchUint32(out, tokensAt, static_cast<uint32_t>(out.size() - tokensAt - sizeof(uint32_t)));
+
+    scratch.clear();
+    if (status != CompileStatus::STOPPED)
+    {
+        TableWriter writer(scratch);
+        for (const auto& var : varList)
+        {
+            var.printer(writer);
+        }
+    }
+    if (!appendSection(out, scratch)) return false;
+    scratch.clear();
+    if (status != CompileStatus::STOPPED)
+    {
+        TableWriter writer(scratch);
+        for (const auto& proc : proList)
+        {
+            proc.printer(writer);
+        }
+    }
+    return appendSection(out, scratch) && appendSection(out, lexicalErrors) && appendSection(out, grammarErrors);
+}
+
+bool encodeCompileOutputs(const CompileResult& result, std::string& out, std::string& scratch)
+{
+    return encodeCompileOutputs(compileStatus(result), result.tokens.view(), result.varList, result.proList,
+        result.lexicalDiagnostics.text(), result.grammarDiagnostics.text(), out, scratch);
+}
+
+bool decodeCompileOutputs(const char* data, size_t size, DecodedOutputs& outputs)
+{
+    // ȡΣ鶼ڱ֮
+    size_t position = sizeof(uint32_t);
+    if (size < position || static_cast<uint8_t>(data[0]) > static_cast<uint8_t>(CompileStatus::STOPPED)) return false;
+    outputs.status = static_cast<CompileStatus>(data[0]);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        if (size - position < sizeof(uint32_t)) return false;
+        outputs.sizes[i] = loadUint32(data + position);
+        position += sizeof(uint32_t);
+        if (size - position < outputs.sizes[i]) return false;
+        outputs.sections[i] = data + position;
+        position += outputs.sizes[i];
+    }
+    return viewBinaryTokens(outputs.sections[0], outputs.sizes[0], outputs.tokens);
+}
+
+int writeCompileOutputs(const DecodedOutputs& outputs, const std::string& baseName, const std::string& varPath,
+    const std::string& proPath, const std::string& lexicalErrorPath, const std::string& grammarErrorPath,
+    bool writeDyd, bool writeDydb)
+{
+    if (writeDyd) saveDydFile(outputs.tokens, baseName + ".dyd");
+    if (writeDydb) writeFile(baseName + ".dydb", outputs.sections[0], outputs.sizes[0], true);
+    writeFile(lexicalErrorPath, outputs.sections[3], outputs.sizes[3], false);
+    writeFile(grammarErrorPath, outputs.sections[4], outputs.sizes[4], false);
+    if (outputs.status == CompileStatus::STOPPED)
+    {
+        return -1;
+    }
+    writeFile(varPath, outputs.sections[1], outputs.sizes[1], false);
+    writeFile(proPath, outputs.sections[2], outputs.sizes[2], false);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#ifndef COMPILE_OUTPUTS_H
+#define COMPILE_OUTPUTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "compiler.h"
+#include "token_file.h"
+
+// ıӦͱ뻺Ŀʹָʽֽuint32ţ
+// ״̬1ֽڣCompileStatus3ֽڱȻΣÿΪȼݣ
+// Ԫʽ.dydbļͬӳ񣩡̱.var.proļͬıʷ﷨.errļͬı
+// Ԫʽӳӱĵ8ֽڿʼڰ4ֽڶĵַʱֱеļ¼
+
+// ״̬
+enum class CompileStatus : uint8_t
+{
+    SUCCEEDED, // ûд
+    FAILED, // дʷ﷨
+    STOPPED, // ﷨ֹ͹̱Ϊ
+};
+
+// ıζָڵڴ
+struct DecodedOutputs
+{
+    CompileStatus status = CompileStatus::SUCCEEDED;
+    TokenView tokens;
+    const char* sections[5] = {}; // Ԫʽӳ񡢱̱ʷ﷨
+    uint32_t sizes[5] = {};
+};
+
+CompileStatus compileStatus(const CompileResult& result);
+
+// һαĽ׷ӵoutĩβstatusΪSTOPPEDʱ͹̱ΪաscratchǸʽõĻ
+// ĳһεĳȳ32λķΧʱfalseʱoutеݲʹ
+bool encodeCompileOutputs(CompileStatus status, const TokenView& tokens, const std::vector<VarUnit>& varList,
+    const std::vector<ProUnit>& proList, const std::string& lexicalErrors, const std::string& grammarErrors,
+    std::string& out, std::string& scratch);
+
+// ͬϣȡCompileResult
+bool encodeCompileOutputs(const CompileResult& result, std::string& out, std::string& scratch);
+
+// dataʼsizeֽڣʽԻԪʽӳЧʱfalse
+bool decodeCompileOutputs(const char* data, size_t size, DecodedOutputs& outputs);
+
+// رķʽдļļδֹʱд̱
+// writeDydwriteDydbΪtrueʱдbaseNameӦ.dyd.dydbֵ뱾رͬ
+int writeCompileOutputs(const DecodedOutputs& outputs, const std::string& baseName, const std::string& varPath,
+    const std::string& proPath, const std::string& lexicalErrorPath, const std::string& grammarErrorPath,
+    bool writeDyd, bool writeDydb);
+
+#endif
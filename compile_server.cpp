@@ -0,0 +1,344 @@
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define SERVER_USE_UNIX_SOCKETS 1
+#endif
+#include "compile_outputs.h"
+#include "compile_server.h"
+
+#ifdef SERVER_USE_UNIX_SOCKETS
+
+// ȴʱÿôһǷյֹͣź
+static const int POLL_INTERVAL_MS = 200;
+
+// յSIGINTSIGTERM1
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void requestStop(int)
+{
+    stopRequested = 1;
+}
+
+// sizeֽڣԷرӻʱfalse
+static bool readFully(int fd, char* data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t count = read(fd, data, size);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;
+        data += count;
+        size -= static_cast<size_t>(count);
+    }
+    return true;
+}
+
+// ܵöдʱʱreadwrite-1readFullywriteFully֮ʧܣӱر
+static bool setTimeouts(int fd)
+{
+    timeval timeout;
+    timeout.tv_sec = CONNECTION_TIMEOUT_SECONDS;
+    timeout.tv_usec = 0;
+    return setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0
+        && setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == 0;
+}
+
+static bool writeFully(int fd, const char* data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t count = write(fd, data, size);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;
+        data += count;
+        size -= static_cast<size_t>(count);
+    }
+    return true;
+}
+
+static void appendUint32(std::string& out, uint32_t value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static uint32_t loadUint32(const char* data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// ЭһαĽresponseԭеݣscratchǸʽõĻ
+// Э32λȵķΧʱfalse
+static bool encodeResponse(const CompileResult& result, std::string& response, std::string& scratch)
+{
+    response.clear();
+    appendUint32(response, 0); // ֽд
+    if (!encodeCompileOutputs(result, response, scratch) || response.size() - sizeof(uint32_t) > UINT32_MAX) return false;
+    uint32_t size = static_cast<uint32_t>(response.size() - sizeof(uint32_t));
+    std::memcpy(&response[0], &size, sizeof(size));
+    return true;
+}
+
+// Ӷк͹̡߳ӵ̰߳ӷУеĹ߳ȡϵȫ
+class CompileServer
+{
+private:
+    CompileOptions options;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<int> pending; // ȴ
+    std::unordered_set<int> active; // ڴӣֹͣʱǹرգڶϵĹ̷߳
+    bool stopping;
+
+    // ȡһӣΪʱȴֹͣ󷵻-1
+    int take()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this]() { return stopping || !pending.empty(); });
+        if (stopping) return -1;
+        int connection = pending.front();
+        pending.pop_front();
+        active.insert(connection);
+        return connection;
+    }
+
+    void finish(int connection)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        active.erase(connection);
+        close(connection);
+    }
+
+    // δһϵֱԷرӡʱ
+    void serve(int connection, CompileResult& result, std::string& source, std::string& response, std::string& scratch)
+    {
+        char prefix[sizeof(uint32_t)];
+        while (readFully(connection, prefix, sizeof(prefix)))
+        {
+            uint32_t size = loadUint32(prefix);
+            if (size > MAX_REQUEST_BYTES) return;
+            source.resize(size);
+            if (!readFully(connection, &source[0], size)) return;
+            compileSource(source.data(), source.size(), options, result);
+            if (!encodeResponse(result, response, scratch)) return;
+            if (!writeFully(connection, response.data(), response.size())) return;
+        }
+    }
+
+public:
+    explicit CompileServer(const CompileOptions& options)
+        :options(options)
+        ,stopping(false)
+    {}
+
+    // ̵߳壬ͱڸظʹ
+    void work()
+    {
+        CompileResult result;
+        std::string source;
+        std::string response;
+        std::string scratch;
+        int connection;
+        while ((connection = take()) >= 0)
+        {
+            serve(connection, result, source, response, scratch);
+            finish(connection);
+        }
+    }
+
+    void submit(int connection)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(connection);
+        }
+        ready.notify_one();
+    }
+
+    // رŶӺڴӣȫ߳
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            for (int connection : pending)
+            {
+                close(connection);
+            }
+            pending.clear();
+            for (int connection : active)
+            {
+                shutdown(connection, SHUT_RDWR);
+            }
+        }
+        ready.notify_all();
+    }
+};
+
+// д׽ֵַ·ʱfalse
+static bool makeAddress(const std::string& socketPath, sockaddr_un& address)
+{
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path is too long - '" << socketPath << "'" << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+    return true;
+}
+
+int runCompileServer(const std::string& socketPath, size_t workers, const CompileOptions& options)
+{
+    sockaddr_un address;
+    if (!makeAddress(socketPath, address)) return EXIT_FAILURE;
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+    {
+        std::cerr << "Could not create the socket: " << std::strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+    unlink(socketPath.c_str()); // ϴ쳣˳µ׽ļ
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || listen(listener, SOMAXCONN) != 0)
+    {
+        std::cerr << "Could not listen on '" << socketPath << "': " << std::strerror(errno) << std::endl;
+        close(listener);
+        return EXIT_FAILURE;
+    }
+
+    // ͻǰϿʱдʧܼɣSIGPIPE˳
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    if (workers == 0) workers = 1;
+    CompileServer server(options);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < workers; ++i)
+    {
+        threads.emplace_back([&server]() { server.work(); });
+    }
+    std::cerr << "Listening on '" << socketPath << "' with " << workers << " workers." << std::endl;
+
+    while (!stopRequested)
+    {
+        pollfd waiting;
+        waiting.fd = listener;
+        waiting.events = POLLIN;
+        waiting.revents = 0;
+        if (poll(&waiting, 1, POLL_INTERVAL_MS) <= 0) continue;
+        int connection = accept(listener, nullptr, nullptr);
+        if (connection < 0) continue;
+        if (!setTimeouts(connection))
+        {
+            close(connection);
+            continue;
+        }
+        server.submit(connection);
+    }
+
+    server.stop();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    close(listener);
+    unlink(socketPath.c_str());
+    return 0;
+}
+
+int runCompileClient(const std::string& socketPath, const std::string& sourceFileName,
+    const std::string& varPath, const std::string& proPath, const std::string& lexicalErrorPath,
+    const std::string& grammarErrorPath, bool writeDyd, bool writeDydb)
+{
+    SourceBuffer source;
+    if (!openSourceBuffer(sourceFileName, source))
+    {
+        std::cerr << "Could not open the file - '" << sourceFileName << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (source.size > MAX_REQUEST_BYTES)
+    {
+        std::cerr << "The source is too large for the server." << std::endl;
+        closeSourceBuffer(source);
+        return EXIT_FAILURE;
+    }
+    sockaddr_un address;
+    int connection = makeAddress(socketPath, address) ? socket(AF_UNIX, SOCK_STREAM, 0) : -1;
+    if (connection < 0 || connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        std::cerr << "Could not connect to '" << socketPath << "'" << std::endl;
+        if (connection >= 0) close(connection);
+        closeSourceBuffer(source);
+        return EXIT_FAILURE;
+    }
+
+    std::string request;
+    appendUint32(request, static_cast<uint32_t>(source.size));
+    bool sent = writeFully(connection, request.data(), request.size()) && writeFully(connection, source.data, source.size);
+    closeSourceBuffer(source);
+    char prefix[sizeof(uint32_t)];
+    std::string response;
+    bool received = sent && readFully(connection, prefix, sizeof(prefix));
+    if (received)
+    {
+        response.resize(loadUint32(prefix));
+        received = readFully(connection, &response[0], response.size());
+    }
+    close(connection);
+
+    DecodedOutputs outputs;
+    if (!received || !decodeCompileOutputs(response.data(), response.size(), outputs))
+    {
+        std::cerr << "Invalid response from '" << socketPath << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::string baseName = sourceFileName.substr(0, sourceFileName.find_last_of("."));
+    return writeCompileOutputs(outputs, baseName, varPath, proPath, lexicalErrorPath, grammarErrorPath, writeDyd, writeDydb);
+}
+
+#else
+
+int runCompileServer(const std::string& socketPath, size_t workers, const CompileOptions& options)
+{
+    (void)socketPath;
+    (void)workers;
+    (void)options;
+    std::cerr << "The compile server needs Unix domain sockets." << std::endl;
+    return EXIT_FAILURE;
+}
+
+int runCompileClient(const std::string& socketPath, const std::string& sourceFileName,
+    const std::string& varPath, const std::string& proPath, const std::string& lexicalErrorPath,
+    const std::string& grammarErrorPath, bool writeDyd, bool writeDydb)
+{
+    (void)socketPath;
+    (void)sourceFileName;
+    (void)varPath;
+    (void)proPath;
+    (void)lexicalErrorPath;
+    (void)grammarErrorPath;
+    (void)writeDyd;
+    (void)writeDydb;
+    std::cerr << "The compile server needs Unix domain sockets." << std::endl;
+    return EXIT_FAILURE;
+}
+
+#endif
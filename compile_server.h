@@ -0,0 +1,31 @@
+#ifndef COMPILE_SERVER_H
+#define COMPILE_SERVER_H
+
+#include <cstdint>
+#include <string>
+#include "compiler.h"
+
+// Э飬ֽСˣuint32ţ
+// Դ򳤶ȣԴһϿη󣬿ͻ˹رӼ
+// ӦֽȻǰencodeCompileOutputsıcompile_outputs.h
+// ͻ˰Ӧ밴4ֽڶĻֱеĶԪʽ¼
+
+// Դĳޣʱر
+const uint32_t MAX_REQUEST_BYTES = 1u << 28;
+
+// һϵȴдôʱرл͵һͣסĿͻ˲һֱռù߳
+const int CONNECTION_TIMEOUT_SECONDS = 10;
+
+// Unix׽socketPathϼworkers̲߳ӣÿ߳ظʹԼĻͱ
+// ʷĸֱڽֻһΡյSIGINTSIGTERMرӡɾ׽ļ0
+// ޷ʱEXIT_FAILURE֧Unix׽ֵƽֱ̨ӷEXIT_FAILURE
+int runCompileServer(const std::string& socketPath, size_t workers, const CompileOptions& options);
+
+// ͻˣsourceFileNamesocketPathϵķرķʽдļ
+// ֹ̱ʱдļwriteDydwriteDydbΪtrueʱдԴļӦ.dyd.dydb
+// ֵ뱾رͬӻͨʧʱEXIT_FAILURE
+int runCompileClient(const std::string& socketPath, const std::string& sourceFileName,
+    const std::string& varPath, const std::string& proPath, const std::string& lexicalErrorPath,
+    const std::string& grammarErrorPath, bool writeDyd, bool writeDydb);
+
+#endif
@@ -0,0 +1,769 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include "compile_session.h"
+
+// ÿͶڵĸĶƶôıʱֻƽƺʼ
+static const size_t LINE_BLOCK_SIZE = 256;
+static const size_t ITEM_BLOCK_SIZE = 256;
+
+// replacement滻v[begin, end)ԪءصĲԭظֵֻгȱ仯ʱƶԪأ
+// һΰͨıͱʱ漰Ԫ
+template <typename T, typename Source>
+static void splice(std::vector<T>& v, size_t begin, size_t end, Source first, Source last)
+{
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    size_t overlap = std::min(count, end - begin);
+    for (size_t k = 0; k < overlap; ++k, ++first)
+    {
+        v[begin + k] = *first;
+    }
+    if (count > overlap)
+    {
+        v.insert(v.begin() + begin + overlap, first, last);
+    }
+    else
+    {
+        v.erase(v.begin() + begin + overlap, v.begin() + end);
+    }
+}
+
+CompileSession::CompileSession(const CompileOptions& options)
+    :options(options)
+    ,lineCount(0)
+    ,mainNameCount(0)
+    ,stopped(false)
+    ,fullParses(0)
+    ,localParses(0)
+    ,cacheValid(false)
+{
+    open(std::string());
+}
+
+// ֻ¼һɾĶΪֹ֮ķ״̬޷Ӽ¼лָ
+static size_t recordedCount(const std::vector<TopLevelOutline>& outline)
+{
+    size_t count = 0;
+    while (count < outline.size() && outline[count++].clean)
+    {
+    }
+    return count;
+}
+
+void CompileSession::lexLine(Line& line)
+{
+    TokenBuffer tokens;
+    Diagnostics diagnostics(std::string(), SIZE_MAX);
+    tokenizeLines(line.text.data(), line.text.size(), 1, tokens, diagnostics);
+    line.tokens.clear();
+    line.pool.clear();
+    for (Token token : tokens.tokens)
+    {
+        size_t offset = line.pool.size();
+        line.pool.append(tokens.pool, token.offset, token.length);
+        token.offset = static_cast<uint32_t>(offset);
+        line.tokens.push_back(token);
+    }
+    line.errors = diagnostics.items();
+}
+
+void CompileSession::splitLines(const std::string& text, std::vector<std::string>& pieces)
+{
+    // ʹʷһ£\n\r\n͵\rһ
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] == '\r' && i + 1 < text.size() && text[i + 1] == '\n')
+        {
+            ++i;
+        }
+        if (text[i] == '\n' || text[i] == '\r')
+        {
+            pieces.push_back(text.substr(start, i + 1 - start));
+            start = i + 1;
+        }
+    }
+    pieces.push_back(text.substr(start));
+}
+
+void CompileSession::open(const std::string& source)
+{
+    std::vector<std::string> pieces;
+    splitLines(source, pieces);
+    lineBlocks.clear();
+    for (size_t first = 0; first < pieces.size(); first += LINE_BLOCK_SIZE)
+    {
+        LineBlock block;
+        block.firstLine = first;
+        block.errorCount = 0;
+        block.lines.resize(std::min(pieces.size() - first, LINE_BLOCK_SIZE));
+        for (size_t i = 0; i < block.lines.size(); ++i)
+        {
+            Line& line = block.lines[i];
+            line.text = std::move(pieces[first + i]);
+            lexLine(line);
+            block.errorCount += line.errors.size();
+        }
+        lineBlocks.push_back(std::move(block));
+    }
+    lineCount = pieces.size();
+    parseAll();
+    cacheValid = false;
+}
+
+std::string CompileSession::text() const
+{
+    std::string result;
+    for (const auto& block : lineBlocks)
+    {
+        for (const auto& line : block.lines)
+        {
+            result += line.text;
+        }
+    }
+    return result;
+}
+
+size_t CompileSession::lineBlockOf(size_t index) const
+{
+    auto it = std::upper_bound(lineBlocks.begin(), lineBlocks.end(), index,
+        [](size_t line, const LineBlock& block) { return line < block.firstLine; });
+    return static_cast<size_t>(it - lineBlocks.begin()) - 1;
+}
+
+const CompileSession::Line& CompileSession::lineAt(size_t index) const
+{
+    const LineBlock& block = lineBlocks[lineBlockOf(index)];
+    return block.lines[index - block.firstLine];
+}
+
+void CompileSession::replaceLines(size_t first, size_t last, std::vector<Line>& added)
+{
+    size_t begin = lineBlockOf(first);
+    size_t end = lineBlockOf(last);
+    // ĶʱȰ漰Ŀ鲢һ
+    for (size_t b = begin + 1; b <= end; ++b)
+    {
+        std::move(lineBlocks[b].lines.begin(), lineBlocks[b].lines.end(), std::back_inserter(lineBlocks[begin].lines));
+    }
+    lineBlocks.erase(lineBlocks.begin() + begin + 1, lineBlocks.begin() + end + 1);
+    LineBlock& block = lineBlocks[begin];
+    splice(block.lines, first - block.firstLine, last + 1 - block.firstLine,
+        std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()));
+    lineCount += added.size() - (last - first + 1);
+    rebalanceLines(begin);
+}
+
+void CompileSession::rebalanceLines(size_t block)
+{
+    // СĿ鲢һ飬ûкһʱǰһ
+    if (lineBlocks[block].lines.size() < LINE_BLOCK_SIZE / 4 && lineBlocks.size() > 1)
+    {
+        if (block + 1 == lineBlocks.size())
+        {
+            --block;
+        }
+        std::vector<Line>& next = lineBlocks[block + 1].lines;
+        std::move(next.begin(), next.end(), std::back_inserter(lineBlocks[block].lines));
+        lineBlocks.erase(lineBlocks.begin() + block + 1);
+    }
+    // Ŀƽɿ
+    size_t end = block + 1;
+    size_t size = lineBlocks[block].lines.size();
+    if (size > 2 * LINE_BLOCK_SIZE)
+    {
+        std::vector<Line> lines = std::move(lineBlocks[block].lines);
+        size_t count = (size + LINE_BLOCK_SIZE - 1) / LINE_BLOCK_SIZE;
+        std::vector<LineBlock> pieces(count);
+        for (size_t k = 0; k < count; ++k)
+        {
+            pieces[k].lines.assign(std::make_move_iterator(lines.begin() + size * k / count),
+                std::make_move_iterator(lines.begin() + size * (k + 1) / count));
+        }
+        splice(lineBlocks, block, block + 1, std::make_move_iterator(pieces.begin()), std::make_move_iterator(pieces.end()));
+        end = block + count;
+    }
+    for (size_t b = block; b < end; ++b)
+    {
+        lineBlocks[b].errorCount = 0;
+        for (const auto& line : lineBlocks[b].lines)
+        {
+            lineBlocks[b].errorCount += line.errors.size();
+        }
+    }
+    for (size_t b = block; b < lineBlocks.size(); ++b)
+    {
+        lineBlocks[b].firstLine = b == 0 ? 0 : lineBlocks[b - 1].firstLine + lineBlocks[b - 1].lines.size();
+    }
+}
+
+void CompileSession::appendEndOfFile(TokenBuffer& tokens) const
+{
+    // ʹʷһ£EOFλһеĩβ
+    tokens.append("EOF", 3, TokenKind::END_OF_FILE, static_cast<uint32_t>(lineCount), lineBlocks.back().lines.back().text.size() + 1);
+}
+
+void CompileSession::collectItems(const std::vector<TopLevelOutline>& outline, size_t count, const TokenBuffer& tokens,
+    const std::vector<size_t>& lineStart, size_t firstLine, size_t firstOffset,
+    const Diagnostics& diagnostics, std::vector<TopLevelItem>& items) const
+{
+    const std::vector<Diagnostic>& errors = diagnostics.items();
+    size_t varEnd = 0;
+    size_t proEnd = 0;
+    size_t diagEnd = 0;
+    for (size_t k = 0; k < count; ++k)
+    {
+        const TopLevelOutline& entry = outline[k];
+        TopLevelItem item;
+        item.isStatement = entry.isStatement;
+        item.isFunction = entry.isFunction;
+        item.clean = entry.clean;
+        if (entry.clean)
+        {
+            item.name = entry.name;
+        }
+        item.endLine = tokens.tokens[entry.endToken].line - 1;
+        item.endOffset = entry.endToken - lineStart[item.endLine - firstLine] + (item.endLine == firstLine ? firstOffset : 0);
+        item.varCount = entry.varEnd - varEnd;
+        item.proCount = entry.proEnd - proEnd;
+        for (; diagEnd < entry.diagEnd; ++diagEnd)
+        {
+            Diagnostic d = errors[diagEnd];
+            d.line = item.endLine + 1 - d.line;
+            item.errors.push_back(d);
+        }
+        varEnd = entry.varEnd;
+        proEnd = entry.proEnd;
+        items.push_back(std::move(item));
+    }
+}
+
+void CompileSession::replaceItems(ItemPosition from, ItemPosition to, std::vector<TopLevelItem>& added, size_t lineDelta)
+{
+    // 滻Ŀ[begin, end)from֮ǰto֮ͬadded·ֿ飬Ȼɾк
+    size_t begin = from.block;
+    size_t end = std::min(to.block + 1, itemBlocks.size());
+    std::vector<TopLevelItem> merged;
+    auto takeFrom = [&](size_t block, size_t first, size_t last, size_t delta)
+    {
+        ItemBlock& source = itemBlocks[block];
+        for (size_t i = first; i < last; ++i)
+        {
+            merged.push_back(std::move(source.items[i]));
+            merged.back().endLine += source.baseLine + delta;
+        }
+    };
+    if (begin < itemBlocks.size())
+    {
+        takeFrom(begin, 0, from.index, 0);
+    }
+    std::move(added.begin(), added.end(), std::back_inserter(merged));
+    if (to.block < itemBlocks.size())
+    {
+        takeFrom(to.block, to.index, itemBlocks[to.block].items.size(), lineDelta);
+    }
+    // ʣµ̫ʱͬǰһ·ֿ飬ͬһ༭ԽԽ
+    if (merged.size() < ITEM_BLOCK_SIZE / 4)
+    {
+        if (end < itemBlocks.size())
+        {
+            takeFrom(end, 0, itemBlocks[end].items.size(), lineDelta);
+            ++end;
+        }
+        if (begin > 0)
+        {
+            std::vector<TopLevelItem> rest = std::move(merged);
+            merged.clear();
+            --begin;
+            takeFrom(begin, 0, itemBlocks[begin].items.size(), 0);
+            std::move(rest.begin(), rest.end(), std::back_inserter(merged));
+        }
+    }
+
+    size_t size = merged.size();
+    size_t count = size > 2 * ITEM_BLOCK_SIZE ? (size + ITEM_BLOCK_SIZE - 1) / ITEM_BLOCK_SIZE : size > 0 ? 1 : 0;
+    std::vector<ItemBlock> blocks(count);
+    for (size_t k = 0; k < count; ++k)
+    {
+        ItemBlock& block = blocks[k];
+        block.baseLine = merged[size * k / count].endLine;
+        block.varCount = block.proCount = block.nameCount = block.errorCount = 0;
+        for (size_t i = size * k / count; i < size * (k + 1) / count; ++i)
+        {
+            TopLevelItem& item = merged[i];
+            item.endLine -= block.baseLine;
+            block.varCount += item.varCount;
+            block.proCount += item.proCount;
+            block.nameCount += item.name.empty() ? 0 : 1;
+            block.errorCount += item.errors.size();
+            block.items.push_back(std::move(item));
+        }
+    }
+    if (lineDelta != 0)
+    {
+        for (size_t b = end; b < itemBlocks.size(); ++b)
+        {
+            itemBlocks[b].baseLine += lineDelta;
+        }
+    }
+    splice(itemBlocks, begin, end, std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+}
+
+CompileSession::ItemPosition CompileSession::nextItem(ItemPosition position) const
+{
+    if (position.index + 1 < itemBlocks[position.block].items.size())
+    {
+        return ItemPosition{ position.block, position.index + 1 };
+    }
+    return ItemPosition{ position.block + 1, 0 };
+}
+
+size_t CompileSession::itemEndLine(ItemPosition position) const
+{
+    const ItemBlock& block = itemBlocks[position.block];
+    return block.baseLine + block.items[position.index].endLine;
+}
+
+void CompileSession::countThrough(ItemPosition position, size_t& vars, size_t& pros, size_t& names) const
+{
+    vars = pros = names = 0;
+    for (size_t b = 0; b < position.block; ++b)
+    {
+        vars += itemBlocks[b].varCount;
+        pros += itemBlocks[b].proCount;
+        names += itemBlocks[b].nameCount;
+    }
+    const ItemBlock& block = itemBlocks[position.block];
+    for (size_t i = 0; i <= position.index; ++i)
+    {
+        vars += block.items[i].varCount;
+        pros += block.items[i].proCount;
+        names += block.items[i].name.empty() ? 0 : 1;
+    }
+}
+
+void CompileSession::setTailErrors(const std::vector<Diagnostic>& errors)
+{
+    size_t base = 0;
+    if (!itemBlocks.empty())
+    {
+        base = itemBlocks.back().baseLine + itemBlocks.back().items.back().endLine + 1;
+    }
+    tailErrors = errors;
+    for (auto& d : tailErrors)
+    {
+        d.line -= base;
+    }
+}
+
+void CompileSession::parseAll()
+{
+    // ѸеĵԪӳĵԪУкŰд
+    TokenBuffer tokens;
+    std::vector<size_t> lineStart;
+    lineStart.reserve(lineCount);
+    for (const auto& block : lineBlocks)
+    {
+        for (size_t i = 0; i < block.lines.size(); ++i)
+        {
+            const Line& line = block.lines[i];
+            lineStart.push_back(tokens.tokens.size());
+            for (const Token& token : line.tokens)
+            {
+                tokens.append(line.pool.data() + token.offset, token.length, token.kind,
+                    static_cast<uint32_t>(block.firstLine + i + 1), token.column);
+            }
+        }
+    }
+    appendEndOfFile(tokens);
+
+    Diagnostics diagnostics(std::string(), SIZE_MAX);
+    std::vector<TopLevelOutline> outline;
+    GrammarAnalyzer analyzer(tokens.view(), diagnostics);
+    analyzer.setOutline(&outline);
+    analyzer.parseProgram();
+    varList = analyzer.getVarList();
+    proList = analyzer.getProList();
+    stopped = analyzer.isStopped();
+    ++fullParses;
+
+    std::vector<TopLevelItem> items;
+    collectItems(outline, recordedCount(outline), tokens, lineStart, 0, 0, diagnostics, items);
+    mainNames.clear();
+    mainNameCount = 0;
+    for (const auto& item : items)
+    {
+        if (!item.name.empty())
+        {
+            mainNames.emplace(item.name, std::make_pair(mainNameCount++, Symbol{ item.isFunction, 0 }));
+        }
+    }
+    size_t diagEnd = items.empty() ? 0 : outline[items.size() - 1].diagEnd;
+    itemBlocks.clear();
+    replaceItems(ItemPosition{ 0, 0 }, ItemPosition{ 0, 0 }, items, 0);
+    setTailErrors(std::vector<Diagnostic>(diagnostics.items().begin() + diagEnd, diagnostics.items().end()));
+}
+
+bool CompileSession::parseBetween(const ItemPosition* after, const ItemPosition* until, size_t lineDelta)
+{
+    size_t firstLine = 0;
+    size_t firstOffset = 0;
+    if (after != nullptr)
+    {
+        firstLine = itemEndLine(*after);
+        firstOffset = itemBlocks[after->block].items[after->index].endOffset;
+    }
+    size_t expectedLine = until != nullptr ? itemEndLine(*until) + lineDelta : lineCount;
+
+    // ڵĵԪȡԪuntilʱȡԭĵԪ֮Ԫ
+    // ʹǰĽʱͬʱEOFֻڱԽԭյʱͣ棬λöԲ
+    TokenBuffer tokens;
+    std::vector<size_t> lineStart;
+    size_t expected = 0;
+    size_t block = lineBlockOf(firstLine);
+    for (size_t index = firstLine; index < lineCount; ++index)
+    {
+        if (index > expectedLine && tokens.tokens.size() > expected + 3) break;
+        while (index >= lineBlocks[block].firstLine + lineBlocks[block].lines.size())
+        {
+            ++block;
+        }
+        const Line& line = lineBlocks[block].lines[index - lineBlocks[block].firstLine];
+        size_t from = index == firstLine ? firstOffset : 0;
+        lineStart.push_back(tokens.tokens.size());
+        if (index == expectedLine)
+        {
+            expected = tokens.tokens.size() + itemBlocks[until->block].items[until->index].endOffset - from;
+        }
+        for (size_t j = from; j < line.tokens.size(); ++j)
+        {
+            const Token& token = line.tokens[j];
+            tokens.append(line.pool.data() + token.offset, token.length, token.kind, static_cast<uint32_t>(index + 1), token.column);
+        }
+    }
+    appendEndOfFile(tokens);
+
+    Diagnostics diagnostics(std::string(), SIZE_MAX);
+    std::vector<TopLevelOutline> outline;
+    GrammarAnalyzer analyzer(tokens.view(), diagnostics);
+    analyzer.setOutline(&outline);
+    size_t varBase = 0;
+    size_t proBase = 0;
+    size_t nameBase = 0;
+    if (after != nullptr)
+    {
+        countThrough(*after, varBase, proBase, nameBase);
+        analyzer.resume(varBase, proBase, &mainNames, nameBase);
+        analyzer.parseMainBlock(itemBlocks[after->block].items[after->index].isStatement
+            ? MainBlockEntry::AFTER_STATEMENT : MainBlockEntry::AFTER_DECLARATION);
+    }
+    else
+    {
+        analyzer.parseProgram();
+    }
+
+    ItemPosition from = after != nullptr ? nextItem(*after) : ItemPosition{ 0, 0 };
+    ItemPosition to = ItemPosition{ itemBlocks.size(), 0 };
+    size_t count = recordedCount(outline);
+    size_t varEnd = analyzer.getVarList().size();
+    size_t proEnd = analyzer.getProList().size();
+    size_t oldVarEnd = varList.size();
+    size_t oldProEnd = proList.size();
+    if (until != nullptr)
+    {
+        // untilԭĵԪͬķʽǰǼǵֺ˳Ҳ䣬
+        // ֮ķԭֻͬ±кƽ
+        const TopLevelItem& old = itemBlocks[until->block].items[until->index];
+        size_t match = 0;
+        while (match < count && outline[match].endToken < expected)
+        {
+            ++match;
+        }
+        if (match == count || outline[match].endToken != expected || !outline[match].clean
+            || outline[match].isStatement != old.isStatement)
+        {
+            return false;
+        }
+        count = match + 1;
+        std::vector<std::pair<std::string, bool>> oldNames;
+        std::vector<std::pair<std::string, bool>> newNames;
+        to = nextItem(*until);
+        for (ItemPosition p = from; p.block != to.block || p.index != to.index; p = nextItem(p))
+        {
+            const TopLevelItem& item = itemBlocks[p.block].items[p.index];
+            if (!item.name.empty()) oldNames.emplace_back(item.name, item.isFunction);
+        }
+        for (size_t k = 0; k < count; ++k)
+        {
+            if (!outline[k].name.empty()) newNames.emplace_back(outline[k].name, outline[k].isFunction);
+        }
+        if (oldNames != newNames) return false;
+        varEnd = outline[match].varEnd;
+        proEnd = outline[match].proEnd;
+        size_t names;
+        countThrough(*until, oldVarEnd, oldProEnd, names);
+    }
+    else
+    {
+        // ȫĩβĶ֮Ǽǵȫµ˳µǼ
+        for (ItemPosition p = from; p.block < itemBlocks.size(); p = nextItem(p))
+        {
+            const std::string& name = itemBlocks[p.block].items[p.index].name;
+            auto it = mainNames.find(name);
+            if (!name.empty() && it != mainNames.end() && it->second.first >= nameBase)
+            {
+                mainNames.erase(it);
+            }
+        }
+        mainNameCount = nameBase;
+        for (size_t k = 0; k < count; ++k)
+        {
+            if (outline[k].clean && !outline[k].name.empty())
+            {
+                mainNames.emplace(outline[k].name, std::make_pair(mainNameCount++, Symbol{ outline[k].isFunction, 0 }));
+            }
+        }
+        stopped = analyzer.isStopped();
+    }
+
+    const std::vector<VarUnit>& vars = analyzer.getVarList();
+    const std::vector<ProUnit>& pros = analyzer.getProList();
+    size_t varDelta = varEnd - (oldVarEnd - varBase);
+    splice(varList, varBase, oldVarEnd, vars.begin(), vars.begin() + static_cast<std::ptrdiff_t>(varEnd));
+    splice(proList, proBase, oldProEnd, pros.begin(), pros.begin() + static_cast<std::ptrdiff_t>(proEnd));
+    if (varDelta != 0)
+    {
+        for (size_t k = varBase + varEnd; k < varList.size(); ++k)
+        {
+            varList[k].vAdr += varDelta;
+        }
+        for (size_t k = proBase + proEnd; k < proList.size(); ++k)
+        {
+            proList[k].fAdr += varDelta;
+            // lAdrΪ0ʾûоֲĺı±겻0
+            if (proList[k].lAdr != 0) proList[k].lAdr += varDelta;
+        }
+    }
+
+    std::vector<TopLevelItem> items;
+    collectItems(outline, count, tokens, lineStart, firstLine, firstOffset, diagnostics, items);
+    size_t diagEnd = count > 0 ? outline[count - 1].diagEnd : 0;
+    replaceItems(from, to, items, lineDelta);
+    if (until == nullptr)
+    {
+        setTailErrors(std::vector<Diagnostic>(diagnostics.items().begin() + diagEnd, diagnostics.items().end()));
+    }
+    return true;
+}
+
+bool CompileSession::parseLocal(size_t first, size_t last, size_t added)
+{
+    // Ĳֵ޷
+    size_t lineDelta = added - (last - first + 1);
+    // ҳĶ֮ǰһĶafter͸Ķ֮һĶuntilкŶǱ༭ǰ
+    bool hasAfter = false;
+    bool hasUntil = false;
+    ItemPosition after{ 0, 0 };
+    ItemPosition until{ 0, 0 };
+    for (size_t b = 0; b < itemBlocks.size() && !hasUntil; ++b)
+    {
+        const ItemBlock& block = itemBlocks[b];
+        if (block.baseLine + block.items.back().endLine < first)
+        {
+            after = ItemPosition{ b, block.items.size() - 1 };
+            hasAfter = true;
+            continue;
+        }
+        for (size_t i = 0; i < block.items.size(); ++i)
+        {
+            size_t end = block.baseLine + block.items[i].endLine;
+            if (end < first)
+            {
+                after = ItemPosition{ b, i };
+                hasAfter = true;
+            }
+            else if (end > last)
+            {
+                until = ItemPosition{ b, i };
+                hasUntil = true;
+                break;
+            }
+        }
+    }
+    // ŷafterĵԪɾͺһԪҲҪڸĶ֮ǰ
+    auto resumable = [&](ItemPosition position)
+    {
+        const TopLevelItem& item = itemBlocks[position.block].items[position.index];
+        if (!item.clean) return false;
+        size_t line = itemEndLine(position);
+        if (item.endOffset + 1 < lineAt(line).tokens.size()) return true;
+        for (size_t next = line + 1; next < first; ++next)
+        {
+            if (!lineAt(next).tokens.empty()) return true;
+        }
+        return false;
+    };
+    while (hasAfter && !resumable(after))
+    {
+        if (after.index > 0)
+        {
+            --after.index;
+        }
+        else if (after.block > 0)
+        {
+            --after.block;
+            after.index = itemBlocks[after.block].items.size() - 1;
+        }
+        else
+        {
+            hasAfter = false;
+        }
+    }
+    // untilҪɾҲܽEOFϣûпԶĵԪ
+    if (hasUntil)
+    {
+        const TopLevelItem& item = itemBlocks[until.block].items[until.index];
+        if (!item.clean || item.endOffset >= lineAt(itemEndLine(until) + lineDelta).tokens.size())
+        {
+            hasUntil = false;
+        }
+    }
+    if (hasUntil && parseBetween(hasAfter ? &after : nullptr, &until, lineDelta))
+    {
+        ++localParses;
+        return true;
+    }
+    // ԲʱȫĩβûпԽŷʱ·
+    if (!hasAfter) return false;
+    parseBetween(&after, nullptr, lineDelta);
+    ++localParses;
+    return true;
+}
+
+bool CompileSession::applyEdit(const TextEdit& edit)
+{
+    if (edit.line == 0 || edit.line > lineCount || edit.column == 0
+        || edit.column - 1 > lineAt(edit.line - 1).text.size())
+    {
+        return false;
+    }
+    size_t first = edit.line - 1;
+    size_t column = edit.column - 1;
+
+    // ҵɾΧкУȫĵĲֺ
+    size_t last = first;
+    size_t endColumn = column;
+    size_t remaining = edit.length;
+    while (remaining > lineAt(last).text.size() - endColumn && last + 1 < lineCount)
+    {
+        remaining -= lineAt(last).text.size() - endColumn;
+        ++last;
+        endColumn = 0;
+    }
+    endColumn = std::min(endColumn + remaining, lineAt(last).text.size());
+
+    std::string combined = lineAt(first).text.substr(0, column) + edit.text + lineAt(last).text.substr(endColumn);
+    // βĻзɾʱһҪһн
+    if (!combined.empty() && combined.back() != '\n' && last + 1 < lineCount)
+    {
+        ++last;
+        combined += lineAt(last).text;
+    }
+    // \rͽ\nϳһУǰһ\rβʱıǷ\nͷ
+    if (first > 0 && lineAt(first - 1).text.back() == '\r')
+    {
+        bool joinNext = combined.empty() && last + 1 < lineCount;
+        const std::string& following = joinNext ? lineAt(last + 1).text : combined;
+        if (!following.empty() && following[0] == '\n')
+        {
+            if (joinNext)
+            {
+                ++last;
+                combined = lineAt(last).text;
+            }
+            --first;
+            combined = lineAt(first).text + combined;
+        }
+    }
+
+    std::vector<std::string> pieces;
+    splitLines(combined, pieces);
+    // зֳһֻȫĩβʱǵһ
+    if (last + 1 < lineCount && pieces.back().empty())
+    {
+        pieces.pop_back();
+    }
+
+    std::vector<Line> added(pieces.size());
+    for (size_t i = 0; i < pieces.size(); ++i)
+    {
+        added[i].text = std::move(pieces[i]);
+        lexLine(added[i]);
+    }
+    size_t count = added.size();
+    replaceLines(first, last, added);
+
+    if (!parseLocal(first, last, count))
+    {
+        parseAll();
+    }
+    cacheValid = false;
+    return true;
+}
+
+const Diagnostics& CompileSession::lexicalDiagnostics() const
+{
+    if (!cacheValid)
+    {
+        // ûдĿֱﵽ޺ֻɵĴ޳
+        lexicalCache = Diagnostics(std::string(), options.maxErrors, options.columns);
+        for (const auto& block : lineBlocks)
+        {
+            if (block.errorCount == 0) continue;
+            if (lexicalCache.full())
+            {
+                lexicalCache.reportOmitted(block.errorCount);
+                continue;
+            }
+            for (size_t i = 0; i < block.lines.size(); ++i)
+            {
+                for (const auto& d : block.lines[i].errors)
+                {
+                    lexicalCache.report(d.type, block.firstLine + i + 1, d.column, d.symbol);
+                }
+            }
+        }
+        grammarCache = Diagnostics(std::string(), options.maxErrors, options.columns);
+        size_t lastEnd = 0; // һкţ1ʼ
+        for (const auto& block : itemBlocks)
+        {
+            lastEnd = block.baseLine + block.items.back().endLine + 1;
+            if (block.errorCount == 0) continue;
+            if (grammarCache.full())
+            {
+                grammarCache.reportOmitted(block.errorCount);
+                continue;
+            }
+            for (const auto& item : block.items)
+            {
+                size_t end = block.baseLine + item.endLine + 1;
+                for (const auto& d : item.errors)
+                {
+                    grammarCache.report(d.type, end - d.line, d.column, d.symbol);
+                }
+            }
+        }
+        for (const auto& d : tailErrors)
+        {
+            grammarCache.report(d.type, lastEnd + d.line, d.column, d.symbol);
+        }
+        cacheValid = true;
+    }
+    return lexicalCache;
+}
+
+const Diagnostics& CompileSession::grammarDiagnostics() const
+{
+    lexicalDiagnostics();
+    return grammarCache;
+}
@@ -0,0 +1,188 @@
+#ifndef COMPILE_SESSION_H
+#define COMPILE_SESSION_H
+
+#include <string>
+#include <vector>
+#include "compiler.h"
+
+// һα༭ӵlineеcolumnУ1ʼаֽڼƣɾlengthֽڣٲtext
+struct TextEdit
+{
+    size_t line;
+    size_t column;
+    size_t length;
+    std::string text;
+};
+
+// Ựл浥Ԫʹʷ󣬰Ķ䣨˵ִ䣩﷨Ľ
+// ÿα༭ֻɨĶУ﷨ӸĶ֮ǰһλýŽУ
+// Ķ֮һԭλýǼǵûб仯ĶΪֹĽֻƽƣ
+// ҲʱȫĩβкͶ䶼ֿ鱣棬кڵĿ飬
+// ﷨кĶ䣬ıı༭ֻؽ漰Ŀ鲢ƽƺʼС
+// һα༭ĴĶ漰Ķ䣨Ķںڲʱ㺯ȣ
+// ȵɾʱ͹̱к±ҲҪƽơ
+// Ա༭ȫĵcompileSourceһ
+class CompileSession
+{
+private:
+    // һУԭģβĻзеĵԪʹʷ
+    // ԪкŲãкڸеλãкҲãȡʱڵλд
+    struct Line
+    {
+        std::string text;
+        std::vector<Token> tokens;
+        std::string pool; // еʵƴд
+        std::vector<Diagnostic> errors;
+    };
+
+    // 
+    struct LineBlock
+    {
+        size_t firstLine; // һе±꣬0ʼ
+        std::vector<Line> lines;
+        size_t errorCount; // дʷ
+    };
+
+    // еһ
+    struct TopLevelItem
+    {
+        bool isStatement; // Ƿִ
+        bool isFunction; // Ƿ˵
+        bool clean; // TopLevelOutline::cleanֻһΪfalse
+        std::string name; // еǼǵ֣ûеǼǻcleanΪfalseʱΪ
+        size_t endLine; // ʱڵԪУڿbaseLine
+        size_t endOffset; // õԪһеԪе±꣬һеĵԪʱEOF
+        size_t varCount; // Ǽǵı
+        size_t proCount; // ǼǵĹ̸
+        std::vector<Diagnostic> errors; // һһʱ﷨кżΪмȥ
+    };
+
+    // 䣬ǿиܺ
+    struct ItemBlock
+    {
+        size_t baseLine; // һ
+        std::vector<TopLevelItem> items;
+        size_t varCount, proCount, nameCount, errorCount;
+    };
+
+    // һλãڵĿڿе±
+    struct ItemPosition
+    {
+        size_t block;
+        size_t index;
+    };
+
+    CompileOptions options;
+    std::vector<LineBlock> lineBlocks;
+    size_t lineCount;
+    std::vector<ItemBlock> itemBlocks; // λ
+    std::vector<Diagnostic> tailErrors; // һ֮﷨кżΪеĲ
+    SymbolTable::OrderedNames mainNames; // еǼǵ֣Ǽ˳
+    size_t mainNameCount; // ǼǵĴδЧ
+    std::vector<VarUnit> varList;
+    std::vector<ProUnit> proList;
+    bool stopped;
+    size_t fullParses; // ·Ĵ
+    size_t localParses; // ֻ·һֶĴ
+
+    // Ϣȡʱ
+    mutable Diagnostics lexicalCache;
+    mutable Diagnostics grammarCache;
+    mutable bool cacheValid;
+
+    // ɨһУԪʹʷline
+    static void lexLine(Line& line);
+
+    // textзгУÿбԼĻз
+    static void splitLines(const std::string& text, std::vector<std::string>& pieces);
+
+    // indexУ0ʼڵĿ
+    size_t lineBlockOf(size_t index) const;
+
+    const Line& lineAt(size_t index) const;
+
+    // added滻firstlastУֻؽ漰Ŀ
+    void replaceLines(size_t first, size_t last, std::vector<Line>& added);
+
+    // blockʱ֡СʱڵĿϲ¼ʼ
+    void rebalanceLines(size_t block);
+
+    // tokensĩβλȫĩβEOF
+    void appendEndOfFile(TokenBuffer& tokens) const;
+
+    // ѷ¼еǰcountתΪ䣬ΪкštokensǴӵfirstLine
+    // firstOffsetԪȡĵԪlineStart[i]ǵfirstLine + iеһȡĵԪ±
+    void collectItems(const std::vector<TopLevelOutline>& outline, size_t count, const TokenBuffer& tokens,
+        const std::vector<size_t>& lineStart, size_t firstLine, size_t firstOffset,
+        const Diagnostics& diagnostics, std::vector<TopLevelItem>& items) const;
+
+    // addedΪкţ滻[from, to)Ķ䣬to֮ƽlineDelta
+    void replaceItems(ItemPosition from, ItemPosition to, std::vector<TopLevelItem>& added, size_t lineDelta);
+
+    // һλãһ֮{ itemBlocks.size(), 0 }
+    ItemPosition nextItem(ItemPosition position) const;
+
+    // еľк
+    size_t itemEndLine(ItemPosition position) const;
+
+    // 䣨ΪֹǼǵıֵ̺ĸ
+    void countThrough(ItemPosition position, size_t& vars, size_t& pros, size_t& names) const;
+
+    // errors滻һ֮﷨errorsǾк
+    void setTailErrors(const std::vector<Diagnostic>& errors);
+
+    // ȫ·򣬲ؽļ¼
+    void parseAll();
+
+    // afterλãΪnullptrʱͷŷuntilƽlineDeltaкԭλýΪֹ
+    // untilΪnullptrʱȫĩβuntilûԭλýǼǵб仯ʱfalseҲĶ
+    bool parseBetween(const ItemPosition* after, const ItemPosition* until, size_t lineDelta);
+
+    // ༭ǰfirstlastУ滻ΪaddedУڸĶ֮ǰҵԽŷĶʱ
+    // ֻ·֮Ĳ֣ɹtrue
+    bool parseLocal(size_t first, size_t last, size_t added);
+
+public:
+    explicit CompileSession(const CompileOptions& options = CompileOptions());
+
+    // Դ򲢱
+    void open(const std::string& source);
+
+    // Ӧһα༭½λòϷʱfalseҲκθĶ
+    bool applyEdit(const TextEdit& edit);
+
+    // ǰȫ
+    std::string text() const;
+
+    const std::vector<VarUnit>& getVarList() const
+    {
+        return varList;
+    }
+
+    const std::vector<ProUnit>& getProList() const
+    {
+        return proList;
+    }
+
+    const Diagnostics& lexicalDiagnostics() const;
+
+    const Diagnostics& grammarDiagnostics() const;
+
+    // ﷨Ƿֹ
+    bool isStopped() const
+    {
+        return stopped;
+    }
+
+    size_t fullParseCount() const
+    {
+        return fullParses;
+    }
+
+    size_t localParseCount() const
+    {
+        return localParses;
+    }
+};
+
+#endif
@@ -0,0 +1,27 @@
+#include "compiler.h"
+
+void compileSource(const char* source, size_t size, const CompileOptions& options, CompileResult& result)
+{
+    result.tokens.clear(); // ϴεظʹͬһresultʱ·
+    result.lexicalDiagnostics = Diagnostics(std::string(), options.maxErrors, options.columns);
+    result.grammarDiagnostics = Diagnostics(std::string(), options.maxErrors, options.columns);
+    result.arena.release();
+    result.program = nullptr;
+
+    // ʷ
+    tokenize(source, size, result.tokens, result.lexicalDiagnostics);
+
+    // ﷨resultеĶԪʽб﷨result
+    GrammarAnalyzer analyzer(result.tokens.view(), result.grammarDiagnostics);
+    if (options.buildTree) analyzer.setArena(&result.arena);
+    analyzer.parseProgram();
+    result.program = analyzer.getProgram();
+    result.varList = analyzer.getVarList();
+    result.proList = analyzer.getProList();
+    result.stopped = analyzer.isStopped();
+}
+
+void compileSource(const std::string& source, const CompileOptions& options, CompileResult& result)
+{
+    compileSource(source.data(), source.size(), options, result);
+}
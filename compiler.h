@@ -0,0 +1,50 @@
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include <string>
+#include <vector>
+#include "diagnostics.h"
+#include "lexical_analyzer.h"
+#include "grammar_analyzer.h"
+#include "ast.h"
+
+// ǶıӿڣڴеԴȫCompileResultУ
+// дκļҲʹȫֿɱ״̬ͬ߳̿ͬʱԵ
+
+// İ汾ļĸʽıʱ£뻺ļºɵĿ
+const char* const COMPILER_VERSION = "1.1";
+
+// ѡ
+struct CompileOptions 
+{
+    size_t maxErrors = Diagnostics::DEFAULT_LIMIT; // ÿ׶¼Ĵ
+    bool columns = false; // ϢкźǷк
+    bool buildTree = true; // Ƿ﷨ΪfalseʱprogramΪnullptr
+};
+
+// һαȫ
+struct CompileResult 
+{
+    TokenBuffer tokens; // Ԫʽб
+    std::vector<VarUnit> varList; // 
+    std::vector<ProUnit> proList; // ̱
+    Diagnostics lexicalDiagnostics; // ʷ
+    Diagnostics grammarDiagnostics; // ﷨
+    bool stopped = false; // ﷨Ƿֹ
+    Arena arena; // ﷨ڵһͷ
+    const Program* program = nullptr; // ﷨beginʼʱΪnullptr
+
+    // ûκδʱtrue
+    bool succeeded() const
+    {
+        return !stopped && lexicalDiagnostics.count() == 0 && grammarDiagnostics.count() == 0;
+    }
+};
+
+// ڴеԴsource'\0'βresultԭеݻᱻ
+void compileSource(const char* source, size_t size, const CompileOptions& options, CompileResult& result);
+
+// ͬϣԴstring
+void compileSource(const std::string& source, const CompileOptions& options, CompileResult& result);
+
+#endif
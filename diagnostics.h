@@ -0,0 +1,147 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ͣʷ﷨
+enum class ErrorType {
+    INVALID_SYMBOL, // Ϸıʶ
+    IDENTIFIER_TOO_LONG, // ʶ
+    MISSING_EQUAL_AFTER_COLON, // ðŲƥ
+    SYMBOL_NOT_FOUND, // ȱٷ
+    SYMBOL_NOT_MATCH, // Ųƥ
+    SYMBOL_NOT_DEFINED, // δ
+    SOURCE_TOO_LARGE, // Դ򳬹Ԫ32λλܱʾĳ
+};
+
+// һϢ
+struct Diagnostic 
+{
+    ErrorType type; // 
+    size_t line; // к
+    size_t column; // кţ0ʾδ֪
+    std::string symbol; // صķţ﷨ʹ
+};
+
+// Ϣռֻ¼ڴУ޵ֻ棬
+// ׶νʱʽһдļ
+class Diagnostics 
+{
+private:
+    std::string outputPath; // ļ·
+    size_t limit; // ౣ
+    size_t total; // ʵʱޱ
+    std::vector<Diagnostic> entries; // Ϣ
+    bool columns; // ʱǷкźк
+
+public:
+    static const size_t DEFAULT_LIMIT = 1000;
+
+    // 캯outputPathΪʱֻڴռflush
+    // columnsΪtrueʱļÿһкź":к"кδ֪ĲӣĬϱԭеĸʽ
+    explicit Diagnostics(const std::string& outputPath = std::string(), size_t limit = DEFAULT_LIMIT, bool columns = false)
+        :outputPath(outputPath)
+        ,limit(limit)
+        ,total(0)
+        ,columns(columns)
+    {}
+
+    // ¼һϢ
+    void report(ErrorType type, size_t line, size_t column, const std::string& symbol = std::string())
+    {
+        ++total;
+        if (entries.size() < limit)
+        {
+            entries.push_back(Diagnostic{ type, line, column, symbol });
+        }
+    }
+
+    // ǷѴ
+    bool full() const
+    {
+        return entries.size() >= limit;
+    }
+
+    // Ѵ޺¼countϢֻ
+    void reportOmitted(size_t count)
+    {
+        total += count;
+    }
+
+    // 
+    size_t count() const
+    {
+        return total;
+    }
+
+    const std::vector<Diagnostic>& items() const
+    {
+        return entries;
+    }
+
+    // ԭеĴļʽһϢcolumnsΪtrueʱкд":"
+    static void format(const Diagnostic& d, std::string& out, bool columns = false)
+    {
+        std::string position = std::to_string(d.line);
+        if (columns && d.column > 0) position += ":" + std::to_string(d.column);
+        switch (d.type)
+        {
+        case ErrorType::INVALID_SYMBOL:
+            out += "***LINE:" + position + "  Invalid symbol.\n";
+            break;
+        case ErrorType::IDENTIFIER_TOO_LONG:
+            out += "***LINE:" + position + "  Identifier is too long.\n";
+            break;
+        case ErrorType::MISSING_EQUAL_AFTER_COLON:
+            out += "***LINE:" + position + "  miss '=' after ':'.\n";
+            break;
+        case ErrorType::SYMBOL_NOT_FOUND:
+            out += "***" + position + ": " + d.symbol + " not found.\n";
+            break;
+        case ErrorType::SYMBOL_NOT_MATCH:
+            out += "***" + position + ": " + d.symbol + " not matched.\n";
+            break;
+        case ErrorType::SYMBOL_NOT_DEFINED:
+            out += "***" + position + ": " + d.symbol + " not defined.\n";
+            break;
+        case ErrorType::SOURCE_TOO_LARGE:
+            out += "***Source is too large: " + d.symbol + " bytes.\n";
+            break;
+        }
+    }
+
+    // ȫϢļĸʽƴıڴʹʱؾļ
+    std::string text() const
+    {
+        std::string buffer;
+        buffer.reserve(entries.size() * 40);
+        for (const auto& d : entries)
+        {
+            format(d, buffer, columns);
+        }
+        if (total > entries.size())
+        {
+            buffer += "***" + std::to_string(total - entries.size()) + " more errors not shown.\n";
+        }
+        return buffer;
+    }
+
+    // ȫϢһдļԭݣ
+    bool flush() const
+    {
+        std::string buffer = text();
+        std::ofstream out(outputPath, std::ios::out | std::ios::trunc);
+        if (!out.is_open())
+        {
+            std::cerr << "Unable to open error file." << std::endl;
+            return false;
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return true;
+    }
+};
+
+#endif
@@ -6,7 +6,11 @@
 #include <string>
 #include <vector>
 #include <iomanip>
-#include <unordered_set>
+#include "lexical_analyzer.h"
+#include "symbol_table.h"
+#include "table_writer.h"
+#include "token_stream.h"
+#include "ast.h"
 
 // һԪ
 class VarUnit 
@@ -29,24 +33,16 @@ public:
         ,vAdr(adr)
     {}
 
-    // Ԫ
-    void printer(const std::string& output_path) const 
+    // ԪдѴ򿪵ı
+    void printer(TableWriter& writer) const 
     {
-        // ʹfstream򿪲дļ
-        std::ofstream s(output_path, std::ios::app); 
-        if (!s.is_open()) 
-        {
-            std::cerr << "Failed to open file: " << output_path << '\n';
-            return;
-        }
-        // ʹiomanipʽ
-        s << std::left
-          << std::setw(10) << vName
-          << std::setw(10) << vProc
-          << std::setw(10) << vKind
-          << std::setw(10) << vType
-          << std::setw(10) << vLev
-          << std::setw(10) << vAdr << '\n';
+        writer.field(vName)
+              .field(vProc)
+              .field(vKind)
+              .field(vType)
+              .field(vLev)
+              .field(vAdr);
+        writer.endRow();
     }
 };
 
@@ -70,631 +66,1102 @@ public:
     {}
 
     // ̵Ԫ
-    void printer(const std::string& output_path) const 
+    void printer(TableWriter& writer) const 
     {
-        std::ofstream s(output_path, std::ios::app);
-        if (!s.is_open()) 
-        {
-            std::cerr << "Failed to open file: " << output_path << '\n';
-            return;
-        }
-        s << std::left
-          << std::setw(10) << pName
-          << std::setw(10) << pType
-          << std::setw(10) << pLev
-          << std::setw(10) << fAdr
-          << std::setw(10) << lAdr << '\n';
+        writer.field(pName)
+              .field(pType)
+              .field(pLev)
+              .field(fAdr)
+              .field(lAdr);
+        writer.endRow();
     }
 };
 
+// һ˵ִķ¼ݴֻ·޸ĵļ
+struct TopLevelOutline 
+{
+    bool isStatement; // Ƿִ
+    bool isFunction; // Ƿ˵
+    std::string name; // еǼǵ֣ûеǼʱΪ
+    size_t firstToken; // һԪ±
+    size_t endToken; // ʱڵԪ±
+    size_t varBegin, varEnd; // ǼǵıڱеķΧ
+    size_t proBegin, proEnd; // ǼǵĹڹ̱еķΧ
+    size_t diagBegin, diagEnd; // ĴϢеķΧ
+    bool clean; // صĲΣķֻȡڽλúѵǼǵ
+};
+
+// begin֮￪ʼͷʱĳ˵䡢ִλýŷ
+enum class MainBlockEntry 
+{
+    START,
+    AFTER_DECLARATION,
+    AFTER_STATEMENT,
+};
+
+// ڷһ˵Ƕ׵ĺ˵ѹʽջǵݹ飬
+// ʱռõĵջǶ
+struct FunctionFrame 
+{
+    size_t proIndex; // ڹ̱е±꣬ݴ˻
+    size_t lAdr; // һλ
+    uint32_t token; // ڵԪ±
+    size_t parameter; // βڱеλ
+    size_t variableBegin; // ˵ݴӽе
+    size_t functionBegin;
+};
+
+// һδʽõʵڲʽʵʱѹջ
+struct ExpressionFrame 
+{
+    const Expression* difference; // һ֮ǰѽϺõĲ֣ûмʱΪnullptr
+    const Expression* product; // ǰѽϺõĲ
+    uint32_t minusToken; // difference֮ļ
+    uint32_t multiplyToken; // product֮ĳ˺
+    bool multiply; // product֮дϵĳ˺
+    uint32_t callToken; // һǺõʵʱڵԪ±
+    Symbol callee; // õĺ
+};
+
+// һѷthen֮ǰֵ
+struct OpenCondition 
+{
+    Statement* node; // 㣬﷨ʱΪnullptr
+    bool inElse; // ڷelse
+};
+
 // һ﷨
 class GrammarAnalyzer 
 {
 private:
-    std::vector<std::pair<std::string, std::string>> tokenList; //  ʷõĴʷԪб
-    size_t listCurrent; // ǰλ
-    size_t lineCurrent; // ǰ
-    size_t tokenListLength; // бȣжǷԽ
-    std::string errorFile; // ļ·
+    TokenBuffer ownedTokens; // ӹܵĴʷԪⲿԪʱΪ
+    TokenReader reader; // ȡʷԪα
+    Diagnostics& diagnostics; // Ϣռ
     std::vector<VarUnit> varList; // б
     std::vector<ProUnit> proList; // б
     size_t currentLevel; // ǰǶײ㼶
+    SymbolTable symbolTable; // ֯ķűֲ
+    bool stopped; // ޷ĴΪtrue֮ķٱ
+    size_t varBase; // ±㣬мĳŷʱΪ0
+    size_t proBase; // ̱±
+    std::vector<TopLevelOutline>* outline; // Ϊnullptrʱ¼ÿ˵ִλúͲ
+    Arena* arena; // Ϊnullptrʱн﷨
+    const Program* program; // ﷨
+    std::vector<size_t> pendingVariables; // δ˵˵ı
+    std::vector<const FunctionDeclaration*> pendingFunctions; // δ˵˵ĺ
+    std::vector<const Statement*> pendingStatements; // δִѷ
+    std::vector<OpenCondition> openConditions; // ȴthenelse䣬ջڲ
+    std::vector<ExpressionFrame> openCalls; // ȴŵĺڵʽ
 
 public:
-    // 캯
-    GrammarAnalyzer(const std::vector<std::pair<std::string, std::string>>& tokenList, 
-        const std::string& errorFile)
-        :tokenList(tokenList)
-        ,tokenListLength(tokenList.size())
-        ,listCurrent(0)
-        ,lineCurrent(1)
-        ,errorFile(errorFile)
+    // 캯ⲿĵԪУӳڴĶƵԪļڼ뱣Ч
+    GrammarAnalyzer(const TokenView& tokens, 
+        Diagnostics& diagnostics)
+        :reader(tokens)
+        ,diagnostics(diagnostics)
+        ,currentLevel(0)
+        ,stopped(false)
+        ,varBase(0)
+        ,proBase(0)
+        ,outline(nullptr)
+        ,arena(nullptr)
+        ,program(nullptr)
+    {}
+
+    // 캯ֱӽӹܴʷõĵԪб
+    GrammarAnalyzer(TokenBuffer&& tokens,
+        Diagnostics& diagnostics)
+        :ownedTokens(std::move(tokens))
+        ,reader(ownedTokens.view())
+        ,diagnostics(diagnostics)
         ,currentLevel(0)
+        ,stopped(false)
+        ,varBase(0)
+        ,proBase(0)
+        ,outline(nullptr)
+        ,arena(nullptr)
+        ,program(nullptr)
     {}
 
-    // ƽķ
+    // 캯߷ߴӻζжȡһ̲߳ĵԪֻеǰһ
+    GrammarAnalyzer(TokenRing& ring,
+        Diagnostics& diagnostics)
+        :reader(ring)
+        ,diagnostics(diagnostics)
+        ,currentLevel(0)
+        ,stopped(false)
+        ,varBase(0)
+        ,proBase(0)
+        ,outline(nullptr)
+        ,arena(nullptr)
+        ,program(nullptr)
+    {}
+
+    // ǰoffsetԪֱԽʱΪļ
+    TokenKind peekKind(size_t offset) const
+    {
+        return reader.kind(offset);
+    }
+
+    // ƽķвڵԪУкɵԪԴ
     void advance()
     {
-        if (listCurrent < tokenListLength) 
-        {
-            /*std::cout << tokenList[listCurrent].first << std::endl;*/
-            ++listCurrent;
-            if (tokenList[listCurrent].first == "EOLN")
-            { // 
-                ++listCurrent;
-                ++lineCurrent;
-            }
-            // 
-            /*std::cout << "listCurrent: " << listCurrent
-                << ", Token: " << tokenList[listCurrent].first
-                << ", lineCurrent: " << lineCurrent << std::endl;*/
-        }
+        reader.step();
     }
 
-    // ķ
-    void error(const std::string& errorCode, const std::string& symbol)
+    // ķ¼ϢռУ﷨ͳһ
+    void error(ErrorType type, const std::string& symbol)
     {
-        std::ofstream errFile(errorFile, std::ios::app);
-        if (!errFile.is_open())
-        {
-            std::cerr << "Unable to open error file." << std::endl;
-            return;
-        }
+        if (stopped) return;
+        diagnostics.report(type, reader.line(), reader.column(), symbol);
+    }
 
-        if (errorCode == "symbol_not_found")
-        {
-            errFile << "***" << lineCurrent << ": " << symbol << " not found." << "\n";
-        }
-        else if (errorCode == "symbol_not_match")
-        {
-            errFile << "***" << lineCurrent << ": " << symbol << " not matched." << "\n";
-        }
-        else if (errorCode == "symbol_not_defined")
-        {
-            errFile << "***" << lineCurrent << ": " << symbol << " not defined." << "\n";
-        }
-        errFile.close();
+    // ޷ʱãֱһԪøȻأ
+    // ˳̣ͨisStopped()ֹ֪
+    void stop(ErrorType type, const std::string& symbol)
+    {
+        error(type, symbol);
+        stopped = true;
+        reader.skipToEnd();
+    }
+
+    // мŷparseMainBlock͹̱±ֱvarBaseproBaseţ
+    // namesСnameCountǴǰеǼǵ
+    void resume(size_t varBase, size_t proBase,
+        const SymbolTable::OrderedNames* names, size_t nameCount)
+    {
+        this->varBase = varBase;
+        this->proBase = proBase;
+        symbolTable.inherit(names, nameCount);
+    }
+
+    // ¼ÿ˵ִλúͲ
+    void setOutline(std::vector<TopLevelOutline>* outline)
+    {
+        this->outline = outline;
+    }
+
+    // arenaн﷨getProgram()ȡãarena
+    void setArena(Arena* arena)
+    {
+        this->arena = arena;
+    }
+
+    // ﷨ûеsetArenabeginʼʱΪnullptr
+    const Program* getProgram() const
+    {
+        return program;
+    }
+
+    // ǷĲ
+    bool atTopLevel() const
+    {
+        return currentLevel == 0 && symbolTable.depth() == 1;
+    }
+
+    // ǰԪ±
+    size_t position() const
+    {
+        return reader.index();
+    }
+
+    // ǰԪڵ
+    size_t currentLine() const
+    {
+        return reader.line();
+    }
+
+    // Ƿֹ
+    bool isStopped() const
+    {
+        return stopped;
+    }
+
+    const std::vector<VarUnit>& getVarList() const
+    {
+        return varList;
+    }
+
+    const std::vector<ProUnit>& getProList() const
+    {
+        return proList;
     }
 
     // 
     void parseProgram()
     {
+        if (reader.empty())
+        {
+            error(ErrorType::SYMBOL_NOT_FOUND, "begin");
+            return;
+        }
         parseSubProgram();
+        // ȡʣĵԪӻζжȡʱʷ̲߳ܽ
+        reader.skipToEnd();
     }
 
     // ֳ
     void parseSubProgram()
     {
-        if (tokenList[listCurrent].first == "begin") 
+        if (reader.kind() == TokenKind::BEGIN) 
         {
-            /*std::cout << listCurrent << std::endl;*/
             advance();
-            size_t lAdr = 0;
-            parseDeclarationList(lAdr); // ˵
-            if (tokenList[listCurrent].first == ";") 
+            parseMainBlock(MainBlockEntry::START);
+        }
+        else
+        {
+            error(ErrorType::SYMBOL_NOT_FOUND, "begin");
+        }
+    }
+
+    // begin֮˵ִendʱentrySTART
+    // ǰԪǴǰһ˵ִʱڵĵԪŷ
+    void parseMainBlock(MainBlockEntry entry)
+    {
+        size_t lAdr = 0;
+        size_t variableBegin = pendingVariables.size();
+        size_t functionBegin = pendingFunctions.size();
+        size_t statementBegin = pendingStatements.size();
+        if (entry != MainBlockEntry::AFTER_STATEMENT)
+        {
+            parseDeclarationList(lAdr, entry == MainBlockEntry::AFTER_DECLARATION); // ˵
+            if (reader.kind() == TokenKind::SEMICOLON) 
             {
                 advance();
-                parseExecutionStatementList(); // ִ
-                if (tokenList[listCurrent].first == "end") 
+                parseExecutionStatementList(false); // ִ
+                if (reader.kind() == TokenKind::END) 
                 {
                     advance();
                 }
             }
             else 
             {
-                error("symbol_not_found", ";");
+                error(ErrorType::SYMBOL_NOT_FOUND, ";");
             }
         }
         else
         {
-            error("symbol_not_found", "begin");
+            parseExecutionStatementList(true);
+            if (reader.kind() == TokenKind::END) 
+            {
+                advance();
+            }
+        }
+        if (arena != nullptr)
+        {
+            program = arena->create(Program{ makeBlock(variableBegin, functionBegin, statementBegin), false });
         }
     }
 
     // ˵
-    void parseDeclarationList(size_t& lAdr) 
+    void parseDeclarationList(size_t& lAdr, bool afterDeclaration) 
     {
-        parseDeclaration(lAdr);
-        parseDeclarationListPrime(lAdr);
+        // <˵><˵><˵><˵>
+        parseDeclarations(lAdr, afterDeclaration);
     }
 
-    // ݹ
-    void parseDeclarationListPrime(size_t& lAdr) 
+    // ˵ķʱݹ飬ǰѺѹframes
+    // ŷе˵䣻ջ˵ٷִջ
+    // afterDeclarationΪtrueʱǰԪǰһ˵ʱڵĵԪȿǷ˵
+    void parseDeclarations(size_t& lAdr, bool afterDeclaration) 
     {
-        if ((listCurrent + 1 < tokenListLength && tokenList[listCurrent + 1].first == "integer") ||
-            (listCurrent + 2 < tokenListLength && tokenList[listCurrent + 1].first == "EOLN" && 
-                tokenList[listCurrent + 2].first == "integer")) 
+        std::vector<FunctionFrame> frames; // ڷĺ˵ջڲ
+        bool recording = false; // Ƿڼ¼ǰ˵
+        if (afterDeclaration)
         {
+            if (!continuesDeclarationList()) return;
             advance(); // һֺ
-            parseDeclaration(lAdr);
-            parseDeclarationListPrime(lAdr);
         }
+        for (;;)
+        {
+            if (frames.empty())
+            {
+                recording = beginOutline(false);
+            }
+            FunctionFrame frame;
+            if (parseDeclarationHead(frames.empty() ? lAdr : frames.back().lAdr, frame))
+            {
+                // 뺯壬ŷĵһ˵
+                frames.push_back(frame);
+                continue;
+            }
+            // һ˵˵ʱ꣬
+            // ˵һ˵Ľ
+            for (;;)
+            {
+                if (frames.empty())
+                {
+                    if (recording)
+                    {
+                        endOutline();
+                        recording = false;
+                    }
+                }
+                if (continuesDeclarationList())
+                {
+                    advance(); // һֺ
+                    break;
+                }
+                if (frames.empty()) return;
+                finishFunctionBody(frames.back());
+                frames.pop_back();
+            }
+        }
+    }
+
+    // ˵֮Ƿ˵䣺ֺ֮integer
+    bool continuesDeclarationList() const
+    {
+        return peekKind(1) == TokenKind::INTEGER;
     }
 
-    // ˵
-    void parseDeclaration(size_t& lAdr) 
+    // ʼ¼һ˵ִ䣬Ҫ¼ʱfalse
+    bool beginOutline(bool isStatement)
     {
-        if (tokenList[listCurrent].second == "03")
+        if (outline == nullptr || stopped || !atTopLevel()) return false;
+        TopLevelOutline entry;
+        entry.isStatement = isStatement;
+        entry.isFunction = false;
+        entry.clean = false;
+        entry.firstToken = reader.index();
+        entry.varBegin = varList.size();
+        entry.proBegin = proList.size();
+        entry.diagBegin = diagnostics.count();
+        outline->push_back(entry);
+        return true;
+    }
+
+    // ¼ǰ˵ִ
+    void endOutline()
+    {
+        TopLevelOutline& entry = outline->back();
+        entry.endToken = reader.index();
+        entry.varEnd = varList.size();
+        entry.proEnd = proList.size();
+        entry.diagEnd = diagnostics.count();
+        entry.clean = !stopped && atTopLevel();
+        // ں֮ǰǼǣĵһ̣˵ֻǼһ
+        if (entry.proEnd > entry.proBegin)
+        {
+            entry.isFunction = true;
+            entry.name = proList[entry.proBegin].pName;
+        }
+        else if (entry.varEnd > entry.varBegin)
+        {
+            entry.name = varList[entry.varBegin].vName;
+        }
+    }
+
+    // ˵䣬ֱbeginΪֹ˺ʱframetrue
+    bool parseDeclarationHead(size_t& lAdr, FunctionFrame& frame) 
+    {
+        if (reader.kind() == TokenKind::INTEGER)
         {
             // <˵><˵><˵>
-            if (tokenList[listCurrent + 1].second == "10" ||
-                (tokenList[listCurrent + 1].first == "EOLN" && tokenList[listCurrent + 2].second == "10"))
-            { // ˵
-                parseVariableDeclaration(lAdr);
-            }
-            else if (tokenList[listCurrent + 1].first == "function" ||
-                (tokenList[listCurrent + 1].first == "EOLN" && tokenList[listCurrent + 2].first == "function"))
-            { // ˵
-                parseFunctionDeclaration();
-            }
-            else
+            switch (peekKind(1))
             {
-                error("symbol_not_found", "variable or function");
+            case TokenKind::IDENTIFIER: // ˵
+                parseVariableDeclaration(lAdr);
+                break;
+            case TokenKind::FUNCTION: // ˵
+                return parseFunctionHead(frame);
+            default:
+                error(ErrorType::SYMBOL_NOT_FOUND, "variable or function");
+                break;
             }
         }
         else
         {
-            error("symbol_not_found", "variable or function");
+            error(ErrorType::SYMBOL_NOT_FOUND, "variable or function");
         }
-        
+        return false;
     }
 
     // ˵
     void parseVariableDeclaration(size_t& lAdr) 
     {
         // <˵>integer <>
-        if (tokenList[listCurrent].first == "integer") 
+        if (reader.kind() == TokenKind::INTEGER) 
         {
             advance();
             // ǼǱ
             // ݵǰĹ̺͵ȼµıԪ
-            std::string vName = tokenList[listCurrent].first;
-            std::string vProc = "main";
-            if (!proList.empty())
-            {
-                vProc = currentLevel > 0 ? proList.back().pName : "main";
-            }
+            std::string vName = reader.lexeme();
+            std::string vProc = symbolTable.currentOwner();
             size_t vKind = 0; // , 0ʾ
             std::string vType = "integer"; // 
             size_t vLev = currentLevel; // Ĳ㼶
-            size_t vAdr = varList.size(); // беĵַ
+            size_t vAdr = varBase + varList.size(); // беĵַ
             lAdr = vAdr; // µǰһλ
            
             varList.push_back(VarUnit(vName, vProc, vKind, vType, vLev, vAdr));
+            symbolTable.define(vName, Symbol{ false, vAdr });
+            if (arena != nullptr)
+            {
+                pendingVariables.push_back(vAdr);
+            }
             advance();
-            if (tokenList[listCurrent].second != "23")
+            if (reader.kind() != TokenKind::SEMICOLON)
             {
-                error("symbol_not_found", "variable or function");
-                exit(-1);
+                stop(ErrorType::SYMBOL_NOT_FOUND, "variable or function");
             }
         }
     }
 
-    // ˵
-    void parseFunctionDeclaration() 
+    // ˵ĺͷͺ忪ͷbegin˺ʱframetrue
+    // ಿparseDeclarationsŷ
+    bool parseFunctionHead(FunctionFrame& frame) 
     {
         // <˵>integer function <ʶ><><>
         std::string pName; // 
         std::string pType; // 
         size_t pLev; // ̲
         size_t fAdr = 0; // һڱеλ
-        size_t lAdr = 0; // һڱеλ
 
-        if (tokenList[listCurrent].first == "integer") 
+        if (reader.kind() == TokenKind::INTEGER) 
         {
-            pType = tokenList[listCurrent].first;
+            pType = reader.lexeme();
             advance();
-            if (tokenList[listCurrent].first == "function") 
+            if (reader.kind() == TokenKind::FUNCTION) 
             {
                 advance();
-                if (tokenList[listCurrent].second == "10") 
+                if (reader.kind() == TokenKind::IDENTIFIER) 
                 {
-                    pName = tokenList[listCurrent].first;
+                    pName = reader.lexeme();
+                    uint32_t nameToken = tokenIndex();
                     advance();
-                    if (tokenList[listCurrent].first == "(") 
+                    if (reader.kind() == TokenKind::OPEN_PAREN) 
                     {
                         advance();
                         currentLevel++;
+                        symbolTable.enterScope(pName);
                         pLev = currentLevel;
                         parseParameter(pName, fAdr); // 
-                        if (tokenList[listCurrent].first == ")") 
+                        if (reader.kind() == TokenKind::CLOSE_PAREN) 
                         {
                             advance();
-                            if (tokenList[listCurrent].first == ";") 
+                            if (reader.kind() == TokenKind::SEMICOLON) 
                             {
                                 advance();
                                 // ǼǹϢ
+                                size_t proIndex = proList.size();
                                 proList.push_back(ProUnit(pName, pType, pLev, fAdr, 0));
-                                parseFunctionBody(lAdr); // 
-                                // ¹Ϣ
-                                proList.back().lAdr = lAdr;
-                                currentLevel--;
+                                symbolTable.defineInEnclosing(pName, Symbol{ true, proBase + proIndex });
+                                frame.proIndex = proIndex;
+                                frame.lAdr = 0;
+                                frame.token = nameToken;
+                                frame.parameter = fAdr;
+                                frame.variableBegin = pendingVariables.size();
+                                frame.functionBegin = pendingFunctions.size();
+                                // <>begin <˵><ִ> end
+                                if (reader.kind() == TokenKind::BEGIN) 
+                                {
+                                    advance();
+                                    return true;
+                                }
+                                error(ErrorType::SYMBOL_NOT_FOUND, "begin");
+                                endFunction(frame, nullptr);
                             }
                             else 
                             {
-                                error("symbol_not_found", ";");
+                                error(ErrorType::SYMBOL_NOT_FOUND, ";");
                             }
                         }
                         else 
                         {
-                            error("symbol_not_found", ")");
+                            error(ErrorType::SYMBOL_NOT_FOUND, ")");
                         }
                     }
                     else 
                     {
-                        error("symbol_not_found", "(");
+                        error(ErrorType::SYMBOL_NOT_FOUND, "(");
                     }
                 }
                 else 
                 {
-                    error("symbol_not_defined", "functionName");
+                    error(ErrorType::SYMBOL_NOT_DEFINED, "functionName");
                 }
             }
             else 
             {
-                error("symbol_not_found", "function");
+                error(ErrorType::SYMBOL_NOT_FOUND, "function");
             }
         }
+        return false;
     }
 
     // 
     void parseParameter(const std::string& pName, size_t& fAdr) 
     {
         // <><>
-        std::string vName = tokenList[listCurrent].first;
+        std::string vName = reader.lexeme();
         std::string vProc = pName;
         size_t vKind = 1; // β
         std::string vType = "integer";
         size_t vLev = currentLevel;
-        size_t vAdr = varList.size();
+        size_t vAdr = varBase + varList.size();
         fAdr = vAdr;
         varList.push_back(VarUnit(vName, vProc, vKind, vType, vLev, vAdr));
+        symbolTable.define(vName, Symbol{ false, vAdr });
         advance();
     }
 
-    // 
-    void parseFunctionBody(size_t& lAdr) 
+    // ˵󣬷ಿֲ˵
+    void finishFunctionBody(const FunctionFrame& frame) 
     {
-        // <>begin <˵><ִ> end
-        if (tokenList[listCurrent].first == "begin") 
+        size_t statementBegin = pendingStatements.size();
+        if (reader.kind() == TokenKind::SEMICOLON) 
         {
             advance();
-            parseDeclarationList(lAdr);
-            if (tokenList[listCurrent].first == ";") 
+            parseExecutionStatementList(false);
+            if (reader.kind() == TokenKind::END) 
             {
                 advance();
-                parseExecutionStatementList();
-                if (tokenList[listCurrent].first == "end") 
-                {
-                    advance();
-                }
-                else 
-                {
-                    error("symbol_not_found", "end");
-                }
             }
             else 
             {
-                error("symbol_not_found", ";");
+                error(ErrorType::SYMBOL_NOT_FOUND, "end");
             }
         }
         else 
         {
-            error("symbol_not_found", "begin");
+            error(ErrorType::SYMBOL_NOT_FOUND, ";");
         }
+        endFunction(frame, makeBlock(frame.variableBegin, frame.functionBegin, statementBegin));
     }
 
-    // ִ
-    void parseExecutionStatementList() 
+    // һ˵Ϣص㣬Ѻ˵˵
+    void endFunction(const FunctionFrame& frame, const Block* body) 
     {
-        // <ִ><ִ><ִ><ִ>
-        parseExecutionStatement();
-        parseExecutionStatementListPrime();
+        // пܵǼǶ׵Ḷ́±
+        proList[frame.proIndex].lAdr = frame.lAdr;
+        currentLevel--;
+        symbolTable.leaveScope();
+        if (arena != nullptr)
+        {
+            FunctionDeclaration node = { frame.token, proBase + frame.proIndex, frame.parameter, body };
+            pendingFunctions.push_back(arena->create(node));
+        }
     }
 
-    // ݹ
-    void parseExecutionStatementListPrime() 
+    // ѴӸ㿪ʼݴӽ㸴Ƴ飬һֳ򣬲ݴƳ
+    const Block* makeBlock(size_t variableBegin, size_t functionBegin, size_t statementBegin) 
     {
-        // Ƿзֺżִ
-        if (tokenList[listCurrent].first == ";") 
-        {
-            advance(); // advance
-            parseExecutionStatement();
-            parseExecutionStatementListPrime();
-        }
+        if (arena == nullptr) return nullptr;
+        Block block;
+        block.variableCount = pendingVariables.size() - variableBegin;
+        block.variables = arena->createArray(pendingVariables.data() + variableBegin, block.variableCount);
+        block.functionCount = pendingFunctions.size() - functionBegin;
+        block.functions = arena->createArray(pendingFunctions.data() + functionBegin, block.functionCount);
+        block.statementCount = pendingStatements.size() - statementBegin;
+        block.statements = arena->createArray(pendingStatements.data() + statementBegin, block.statementCount);
+        pendingVariables.resize(variableBegin);
+        pendingFunctions.resize(functionBegin);
+        pendingStatements.resize(statementBegin);
+        return arena->create(block);
     }
 
-    // ִ
-    void parseExecutionStatement() 
+    // ִafterStatementΪtrueʱǰԪǰһִʱڵĵԪ
+    void parseExecutionStatementList(bool afterStatement) 
     {
-        // <ִ><><д><ֵ><>
-        if (tokenList[listCurrent].first == "read") 
+        // <ִ><ִ><ִ><ִ>ѭ
+        if (!afterStatement)
         {
-            advance();
-            parseReadStatement();
+            parseTopLevelStatement();
         }
-        else if (tokenList[listCurrent].first == "write") 
+        while (reader.kind() == TokenKind::SEMICOLON) 
         {
             advance();
-            parseWriteStatement();
+            parseTopLevelStatement();
         }
-        else if (tokenList[listCurrent].second == "10") 
+    }
+
+    // ִеһ䣬ʱ¼λ
+    void parseTopLevelStatement()
+    {
+        bool recording = beginOutline(true);
+        addStatement(parseExecutionStatement());
+        if (recording)
         {
-            // ıͨΪֵ
-            parseAssignmentStatement();
+            endOutline();
         }
-        else if (tokenList[listCurrent].first == "if") 
+    }
+
+    // һ뵱ǰִ
+    void addStatement(const Statement* statement)
+    {
+        if (arena != nullptr && statement != nullptr)
         {
-            parseConditionStatement();
+            pendingStatements.push_back(statement);
         }
-        else
+    }
+
+    // ִ䣬㣬򲻽﷨ʱnullptr
+    const Statement* parseExecutionStatement() 
+    {
+        // Ƕ׵䲻ݹ飺then֮ǰĲ־ͰѹopenConditionsŷthen䣬
+        // һλص䣬else
+        size_t base = openConditions.size();
+        for (;;)
         {
-            error("symbol_not_match", "execution statement");
+            // <ִ><><д><ֵ><>
+            const Statement* statement = nullptr;
+            Statement node = newStatement();
+            switch (reader.kind())
+            {
+            case TokenKind::READ:
+                node.kind = StatementKind::READ;
+                advance();
+                parseReadStatement(node);
+                statement = createStatement(node);
+                break;
+            case TokenKind::WRITE:
+                node.kind = StatementKind::WRITE;
+                advance();
+                parseWriteStatement(node);
+                statement = createStatement(node);
+                break;
+            case TokenKind::IDENTIFIER:
+                // ıͨΪֵ
+                node.kind = StatementKind::ASSIGN;
+                parseAssignmentStatement(node);
+                statement = createStatement(node);
+                break;
+            case TokenKind::IF:
+                node.kind = StatementKind::IF;
+                if (parseConditionHead(node.condition))
+                {
+                    openConditions.push_back(OpenCondition{ createStatement(node), false });
+                    continue;
+                }
+                statement = createStatement(node);
+                break;
+            default:
+                error(ErrorType::SYMBOL_NOT_MATCH, "execution statement");
+                break;
+            }
+            // һصȴ
+            bool hasElse = false;
+            while (openConditions.size() > base && !hasElse)
+            {
+                OpenCondition& open = openConditions.back();
+                if (open.node != nullptr)
+                {
+                    if (open.inElse)
+                    {
+                        open.node->elseBranch = statement;
+                    }
+                    else
+                    {
+                        open.node->thenBranch = statement;
+                    }
+                }
+                if (!open.inElse && reader.kind() == TokenKind::ELSE) 
+                {
+                    advance();
+                    open.inElse = true;
+                    hasElse = true;
+                }
+                else
+                {
+                    // 䵽˽ȴ
+                    statement = open.node;
+                    openConditions.pop_back();
+                }
+            }
+            if (!hasElse) return statement;
         }
     }
 
+    // һδ䣬ӵǰԪʼ
+    Statement newStatement() const
+    {
+        Statement node;
+        node.kind = StatementKind::READ;
+        node.token = tokenIndex();
+        node.line = reader.line();
+        node.target = Symbol{ false, UNRESOLVED };
+        node.value = nullptr;
+        node.condition = nullptr;
+        node.thenBranch = nullptr;
+        node.elseBranch = nullptr;
+        return node;
+    }
+
+    // 㸴ƵУ﷨ʱnullptr
+    Statement* createStatement(const Statement& node)
+    {
+        return arena != nullptr ? arena->create(node) : nullptr;
+    }
+
+    // ǰԪ±꣬﷨
+    uint32_t tokenIndex() const
+    {
+        return static_cast<uint32_t>(reader.index());
+    }
+
+    // ڵǰɼв֣ҲʱindexΪUNRESOLVED
+    Symbol resolve(const std::string& name) const
+    {
+        const Symbol* symbol = symbolTable.lookup(name);
+        return symbol != nullptr ? *symbol : Symbol{ false, UNRESOLVED };
+    }
+
     // 
-    void parseReadStatement() 
+    void parseReadStatement(Statement& node) 
     {
         // 
-        if (tokenList[listCurrent].first == "(") 
+        if (reader.kind() == TokenKind::OPEN_PAREN) 
         {
             advance();
-            if (tokenList[listCurrent].second == "10") 
+            if (reader.kind() == TokenKind::IDENTIFIER) 
             {
+                if (arena != nullptr)
+                {
+                    node.target = resolve(reader.lexeme());
+                }
                 advance();
-                if (tokenList[listCurrent].first == ")") 
+                if (reader.kind() == TokenKind::CLOSE_PAREN) 
                 {
                     advance();
                 }
                 else 
                 {
-                    error("symbol_not_found", ")");
+                    error(ErrorType::SYMBOL_NOT_FOUND, ")");
                 }
             }
             else 
             {
-                error("symbol_not_found", "variable");
+                error(ErrorType::SYMBOL_NOT_FOUND, "variable");
             }
         }
         else 
         {
-            error("symbol_not_found", "(");
+            error(ErrorType::SYMBOL_NOT_FOUND, "(");
         }
     }
 
     // д
-    void parseWriteStatement() 
+    void parseWriteStatement(Statement& node) 
     {
         // д
-        if (tokenList[listCurrent].first == "(") 
+        if (reader.kind() == TokenKind::OPEN_PAREN) 
         {
             advance();
-            if (tokenList[listCurrent].second == "10") 
+            if (reader.kind() == TokenKind::IDENTIFIER) 
             {
+                if (arena != nullptr)
+                {
+                    node.target = resolve(reader.lexeme());
+                }
                 advance();
-                if (tokenList[listCurrent].first == ")") 
+                if (reader.kind() == TokenKind::CLOSE_PAREN) 
                 {
                     advance();
                 }
                 else 
                 {
-                    error("symbol_not_found", ")");
+                    error(ErrorType::SYMBOL_NOT_FOUND, ")");
                 }
             }
             else 
             {
-                error("symbol_not_found", "variable");
+                error(ErrorType::SYMBOL_NOT_FOUND, "variable");
             }
         }
         else 
         {
-            error("symbol_not_found", "(");
+            error(ErrorType::SYMBOL_NOT_FOUND, "(");
         }
     }
 
-    // ұزֵʾɹʧ
+    // ڵǰɼвұزֵʾɹʧ
     bool doesVarExist(const std::string& varName) 
     {
-        for (const auto& var : varList) 
-        {
-            if (var.vName == varName) 
-            {
-                return true; // ҵ˱
-            }
-        }
-        return false; // ûҵ
+        const Symbol* symbol = symbolTable.lookup(varName);
+        return symbol != nullptr && !symbol->isProcedure;
     }
 
-    // ҹزֵʾɹʧ
+    // ڵǰɼвҹ̣زֵʾɹʧ
     bool doesProExist(const std::string& proName) 
     {
-        for (const auto& pro : proList) 
-        {
-            if (pro.pName == proName) 
-            {
-                return true; // ҵ
-            }
-        }
-        return false; // ûҵ
+        const Symbol* symbol = symbolTable.lookup(proName);
+        return symbol != nullptr && symbol->isProcedure;
     }
 
     // ֵ
-    void parseAssignmentStatement() 
+    void parseAssignmentStatement(Statement& node) 
     {
         // ֵ䣬ʶʶ ':=' 
-        if (tokenList[listCurrent].second == "10") 
+        if (reader.kind() == TokenKind::IDENTIFIER) 
         {
-            if (!doesVarExist(tokenList[listCurrent].first)) 
+            if (!doesVarExist(reader.lexeme())) 
             { // 
-                if (!doesProExist(tokenList[listCurrent].first)) 
+                if (!doesProExist(reader.lexeme())) 
                 { // ڣҹҲ
-                    error("symbol_not_defined", "variable/process " + tokenList[listCurrent].first);
+                    error(ErrorType::SYMBOL_NOT_DEFINED, "variable/process " + reader.lexeme());
                 }
             }
+            if (arena != nullptr)
+            {
+                node.target = resolve(reader.lexeme());
+            }
            
             advance();
-            if (tokenList[listCurrent].first == ":=") 
+            if (reader.kind() == TokenKind::ASSIGN) 
             {
                 advance();
-                parseArithmeticExpression();
+                node.value = parseArithmeticExpression();
             }
             else 
             {
-                error("symbol_not_found", ":=");
+                error(ErrorType::SYMBOL_NOT_FOUND, ":=");
             }
         }
         else 
         {
-            error("symbol_not_found", "variable");
+            error(ErrorType::SYMBOL_NOT_FOUND, "variable");
         }
     }
 
-    // 
-    void parseConditionStatement() 
+    // ifthenɹthenʱtruethenɵ߷
+    bool parseConditionHead(const Condition*& condition) 
     {
-        // 
-        if (tokenList[listCurrent].first == "if") 
+        // <>if<ʽ>then<ִ>else <ִ>
+        if (reader.kind() == TokenKind::IF) 
         {
             advance();
-            parseConditionExpression();
-            if (tokenList[listCurrent].first == "then") 
+            condition = parseConditionExpression();
+            if (reader.kind() == TokenKind::THEN) 
             {
                 advance();
-                parseExecutionStatement();
-                if (tokenList[listCurrent].first == "else") 
-                {
-                    advance();
-                    parseExecutionStatement();
-                }
-            }
-            else 
-            {
-                error("symbol_not_found", "then");
+                return true;
             }
+            error(ErrorType::SYMBOL_NOT_FOUND, "then");
         }
         else 
         {
-            error("symbol_not_found", "if");
+            error(ErrorType::SYMBOL_NOT_FOUND, "if");
         }
+        return false;
     }
 
     // ʽ
-    void parseConditionExpression() 
+    const Condition* parseConditionExpression() 
     {
         // <ʽ><ʽ><ϵ><ʽ>
-        parseArithmeticExpression();
-        std::unordered_set<std::string> relationOpSet = {"<", "<=", ">", ">=", "=", "<>"};
-        if (relationOpSet.find(tokenList[listCurrent].first) != relationOpSet.end()) 
+        Condition node;
+        node.relation = RelationKind::NONE;
+        node.left = parseArithmeticExpression();
+        node.token = tokenIndex();
+        node.right = nullptr;
+        switch (reader.kind())
         {
-            advance();
-            parseArithmeticExpression();
+        case TokenKind::LESS:
+            node.relation = RelationKind::LESS;
+            break;
+        case TokenKind::LESS_OR_EQUALS:
+            node.relation = RelationKind::LESS_OR_EQUALS;
+            break;
+        case TokenKind::GREATER:
+            node.relation = RelationKind::GREATER;
+            break;
+        case TokenKind::GREATER_OR_EQUALS:
+            node.relation = RelationKind::GREATER_OR_EQUALS;
+            break;
+        case TokenKind::EQUALS:
+            node.relation = RelationKind::EQUALS;
+            break;
+        case TokenKind::NOT_EQUALS:
+            node.relation = RelationKind::NOT_EQUALS;
+            break;
+        default:
+            error(ErrorType::SYMBOL_NOT_FOUND, "relational operator");
+            break;
         }
-        else 
+        if (node.relation != RelationKind::NONE)
         {
-            error("symbol_not_found", "relational operator");
+            advance();
+            node.right = parseArithmeticExpression();
         }
+        return arena != nullptr ? arena->create(node) : nullptr;
     }
 
-    // ʽ
-    void parseArithmeticExpression() 
+    // ʽرʽ㣬﷨ʱnullptr
+    const Expression* parseArithmeticExpression() 
     {
         // <ʽ><ʽ>-<>|<>
-        parseTerm();
-        parseArithmeticExpressionPrime();
-    }
-
-    // ݹ
-    void parseArithmeticExpressionPrime() 
-    {
-        if (tokenList[listCurrent].first == "-") 
+        // <><>*<>|<>
+        // <><>|<>|<>
+        // ݹ鶼дΪѭÿ֮*-ͽŷһӣ
+        // *뵱ǰϣ-ѵǰϵеĲ֣߶ϡ
+        // õʵҲʽͬݹ飬ʽѹopenCalls
+        size_t base = openCalls.size();
+        ExpressionFrame frame = newExpressionFrame();
+        for (;;)
         {
-            advance();
-            parseTerm();
-            parseArithmeticExpressionPrime();
+            // 
+            const Expression* factor = nullptr;
+            switch (reader.kind())
+            {
+            case TokenKind::IDENTIFIER:
+                // 
+                if (peekKind(1) == TokenKind::OPEN_PAREN) 
+                {
+                    // ã뺯źʵ
+                    openCalls.push_back(frame);
+                    frame = newExpressionFrame();
+                    frame.callToken = tokenIndex();
+                    if (arena != nullptr)
+                    {
+                        frame.callee = resolve(reader.lexeme());
+                    }
+                    advance();
+                    advance();
+                    continue;
+                }
+                // 
+                factor = createFactor(ExpressionKind::VARIABLE);
+                advance();
+                break;
+            case TokenKind::CONSTANT:
+                // 
+                factor = createFactor(ExpressionKind::CONSTANT);
+                advance();
+                break;
+            default:
+                factor = createFactor(ExpressionKind::EMPTY);
+                break;
+            }
+            // ֮ʱڲĺûʽ
+            for (;;)
+            {
+                appendFactor(frame, factor);
+                if (reader.kind() == TokenKind::MULTIPLY) 
+                {
+                    frame.multiply = true;
+                    frame.multiplyToken = tokenIndex();
+                    advance();
+                    break;
+                }
+                if (reader.kind() == TokenKind::MINUS) 
+                {
+                    frame.difference = finishExpression(frame);
+                    frame.product = nullptr;
+                    frame.minusToken = tokenIndex();
+                    advance();
+                    break;
+                }
+                if (openCalls.size() == base) return finishExpression(frame);
+                // ʵνΪʽһ
+                factor = nullptr;
+                if (arena != nullptr)
+                {
+                    Expression call = newExpression(ExpressionKind::CALL, frame.callToken);
+                    call.symbol = frame.callee;
+                    call.left = finishExpression(frame);
+                    factor = arena->create(call);
+                }
+                frame = openCalls.back();
+                openCalls.pop_back();
+                if (reader.kind() == TokenKind::CLOSE_PAREN) 
+                {
+                    advance();
+                }
+                else 
+                {
+                    error(ErrorType::SYMBOL_NOT_FOUND, ")");
+                }
+            }
         }
-        // else մκβ
     }
 
-    // 
-    void parseTerm() 
+    // һտʼʽ
+    static ExpressionFrame newExpressionFrame()
     {
-        // <><>*<>|<>
-        parseFactor();
-        parseTermPrime();
+        ExpressionFrame frame;
+        frame.difference = nullptr;
+        frame.product = nullptr;
+        frame.minusToken = 0;
+        frame.multiplyToken = 0;
+        frame.multiply = false;
+        frame.callToken = 0;
+        frame.callee = Symbol{ false, UNRESOLVED };
+        return frame;
     }
 
-    // ݹ
-    void parseTermPrime() 
+    // һӽϵǰ
+    void appendFactor(ExpressionFrame& frame, const Expression* factor)
     {
-        if (tokenList[listCurrent].first == "*") 
+        if (frame.multiply && arena != nullptr)
         {
-            advance();
-            parseFactor();
-            parseTermPrime();
+            Expression node = newExpression(ExpressionKind::MULTIPLY, frame.multiplyToken);
+            node.left = frame.product;
+            node.right = factor;
+            factor = arena->create(node);
         }
-        // else մκβ
+        frame.product = factor;
+        frame.multiply = false;
     }
 
-    // 
-    void parseFactor() 
+    // ѵǰϵеĲ֣õһ㵽ĿǰΪֹʽ
+    const Expression* finishExpression(const ExpressionFrame& frame)
     {
-        // <><>|<>|<>
-        if (tokenList[listCurrent].second == "10") 
-        {
-            // 
-            if (listCurrent + 1 < tokenList.size() && tokenList[listCurrent + 1].first == "(") 
-            {
-                // 
-                advance();
-                parseFunctionCall();
-            }
-            else 
-            {
-                // 
-                advance();
-            }
-        }
-        else if (tokenList[listCurrent].second == "11") 
-        {
-            // 
-            advance();
-        }
+        if (frame.difference == nullptr || arena == nullptr) return frame.product;
+        Expression node = newExpression(ExpressionKind::SUBTRACT, frame.minusToken);
+        node.left = frame.difference;
+        node.right = frame.product;
+        return arena->create(node);
+    }
+
+    // һʽ㣬ֶΪ
+    static Expression newExpression(ExpressionKind kind, uint32_t token)
+    {
+        Expression node;
+        node.kind = kind;
+        node.token = token;
+        node.value = 0;
+        node.symbol = Symbol{ false, UNRESOLVED };
+        node.left = nullptr;
+        node.right = nullptr;
+        return node;
     }
 
-    // 
-    void parseFunctionCall() 
+    // ΪǰԪӽ㣺ҷţֵΧʱ64λƣ﷨ʱnullptr
+    const Expression* createFactor(ExpressionKind kind)
     {
-        // 
-        if (tokenList[listCurrent].first == "(") 
+        if (arena == nullptr) return nullptr;
+        Expression node = newExpression(kind, tokenIndex());
+        if (kind == ExpressionKind::VARIABLE)
         {
-            advance();
-            parseArithmeticExpression();
-            if (tokenList[listCurrent].first == ")") 
-            {
-                advance();
-            }
-            else 
-            {
-                error("symbol_not_found", ")");
-            }
+            node.symbol = resolve(reader.lexeme());
         }
-        else 
+        else if (kind == ExpressionKind::CONSTANT)
         {
-            error("symbol_not_found", "(");
+            unsigned long long value = 0;
+            std::string digits = reader.lexeme();
+            for (char c : digits)
+            {
+                value = value * 10 + static_cast<unsigned>(c - '0');
+            }
+            node.value = static_cast<long long>(value);
         }
+        return arena->create(node);
     }
 
     // ļ
     void printFiles(const std::string& varPath, const std::string& proPath) 
     {
+        // ÿļֻһΣϴеĽ
+        TableWriter varWriter(varPath);
         for (const auto& var : varList) 
         {
-            var.printer(varPath);
+            var.printer(varWriter);
         }
+        TableWriter proWriter(proPath);
         for (const auto& proc : proList) 
         {
-            proc.printer(proPath);
+            proc.printer(proWriter);
         }
     }
 };
@@ -0,0 +1,908 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include "jit_compiler.h"
+
+#if defined(__x86_64__) && defined(__linux__)
+#define JIT_NATIVE 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef JIT_NATIVE
+
+// x86-64ͨüĴı
+enum Register
+{
+    RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15,
+};
+
+// ɵĴмĴ;
+// RBX ǰ֡㣬R12 ֡㣬R13 ĴĩβR14 ǰòR15 ĵòRBP ô
+// Ƕɱ߱棬öдʱ档Ĵݴ֡еֵ
+static const Register CACHE_REGISTERS[] = { RAX, RCX, RDX, RSI, RDI, R8, R9, R10, R11 };
+static const size_t CACHE_REGISTER_COUNT = sizeof(CACHE_REGISTERS) / sizeof(CACHE_REGISTERS[0]);
+
+// ÿڱջռõֽڣصַͱRBX
+static const size_t NATIVE_BYTES_PER_CALL = 16;
+// дԼC++ڱջϿõĿռ
+static const size_t NATIVE_STACK_RESERVE = 1 << 20;
+
+// 䣬ûжʱ0
+static int jitRead(JitContext* context, long long* slot)
+{
+    long long value = 0;
+    if (!(*context->input >> value))
+    {
+        return 0;
+    }
+    *slot = value;
+    return 1;
+}
+
+// д
+static void jitWrite(JitContext* context, long long value)
+{
+    *context->output << value << '\n';
+}
+
+// ҴõĽҵʱдslot1
+static int jitMemoFind(MemoTable* table, uint32_t procedure, long long argument, long long* slot)
+{
+    return table->find(procedure, argument, *slot) ? 1 : 0;
+}
+
+static void jitMemoStore(MemoTable* table, uint32_t procedure, long long argument, long long value)
+{
+    table->insert(procedure, argument, value);
+}
+
+// 򵥵x86-64ֻֽõָתĿñűʾȫɺ
+class Assembler
+{
+private:
+    std::vector<unsigned char> bytes;
+    std::vector<size_t> labels; // ŵλãÿfinish֮ǰҪ
+    std::vector<std::pair<size_t, size_t>> fixups; // 32λԵַı
+
+    void byte(unsigned value)
+    {
+        bytes.push_back(static_cast<unsigned char>(value));
+    }
+
+    void dword(uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            byte((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void qword(uint64_t value)
+    {
+        dword(static_cast<uint32_t>(value));
+        dword(static_cast<uint32_t>(value >> 32));
+    }
+
+    // REXǰ׺wideʾ64λ
+    void rex(int reg, int rm, bool wide)
+    {
+        unsigned value = 0x40 | (wide ? 0x08 : 0) | ((reg >> 3) << 2) | (rm >> 3);
+        if (value != 0x40)
+        {
+            byte(value);
+        }
+    }
+
+    // 0xFFĲʾ0x0Fͷֽڲ
+    void opcode(unsigned op)
+    {
+        if (op > 0xFF)
+        {
+            byte(op >> 8);
+        }
+        byte(op & 0xFF);
+    }
+
+    void rel32(size_t label)
+    {
+        fixups.push_back(std::make_pair(bytes.size(), label));
+        dword(0);
+    }
+
+public:
+    explicit Assembler(size_t labelCount)
+        :labels(labelCount, 0)
+    {}
+
+    // op reg, rmǼĴ
+    void registers(unsigned op, int reg, int rm)
+    {
+        rex(reg, rm, true);
+        opcode(op);
+        byte(0xC0 | ((reg & 7) << 3) | (rm & 7));
+    }
+
+    // op reg, [base + displacement]
+    void memory(unsigned op, int reg, int base, int32_t displacement)
+    {
+        rex(reg, base, true);
+        opcode(op);
+        unsigned mod;
+        if (displacement == 0 && (base & 7) != RBP)
+        {
+            mod = 0x00;
+        }
+        else if (displacement >= -128 && displacement <= 127)
+        {
+            mod = 0x40;
+        }
+        else
+        {
+            mod = 0x80;
+        }
+        byte(mod | ((reg & 7) << 3) | (base & 7));
+        if ((base & 7) == RSP)
+        {
+            byte(0x24);
+        }
+        if (mod == 0x40)
+        {
+            byte(static_cast<uint8_t>(displacement));
+        }
+        else if (mod == 0x80)
+        {
+            dword(static_cast<uint32_t>(displacement));
+        }
+    }
+
+    void load(int target, int base, int32_t displacement)
+    {
+        memory(0x8B, target, base, displacement);
+    }
+
+    void store(int source, int base, int32_t displacement)
+    {
+        memory(0x89, source, base, displacement);
+    }
+
+    void lea(int target, int base, int32_t displacement)
+    {
+        memory(0x8D, target, base, displacement);
+    }
+
+    void move(int target, int source)
+    {
+        if (target != source)
+        {
+            registers(0x89, source, target);
+        }
+    }
+
+    void moveImmediate(int target, long long value)
+    {
+        if (value >= 0 && value <= 0x7FFFFFFF)
+        {
+            // 32λдʱλԶ
+            rex(0, target, false);
+            byte(0xB8 + (target & 7));
+            dword(static_cast<uint32_t>(value));
+        }
+        else if (value >= -0x80000000LL && value < 0)
+        {
+            registers(0xC7, 0, target);
+            dword(static_cast<uint32_t>(value));
+        }
+        else
+        {
+            rex(0, target, true);
+            byte(0xB8 + (target & 7));
+            qword(static_cast<uint64_t>(value));
+        }
+    }
+
+    void subtract(int target, int source)
+    {
+        registers(0x29, source, target);
+    }
+
+    void multiply(int target, int source)
+    {
+        registers(0x0FAF, target, source);
+    }
+
+    // left - rightñ־
+    void compare(int left, int right)
+    {
+        registers(0x39, right, left);
+    }
+
+    void compareImmediate(int left, int32_t value)
+    {
+        registers(0x81, 7, left);
+        dword(static_cast<uint32_t>(value));
+    }
+
+    // ޷Ŵʱtarget = source
+    void moveIfAbove(int target, int source)
+    {
+        registers(0x0F47, target, source);
+    }
+
+    void increment(int target)
+    {
+        registers(0xFF, 0, target);
+    }
+
+    void decrement(int target)
+    {
+        registers(0xFF, 1, target);
+    }
+
+    void testLow32(int target)
+    {
+        rex(target, target, false);
+        byte(0x85);
+        byte(0xC0 | ((target & 7) << 3) | (target & 7));
+    }
+
+    void push(int source)
+    {
+        rex(0, source, false);
+        byte(0x50 + (source & 7));
+    }
+
+    void pop(int target)
+    {
+        rex(0, target, false);
+        byte(0x58 + (target & 7));
+    }
+
+    void callRegister(int target)
+    {
+        rex(0, target, false);
+        byte(0xFF);
+        byte(0xD0 | (target & 7));
+    }
+
+    void call(size_t label)
+    {
+        byte(0xE8);
+        rel32(label);
+    }
+
+    void jump(size_t label)
+    {
+        byte(0xE9);
+        rel32(label);
+    }
+
+    // condition룬0x4ʾ
+    void jumpIf(unsigned condition, size_t label)
+    {
+        byte(0x0F);
+        byte(0x80 | condition);
+        rel32(label);
+    }
+
+    void ret()
+    {
+        byte(0xC3);
+    }
+
+    void bind(size_t label)
+    {
+        labels[label] = bytes.size();
+    }
+
+    // תַõĴ
+    const std::vector<unsigned char>& finish()
+    {
+        for (size_t i = 0; i < fixups.size(); ++i)
+        {
+            size_t position = fixups[i].first;
+            int64_t offset = static_cast<int64_t>(labels[fixups[i].second]) - static_cast<int64_t>(position + 4);
+            uint32_t value = static_cast<uint32_t>(static_cast<int32_t>(offset));
+            for (int k = 0; k < 4; ++k)
+            {
+                bytes[position + k] = static_cast<unsigned char>((value >> (8 * k)) & 0xFF);
+            }
+        }
+        return bytes;
+    }
+};
+
+// x86
+static const unsigned CONDITION_EQUAL = 0x4;
+static const unsigned CONDITION_NOT_EQUAL = 0x5;
+static const unsigned CONDITION_ABOVE = 0x7;
+static const unsigned CONDITION_LESS = 0xC;
+static const unsigned CONDITION_GREATER_OR_EQUAL = 0xD;
+static const unsigned CONDITION_LESS_OR_EQUAL = 0xE;
+static const unsigned CONDITION_GREATER = 0xF;
+
+// ¼ݴĴдŵǵǰ֡ĸĴд֡ʱͬʱдڴ棬
+// תĿꡢúͶдֱ֮ȫϼ
+class RegisterCache
+{
+private:
+    static const long long EMPTY = -1;
+    long long holds[16]; // ÿĴӦ֡Ĵ
+    uint64_t lastUse[16]; // ʹõʱ̣ѡ滻ļĴ
+    uint64_t clock;
+
+public:
+    RegisterCache()
+        :clock(0)
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            holds[i] = EMPTY;
+            lastUse[i] = 0;
+        }
+    }
+
+    // ֡Ĵslotĸ
+    void forget(uint32_t slot)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            if (holds[i] == slot) holds[i] = EMPTY;
+        }
+    }
+
+    // ȡһavoidеݴĴѡеģѡδõ
+    int allocate(unsigned avoid)
+    {
+        int chosen = -1;
+        for (size_t i = 0; i < CACHE_REGISTER_COUNT; ++i)
+        {
+            int reg = CACHE_REGISTERS[i];
+            if (avoid & (1u << reg)) continue;
+            if (chosen < 0 ||
+                (holds[reg] == EMPTY && holds[chosen] != EMPTY) ||
+                ((holds[reg] == EMPTY) == (holds[chosen] == EMPTY) && lastUse[reg] < lastUse[chosen]))
+            {
+                chosen = reg;
+            }
+        }
+        holds[chosen] = EMPTY;
+        lastUse[chosen] = ++clock;
+        return chosen;
+    }
+
+    // ֡ĴslotֵŵĳݴĴ
+    int load(Assembler& assembler, uint32_t slot, unsigned avoid)
+    {
+        for (size_t i = 0; i < CACHE_REGISTER_COUNT; ++i)
+        {
+            int reg = CACHE_REGISTERS[i];
+            if (holds[reg] == slot)
+            {
+                lastUse[reg] = ++clock;
+                return reg;
+            }
+        }
+        int reg = allocate(avoid);
+        assembler.load(reg, RBX, static_cast<int32_t>(slot * 8));
+        holds[reg] = slot;
+        return reg;
+    }
+
+    // regеֵд֡Ĵslot
+    void store(Assembler& assembler, int reg, uint32_t slot)
+    {
+        assembler.store(reg, RBX, static_cast<int32_t>(slot * 8));
+        forget(slot);
+        holds[reg] = slot;
+        lastUse[reg] = ++clock;
+    }
+};
+
+static unsigned bit(int reg)
+{
+    return 1u << reg;
+}
+
+// ֽΪһδ롣׮ʼǸֽķͼ
+class NativeTranslator
+{
+private:
+    const BytecodeProgram& program;
+    JitContext* context;
+    MemoTable* memo;
+    Assembler assembler;
+    RegisterCache cache;
+    size_t labelFinished;
+    size_t labelOverflow;
+    size_t labelReadFailed;
+    size_t labelExit;
+
+    // ÿֽںĲκ֡СΪ0
+    std::vector<uint32_t> levels;
+    std::vector<uint32_t> frameSizes;
+    std::vector<bool> entries; // ĵһָ
+    std::vector<bool> targets; // תĿ
+
+    void analyze()
+    {
+        size_t count = program.code.size();
+        levels.assign(count, 0);
+        frameSizes.assign(count, program.mainFrameSize);
+        entries.assign(count, false);
+        targets.assign(count, false);
+        if (count > 0) entries[0] = true;
+
+        // ÿĴһֱһ
+        std::vector<const FunctionCode*> ordered;
+        for (size_t i = 0; i < program.functions.size(); ++i)
+        {
+            if (program.functions[i].level > 0) ordered.push_back(&program.functions[i]);
+        }
+        std::sort(ordered.begin(), ordered.end(),
+            [](const FunctionCode* x, const FunctionCode* y) { return x->entry < y->entry; });
+        for (size_t i = 0; i < ordered.size(); ++i)
+        {
+            size_t end = i + 1 < ordered.size() ? ordered[i + 1]->entry : count;
+            entries[ordered[i]->entry] = true;
+            for (size_t k = ordered[i]->entry; k < end; ++k)
+            {
+                levels[k] = ordered[i]->level;
+                frameSizes[k] = ordered[i]->frameSize;
+            }
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            Opcode op = program.code[i].op;
+            if (op >= Opcode::JUMP && op <= Opcode::JUMP_IF_NOT_EQUALS)
+            {
+                targets[program.code[i].c] = true;
+            }
+            else if (op == Opcode::CALL_MEMO && i + 2 < count)
+            {
+                targets[i + 2] = true;
+            }
+        }
+    }
+
+    // ؾ̬hops㣬֡ŵtarget
+    void walkStaticLink(int target, uint32_t hops)
+    {
+        assembler.move(target, RBX);
+        for (uint32_t k = 0; k < hops; ++k)
+        {
+            assembler.load(target, target, static_cast<int32_t>(STATIC_LINK_SLOT * 8));
+        }
+    }
+
+    void moveContext(int target)
+    {
+        assembler.moveImmediate(target, static_cast<long long>(reinterpret_cast<uintptr_t>(context)));
+    }
+
+    void callHelper(const void* function)
+    {
+        assembler.moveImmediate(RAX, static_cast<long long>(reinterpret_cast<uintptr_t>(function)));
+        assembler.callRegister(RAX);
+        cache.clear();
+    }
+
+    void conditionalJump(const Instruction& instruction, unsigned condition)
+    {
+        int left = cache.load(assembler, instruction.a, 0);
+        int right = cache.load(assembler, instruction.b, bit(left));
+        assembler.compare(left, right);
+        assembler.jumpIf(condition, instruction.c);
+    }
+
+    void arithmetic(const Instruction& instruction, bool multiply)
+    {
+        int left = cache.load(assembler, instruction.b, 0);
+        int right = cache.load(assembler, instruction.c, bit(left));
+        int result = cache.allocate(bit(left) | bit(right));
+        assembler.move(result, left);
+        if (multiply)
+        {
+            assembler.multiply(result, right);
+        }
+        else
+        {
+            assembler.subtract(result, right);
+        }
+        cache.store(assembler, result, instruction.a);
+    }
+
+    void call(const Instruction& instruction, uint32_t level, uint32_t frameSize, uint32_t maxDepth)
+    {
+        const FunctionCode& callee = program.functions[instruction.b];
+        int argument = cache.load(assembler, instruction.c, 0);
+        assembler.move(RSI, argument);
+
+        // òͼĴܳ
+        assembler.increment(R14);
+        assembler.compareImmediate(R14, static_cast<int32_t>(maxDepth));
+        assembler.jumpIf(CONDITION_ABOVE, labelOverflow);
+        assembler.lea(RDI, RBX, static_cast<int32_t>(frameSize * 8));
+        assembler.lea(RDX, RDI, static_cast<int32_t>(callee.frameSize * 8));
+        assembler.compare(RDX, R13);
+        assembler.jumpIf(CONDITION_ABOVE, labelOverflow);
+        assembler.compare(R14, R15);
+        assembler.moveIfAbove(R15, R14);
+        assembler.increment(RBP);
+
+        // ̬֡ʵΣֵ;ֲ
+        walkStaticLink(RAX, level + 1 - callee.level);
+        assembler.store(RAX, RDI, static_cast<int32_t>(STATIC_LINK_SLOT * 8));
+        assembler.store(RSI, RDI, static_cast<int32_t>(PARAMETER_SLOT * 8));
+        assembler.moveImmediate(RDX, 0);
+        assembler.store(RDX, RDI, static_cast<int32_t>(RETURN_SLOT * 8));
+        for (uint32_t k = PARAMETER_SLOT + 1; k < callee.variableCount; ++k)
+        {
+            assembler.store(RDX, RDI, static_cast<int32_t>(k * 8));
+        }
+        assembler.call(callee.entry);
+        cache.clear();
+        cache.store(assembler, RAX, instruction.a);
+    }
+
+    void translate(size_t index, uint32_t maxDepth)
+    {
+        const Instruction& instruction = program.code[index];
+        uint32_t level = levels[index];
+        switch (instruction.op)
+        {
+        case Opcode::MOVE:
+        {
+            int source = cache.load(assembler, instruction.b, 0);
+            if (instruction.a != instruction.b)
+            {
+                assembler.store(source, RBX, static_cast<int32_t>(instruction.a * 8));
+                cache.forget(instruction.a);
+            }
+            break;
+        }
+        case Opcode::CONSTANT:
+        {
+            int target = cache.allocate(0);
+            assembler.moveImmediate(target, program.constants[instruction.b]);
+            cache.store(assembler, target, instruction.a);
+            break;
+        }
+        case Opcode::GET_GLOBAL:
+        {
+            int target = cache.allocate(0);
+            assembler.load(target, R12, static_cast<int32_t>(instruction.b * 8));
+            cache.store(assembler, target, instruction.a);
+            break;
+        }
+        case Opcode::SET_GLOBAL:
+        {
+            int source = cache.load(assembler, instruction.a, 0);
+            assembler.store(source, R12, static_cast<int32_t>(instruction.b * 8));
+            // еȫ֡ǵǰ֡
+            if (level == 0 && instruction.b != instruction.a) cache.forget(instruction.b);
+            break;
+        }
+        case Opcode::GET_OUTER:
+        {
+            int target = cache.allocate(0);
+            walkStaticLink(target, instruction.c);
+            assembler.load(target, target, static_cast<int32_t>(instruction.b * 8));
+            cache.store(assembler, target, instruction.a);
+            break;
+        }
+        case Opcode::SET_OUTER:
+        {
+            int source = cache.load(assembler, instruction.a, 0);
+            int frame = cache.allocate(bit(source));
+            walkStaticLink(frame, instruction.c);
+            assembler.store(source, frame, static_cast<int32_t>(instruction.b * 8));
+            if (instruction.c == 0 && instruction.b != instruction.a) cache.forget(instruction.b);
+            break;
+        }
+        case Opcode::SUBTRACT:
+            arithmetic(instruction, false);
+            break;
+        case Opcode::MULTIPLY:
+            arithmetic(instruction, true);
+            break;
+        case Opcode::JUMP:
+            assembler.jump(instruction.c);
+            cache.clear();
+            break;
+        case Opcode::JUMP_IF_LESS:
+            conditionalJump(instruction, CONDITION_LESS);
+            break;
+        case Opcode::JUMP_IF_LESS_OR_EQUALS:
+            conditionalJump(instruction, CONDITION_LESS_OR_EQUAL);
+            break;
+        case Opcode::JUMP_IF_GREATER:
+            conditionalJump(instruction, CONDITION_GREATER);
+            break;
+        case Opcode::JUMP_IF_GREATER_OR_EQUALS:
+            conditionalJump(instruction, CONDITION_GREATER_OR_EQUAL);
+            break;
+        case Opcode::JUMP_IF_EQUALS:
+            conditionalJump(instruction, CONDITION_EQUAL);
+            break;
+        case Opcode::JUMP_IF_NOT_EQUALS:
+            conditionalJump(instruction, CONDITION_NOT_EQUAL);
+            break;
+        case Opcode::CALL_MEMO:
+            if (memo != nullptr)
+            {
+                // дڴ֡ĴµģֱӴ֡ȡʵ
+                assembler.moveImmediate(RDI, static_cast<long long>(reinterpret_cast<uintptr_t>(memo)));
+                assembler.moveImmediate(RSI, instruction.b);
+                assembler.load(RDX, RBX, static_cast<int32_t>(instruction.c * 8));
+                assembler.lea(RCX, RBX, static_cast<int32_t>(instruction.a * 8));
+                callHelper(reinterpret_cast<const void*>(&jitMemoFind));
+                assembler.testLow32(RAX);
+                assembler.jumpIf(CONDITION_NOT_EQUAL, index + 2);
+            }
+            call(instruction, level, frameSizes[index], maxDepth);
+            break;
+        case Opcode::MEMO_STORE:
+            if (memo != nullptr)
+            {
+                assembler.moveImmediate(RDI, static_cast<long long>(reinterpret_cast<uintptr_t>(memo)));
+                assembler.moveImmediate(RSI, instruction.b);
+                assembler.load(RDX, RBX, static_cast<int32_t>(instruction.c * 8));
+                assembler.load(RCX, RBX, static_cast<int32_t>(instruction.a * 8));
+                callHelper(reinterpret_cast<const void*>(&jitMemoStore));
+            }
+            break;
+        case Opcode::CALL:
+            call(instruction, level, frameSizes[index], maxDepth);
+            break;
+        case Opcode::RETURN:
+            assembler.load(RAX, RBX, static_cast<int32_t>(RETURN_SLOT * 8));
+            assembler.decrement(R14);
+            assembler.pop(RBX);
+            assembler.ret();
+            cache.clear();
+            break;
+        case Opcode::READ:
+            moveContext(RDI);
+            assembler.lea(RSI, RBX, static_cast<int32_t>(instruction.a * 8));
+            callHelper(reinterpret_cast<const void*>(&jitRead));
+            assembler.testLow32(RAX);
+            assembler.jumpIf(CONDITION_EQUAL, labelReadFailed);
+            break;
+        case Opcode::WRITE:
+        {
+            int source = cache.load(assembler, instruction.a, 0);
+            assembler.move(RSI, source);
+            moveContext(RDI);
+            callHelper(reinterpret_cast<const void*>(&jitWrite));
+            break;
+        }
+        case Opcode::HALT:
+            assembler.jump(labelFinished);
+            cache.clear();
+            break;
+        }
+    }
+
+    // ڣeaxΪндͳƺָʱջͼĴ
+    void exits()
+    {
+        assembler.bind(labelFinished);
+        assembler.moveImmediate(RAX, static_cast<long long>(RunStatus::FINISHED));
+        assembler.jump(labelExit);
+        assembler.bind(labelOverflow);
+        assembler.moveImmediate(RAX, static_cast<long long>(RunStatus::STACK_OVERFLOW));
+        assembler.jump(labelExit);
+        assembler.bind(labelReadFailed);
+        assembler.moveImmediate(RAX, static_cast<long long>(RunStatus::READ_FAILED));
+        assembler.bind(labelExit);
+        moveContext(RCX);
+        assembler.store(RBP, RCX, static_cast<int32_t>(offsetof(JitContext, calls)));
+        assembler.store(R15, RCX, static_cast<int32_t>(offsetof(JitContext, deepest)));
+        assembler.load(RSP, RCX, static_cast<int32_t>(offsetof(JitContext, savedStack)));
+        assembler.pop(R15);
+        assembler.pop(R14);
+        assembler.pop(R13);
+        assembler.pop(R12);
+        assembler.pop(RBP);
+        assembler.pop(RBX);
+        assembler.ret();
+    }
+
+public:
+    NativeTranslator(const BytecodeProgram& program, JitContext* context, MemoTable* memo)
+        :program(program)
+        ,context(context)
+        ,memo(memo)
+        ,assembler(program.code.size() + 4)
+        ,labelFinished(program.code.size())
+        ,labelOverflow(program.code.size() + 1)
+        ,labelReadFailed(program.code.size() + 2)
+        ,labelExit(program.code.size() + 3)
+    {}
+
+    // ɴ롣׮int entry(JitContext*)ãRunStatusֵ
+    const std::vector<unsigned char>& translate(long long* registers, long long* registerLimit,
+        unsigned char* stackTop, uint32_t maxDepth)
+    {
+        analyze();
+
+        // ׮汻߱ļĴлջ֡
+        assembler.push(RBX);
+        assembler.push(RBP);
+        assembler.push(R12);
+        assembler.push(R13);
+        assembler.push(R14);
+        assembler.push(R15);
+        assembler.store(RSP, RDI, static_cast<int32_t>(offsetof(JitContext, savedStack)));
+        assembler.moveImmediate(R12, static_cast<long long>(reinterpret_cast<uintptr_t>(registers)));
+        assembler.moveImmediate(R13, static_cast<long long>(reinterpret_cast<uintptr_t>(registerLimit)));
+        assembler.moveImmediate(R14, 0);
+        assembler.moveImmediate(R15, 0);
+        assembler.moveImmediate(RBP, 0);
+        assembler.moveImmediate(RSP, static_cast<long long>(reinterpret_cast<uintptr_t>(stackTop)));
+        assembler.move(RDI, R12);
+        assembler.call(0);
+        assembler.jump(labelFinished);
+
+        for (size_t i = 0; i < program.code.size(); ++i)
+        {
+            assembler.bind(i);
+            if (entries[i])
+            {
+                // ڣRDI֡
+                cache.clear();
+                assembler.push(RBX);
+                assembler.move(RBX, RDI);
+            }
+            else if (targets[i])
+            {
+                cache.clear();
+            }
+            translate(i, maxDepth);
+        }
+        exits();
+        return assembler.finish();
+    }
+};
+
+static size_t roundToPages(size_t bytes)
+{
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + page - 1) / page * page;
+}
+
+// ӳɶдڴ棬ֻõʱռҳ
+static void* mapMemory(size_t bytes)
+{
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+
+#endif
+
+JitCompiler::JitCompiler(size_t maxDepth)
+    :maxDepth(maxDepth)
+    ,code(nullptr)
+    ,codeBytes(0)
+    ,registers(nullptr)
+    ,registerBytes(0)
+    ,nativeStack(nullptr)
+    ,nativeStackBytes(0)
+    ,mainFrameSize(0)
+    ,memo(nullptr)
+    ,context()
+{}
+
+JitCompiler::~JitCompiler()
+{
+    release();
+}
+
+void JitCompiler::release()
+{
+#ifdef JIT_NATIVE
+    if (code != nullptr) munmap(code, codeBytes);
+    if (registers != nullptr) munmap(registers, registerBytes);
+    if (nativeStack != nullptr) munmap(nativeStack, nativeStackBytes);
+#endif
+    code = nullptr;
+    registers = nullptr;
+    nativeStack = nullptr;
+    codeBytes = registerBytes = nativeStackBytes = 0;
+}
+
+bool JitCompiler::available()
+{
+#ifdef JIT_NATIVE
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool JitCompiler::compile(const BytecodeProgram& program)
+{
+    release();
+#ifdef JIT_NATIVE
+    if (program.code.empty() || maxDepth > 0x7FFFFFFF) return false;
+
+    // ĴҪĵʱһò
+    size_t largestFrame = 0;
+    for (size_t i = 0; i < program.functions.size(); ++i)
+    {
+        if (program.functions[i].frameSize > largestFrame) largestFrame = program.functions[i].frameSize;
+    }
+    size_t limit = static_cast<size_t>(1) << 40;
+    if (largestFrame > 0 && maxDepth > (limit / sizeof(long long) - program.mainFrameSize) / largestFrame) return false;
+    size_t registerCount = program.mainFrameSize + maxDepth * largestFrame;
+    registerBytes = roundToPages(registerCount * sizeof(long long) + 1);
+    nativeStackBytes = roundToPages((maxDepth + 4) * NATIVE_BYTES_PER_CALL + NATIVE_STACK_RESERVE);
+    registers = static_cast<long long*>(mapMemory(registerBytes));
+    nativeStack = static_cast<unsigned char*>(mapMemory(nativeStackBytes));
+    if (registers == nullptr || nativeStack == nullptr)
+    {
+        release();
+        return false;
+    }
+
+    NativeTranslator translator(program, &context, memo);
+    const std::vector<unsigned char>& bytes = translator.translate(registers, registers + registerCount,
+        nativeStack + nativeStackBytes, static_cast<uint32_t>(maxDepth));
+    codeBytes = roundToPages(bytes.size());
+    void* memory = mapMemory(codeBytes);
+    if (memory == nullptr)
+    {
+        release();
+        return false;
+    }
+    code = static_cast<unsigned char*>(memory);
+    std::memcpy(code, bytes.data(), bytes.size());
+    // дɺΪִֻ
+    if (mprotect(code, codeBytes, PROT_READ | PROT_EXEC) != 0)
+    {
+        release();
+        return false;
+    }
+    mainFrameSize = program.mainFrameSize;
+    return true;
+#else
+    (void)program;
+    return false;
+#endif
+}
+
+RunStatus JitCompiler::run(std::istream& input, std::ostream& output)
+{
+    auto start = std::chrono::steady_clock::now();
+    stats = RunStatistics();
+    RunStatus status = RunStatus::FINISHED;
+#ifdef JIT_NATIVE
+    if (code != nullptr)
+    {
+        std::memset(registers, 0, mainFrameSize * sizeof(long long));
+        if (memo != nullptr) memo->clear();
+        context.input = &input;
+        context.output = &output;
+        context.calls = 0;
+        context.deepest = 0;
+        typedef int (*Entry)(JitContext*);
+        Entry entry = reinterpret_cast<Entry>(code);
+        status = static_cast<RunStatus>(entry(&context));
+        stats.calls = context.calls;
+        stats.maxDepth = static_cast<size_t>(context.deepest);
+    }
+#else
+    (void)input;
+    (void)output;
+#endif
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return status;
+}
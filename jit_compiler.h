@@ -0,0 +1,70 @@
+#ifndef JIT_COMPILER_H
+#define JIT_COMPILER_H
+
+#include <cstdint>
+#include <iostream>
+#include "bytecode.h"
+#include "memo_table.h"
+#include "virtual_machine.h"
+
+// شʱֱֳַдɵĴ
+struct JitContext
+{
+    void* savedStack; // 뱾شǰջָ룬ʱﷵ
+    std::istream* input;
+    std::ostream* output;
+    uint64_t calls; // ô
+    uint64_t deepest; // ĵò
+};
+
+// ֽ뷭Ϊx86-64شִУֻLinux x86-64Ͽãƽ̨compilefalseɵ߸VirtualMachine
+// ÿ򣩷Ϊһαش룬ݹֱcall֡Ĳͬ
+// ڰѶ֡ĴڻĴУдʱͬʱд֡дC++Сɡ
+// شڵӳջУòһ
+class JitCompiler
+{
+private:
+    size_t maxDepth; // ò
+    unsigned char* code; // ִеĴ
+    size_t codeBytes;
+    long long* registers; // ȫ֡ļĴ
+    size_t registerBytes;
+    unsigned char* nativeStack; // شʹõջ
+    size_t nativeStackBytes;
+    uint32_t mainFrameSize;
+    MemoTable* memo; // 棬ַcompileʱд
+    JitContext context;
+    RunStatistics stats;
+
+    JitCompiler(const JitCompiler&) = delete;
+    JitCompiler& operator=(const JitCompiler&) = delete;
+
+    void release();
+
+public:
+    explicit JitCompiler(size_t maxDepth = VirtualMachine::DEFAULT_MAX_DEPTH);
+    ~JitCompiler();
+
+    // ǰƽ̨ܷɱش
+    static bool available();
+
+    // CALL_MEMOMEMO_STOREʹõĻ棬compile֮ǰãΪnullptrʱCALL_MEMOͬCALL
+    void setMemoTable(MemoTable* table)
+    {
+        memo = table;
+    }
+
+    // ӳΪִڴ棬ʧܣƽֻ̨֧ڴ治㣩ʱfalse
+    bool compile(const BytecodeProgram& program);
+
+    // compileɹĳΪVirtualMachine::runͬͳвָ
+    RunStatus run(std::istream& input, std::ostream& output);
+
+    // һеͳ
+    const RunStatistics& statistics() const
+    {
+        return stats;
+    }
+};
+
+#endif
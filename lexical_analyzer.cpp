@@ -1,50 +1,222 @@
 #include <string>
-#include <unordered_map>
 #include <fstream>
-#include <cassert>
-#include <iomanip>
 #include <sstream>
 #include <array>
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define LEXER_USE_MMAP 1
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LEXER_USE_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define LEXER_USE_SSE2 1
+#endif
 #include "lexical_analyzer.h"
+#include "token_stream.h"
 
-std::string targetFileName;
-std::string errorFileName;
-std::unordered_map<std::string, std::string> tokentable;
-std::array<CharType, 128> charTypeTable = {};
-int currentline = 1;
+const size_t DYD_BUFFER_SIZE = 1 << 16; // .dydСдд
 const int KEY_FORMAT_LENGTH = 16;
+const size_t READ_BLOCK_SIZE = 1 << 20; // ֿʱÿζȡ1MB
 
-void initTokenTable() {
-	tokentable["begin"] = TokenType::BEGIN;
-	tokentable["end"] = TokenType::END;
-	tokentable["integer"] = TokenType::INTEGER;
-	tokentable["if"] = TokenType::IF;
-	tokentable["then"] = TokenType::THEN;
-	tokentable["else"] = TokenType::ELSE;
-	tokentable["function"] = TokenType::FUNCTION;
-	tokentable["read"] = TokenType::READ;
-	tokentable["write"] = TokenType::WRITE;
-	tokentable["identifier"] = TokenType::IDENTIFIER;
-	tokentable["constant"] = TokenType::CONSTANT;
-	tokentable["="] = TokenType::EQUALS;
-	tokentable["<>"] = TokenType::NOT_EQUALS;
-	tokentable["<="] = TokenType::LESS_OR_EQUALS;
-	tokentable["<"] = TokenType::LESS;
-	tokentable[">="] = TokenType::GREATER_OR_EQUALS;
-	tokentable[">"] = TokenType::GREATER;
-	tokentable["-"] = TokenType::MINUS;
-	tokentable["*"] = TokenType::MULTIPLY;
-	tokentable[":="] = TokenType::ASSIGN;
-	tokentable["("] = TokenType::OPEN_PAREN;
-	tokentable[")"] = TokenType::CLOSE_PAREN;
-	tokentable[";"] = TokenType::SEMICOLON;
-	tokentable["EOLN"] = TokenType::EOLN;
-	tokentable["EOF"] = TokenType::END_OF_FILE;
-}
-
-void initcharTypeTable() {
+bool openSourceBuffer(const std::string& fileName, SourceBuffer& buffer) {
+    buffer = SourceBuffer();
+#ifdef LEXER_USE_MMAP
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+            close(fd);
+            buffer.data = static_cast<const char*>(addr);
+            buffer.size = static_cast<size_t>(st.st_size);
+            buffer.mapped = true;
+            return true;
+        }
+    }
+    close(fd);
+#endif
+    // ֧mmapӳʧܡļΪգʱڴ
+    FILE* fp = std::fopen(fileName.c_str(), "rb");
+    if (fp == nullptr) return false;
+    std::vector<char> content;
+    size_t length = 0;
+    for (;;) {
+        content.resize(length + READ_BLOCK_SIZE);
+        size_t n = std::fread(content.data() + length, 1, READ_BLOCK_SIZE, fp);
+        length += n;
+        if (n < READ_BLOCK_SIZE) break;
+    }
+    std::fclose(fp);
+    char* data = new char[length + 1];
+    std::memcpy(data, content.data(), length);
+    buffer.data = data;
+    buffer.size = length;
+    buffer.mapped = false;
+    return true;
+}
+
+void closeSourceBuffer(SourceBuffer& buffer) {
+#ifdef LEXER_USE_MMAP
+    if (buffer.mapped) {
+        munmap(const_cast<char*>(buffer.data), buffer.size);
+        buffer = SourceBuffer();
+        return;
+    }
+#endif
+    delete[] buffer.data;
+    buffer = SourceBuffer();
+}
+
+const std::string& tokenCode(TokenKind kind) {
+    static const std::string* const codes[] = {
+        nullptr,
+        &TokenType::BEGIN, &TokenType::END, &TokenType::INTEGER, &TokenType::IF, &TokenType::THEN,
+        &TokenType::ELSE, &TokenType::FUNCTION, &TokenType::READ, &TokenType::WRITE, &TokenType::IDENTIFIER,
+        &TokenType::CONSTANT, &TokenType::EQUALS, &TokenType::NOT_EQUALS, &TokenType::LESS_OR_EQUALS, &TokenType::LESS,
+        &TokenType::GREATER_OR_EQUALS, &TokenType::GREATER, &TokenType::MINUS, &TokenType::MULTIPLY, &TokenType::ASSIGN,
+        &TokenType::OPEN_PAREN, &TokenType::CLOSE_PAREN, &TokenType::SEMICOLON, &TokenType::EOLN, &TokenType::END_OF_FILE,
+    };
+    return *codes[static_cast<int>(kind)];
+}
+
+bool lookupKeyword(const char* s, size_t length, TokenKind& kind) {
+    // ֺϹ̶ȺַɺȽһμȷ
+    switch (length) {
+        case 1: {
+            switch (s[0]) {
+                case '=': kind = TokenKind::EQUALS; return true;
+                case '<': kind = TokenKind::LESS; return true;
+                case '>': kind = TokenKind::GREATER; return true;
+                case '-': kind = TokenKind::MINUS; return true;
+                case '*': kind = TokenKind::MULTIPLY; return true;
+                case '(': kind = TokenKind::OPEN_PAREN; return true;
+                case ')': kind = TokenKind::CLOSE_PAREN; return true;
+                case ';': kind = TokenKind::SEMICOLON; return true;
+                default: return false;
+            }
+        }
+        case 2: {
+            if (s[1] == '=') {
+                switch (s[0]) {
+                    case '<': kind = TokenKind::LESS_OR_EQUALS; return true;
+                    case '>': kind = TokenKind::GREATER_OR_EQUALS; return true;
+                    case ':': kind = TokenKind::ASSIGN; return true;
+                    default: return false;
+                }
+            }
+            if (s[0] == '<' && s[1] == '>') { kind = TokenKind::NOT_EQUALS; return true; }
+            if (s[0] == 'i' && s[1] == 'f') { kind = TokenKind::IF; return true; }
+            return false;
+        }
+        case 3: {
+            if (s[0] == 'e' && std::memcmp(s, "end", 3) == 0) { kind = TokenKind::END; return true; }
+            return false;
+        }
+        case 4: {
+            switch (s[0]) {
+                case 't': kind = TokenKind::THEN; return std::memcmp(s, "then", 4) == 0;
+                case 'e': kind = TokenKind::ELSE; return std::memcmp(s, "else", 4) == 0;
+                case 'r': kind = TokenKind::READ; return std::memcmp(s, "read", 4) == 0;
+                default: return false;
+            }
+        }
+        case 5: {
+            switch (s[0]) {
+                case 'b': kind = TokenKind::BEGIN; return std::memcmp(s, "begin", 5) == 0;
+                case 'w': kind = TokenKind::WRITE; return std::memcmp(s, "write", 5) == 0;
+                default: return false;
+            }
+        }
+        case 7: {
+            kind = TokenKind::INTEGER;
+            return s[0] == 'i' && std::memcmp(s, "integer", 7) == 0;
+        }
+        case 8: {
+            kind = TokenKind::FUNCTION;
+            return s[0] == 'f' && std::memcmp(s, "function", 8) == 0;
+        }
+        default:
+            return false;
+    }
+}
+
+const char* tokenSpelling(TokenKind kind) {
+    static const char* const spellings[] = {
+        nullptr,
+        "begin", "end", "integer", "if", "then",
+        "else", "function", "read", "write", nullptr,
+        nullptr, "=", "<>", "<=", "<",
+        ">=", ">", "-", "*", ":=",
+        "(", ")", ";", "EOLN", "EOF",
+    };
+    return spellings[static_cast<int>(kind)];
+}
+
+// ̶ƴдɵĵʳǰ׺Լֱƴдеλ
+struct FixedSpellings {
+    std::string pool;
+    std::array<uint32_t, 26> offsets;
+
+    FixedSpellings() : offsets() {
+        for (int k = static_cast<int>(TokenKind::BEGIN); k <= static_cast<int>(TokenKind::END_OF_FILE); ++k) {
+            const char* spelling = tokenSpelling(static_cast<TokenKind>(k));
+            offsets[k] = static_cast<uint32_t>(pool.size());
+            if (spelling != nullptr) pool += spelling;
+        }
+    }
+};
+
+static const FixedSpellings& fixedSpellings() {
+    static const FixedSpellings spellings;
+    return spellings;
+}
+
+TokenBuffer::TokenBuffer()
+    :pool(fixedSpellings().pool)
+{}
+
+void TokenBuffer::clear() {
+    tokens.clear();
+    pool.assign(fixedSpellings().pool);
+}
+
+void TokenBuffer::append(const char* text, size_t length, TokenKind kind, uint32_t line, size_t column) {
+    Token token;
+    token.kind = kind;
+    token.length = static_cast<uint8_t>(length);
+    token.column = static_cast<uint16_t>(std::min(column, static_cast<size_t>(UINT16_MAX)));
+    token.line = line;
+    const char* spelling = tokenSpelling(kind);
+    if (spelling != nullptr && std::strlen(spelling) == length && std::memcmp(spelling, text, length) == 0) {
+        token.offset = fixedSpellings().offsets[static_cast<int>(kind)];
+    } else {
+        token.offset = static_cast<uint32_t>(pool.size());
+        pool.append(text, length);
+    }
+    tokens.push_back(token);
+}
+
+std::array<CharType, 256> makeCharTypeTable() {
+    std::array<CharType, 256> charTypeTable;
+    // δгַ0x80ϵķASCIIֽڣһΪǷַ
+    charTypeTable.fill(CharType::OTHERS);
     // ÿַӦCharType
     charTypeTable[' '] = CharType::SPACE;
+    charTypeTable['\t'] = CharType::SPACE;
     charTypeTable['='] = CharType::EQUALS_SIGN;
     charTypeTable['-'] = CharType::MINUS_SIGN;
     charTypeTable['*'] = CharType::MULTIPLY_SIGN;
@@ -59,180 +231,301 @@ void initcharTypeTable() {
     for (char c = 'a'; c <= 'z'; ++c) charTypeTable[c] = CharType::LETTER;
     for (char c = 'A'; c <= 'Z'; ++c) charTypeTable[c] = CharType::LETTER;
     for (char c = '0'; c <= '9'; ++c) charTypeTable[c] = CharType::DIGIT;
+    return charTypeTable;
 }
 
+// ַͱֻڳʱһΣֻ֮ηԹ
+static const std::array<CharType, 256> charTypeTable = makeCharTypeTable();
+
 CharType check(char c) {
-    return charTypeTable[c];
+    return charTypeTable[static_cast<unsigned char>(c)];
 }
 
-void error(ErrorType type, std::ofstream& outErrorFile) {
-    switch (type) {
-        case ErrorType::INVALID_SYMBOL: {
-            outErrorFile << "***LINE:" + std::to_string(currentline) + "  Invalid symbol." << std::endl;
-            break;
-        }
-        case ErrorType::IDENTIFIER_TOO_LONG: {
-            outErrorFile << "***LINE:" + std::to_string(currentline) + "  Identifier is too long." << std::endl;
-            break;
-        }
-        case ErrorType::MISSING_EQUAL_AFTER_COLON: {
-            outErrorFile << "***LINE:" + std::to_string(currentline) + "  miss '=' after ':'." << std::endl;
-            break;
+// ַɨ裺һαȽ16SSE232AVX2ֽڣõĳַλ룬
+// һ0λεĽλãһȵβ˻ֽڲ
+enum class RunClass {
+    SPACES, // ոƱ
+    ALNUMS, // ĸ
+    DIGITS, // 
+};
+
+#if defined(LEXER_USE_AVX2)
+typedef __m256i SimdVector;
+const size_t SIMD_WIDTH = 32;
+static inline SimdVector simdLoad(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+static inline SimdVector simdSet(char c) { return _mm256_set1_epi8(c); }
+static inline SimdVector simdEqual(SimdVector a, SimdVector b) { return _mm256_cmpeq_epi8(a, b); }
+static inline SimdVector simdGreater(SimdVector a, SimdVector b) { return _mm256_cmpgt_epi8(a, b); }
+static inline SimdVector simdAnd(SimdVector a, SimdVector b) { return _mm256_and_si256(a, b); }
+static inline SimdVector simdOr(SimdVector a, SimdVector b) { return _mm256_or_si256(a, b); }
+static inline uint32_t simdMask(SimdVector a) { return static_cast<uint32_t>(_mm256_movemask_epi8(a)); }
+#elif defined(LEXER_USE_SSE2)
+typedef __m128i SimdVector;
+const size_t SIMD_WIDTH = 16;
+static inline SimdVector simdLoad(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+static inline SimdVector simdSet(char c) { return _mm_set1_epi8(c); }
+static inline SimdVector simdEqual(SimdVector a, SimdVector b) { return _mm_cmpeq_epi8(a, b); }
+static inline SimdVector simdGreater(SimdVector a, SimdVector b) { return _mm_cmpgt_epi8(a, b); }
+static inline SimdVector simdAnd(SimdVector a, SimdVector b) { return _mm_and_si128(a, b); }
+static inline SimdVector simdOr(SimdVector a, SimdVector b) { return _mm_or_si128(a, b); }
+static inline uint32_t simdMask(SimdVector a) { return static_cast<uint32_t>(_mm_movemask_epi8(a)) | 0xFFFF0000u; }
+#endif
+
+#if defined(LEXER_USE_AVX2) || defined(LEXER_USE_SSE2)
+// ֽڰзȽϣ0x80ϵֽΪκ
+static inline SimdVector inRange(SimdVector v, char low, char high) {
+    return simdAnd(simdGreater(v, simdSet(low - 1)), simdGreater(simdSet(high + 1), v));
+}
+
+static inline uint32_t classMask(SimdVector v, RunClass runClass) {
+    switch (runClass) {
+        case RunClass::SPACES:
+            return simdMask(simdOr(simdEqual(v, simdSet(' ')), simdEqual(v, simdSet('\t'))));
+        case RunClass::ALNUMS:
+            return simdMask(simdOr(inRange(simdOr(v, simdSet(0x20)), 'a', 'z'), inRange(v, '0', '9')));
+        case RunClass::DIGITS:
+        default:
+            return simdMask(inRange(v, '0', '9'));
+    }
+}
+#endif
+
+static inline bool inClass(char c, RunClass runClass) {
+    CharType type = check(c);
+    switch (runClass) {
+        case RunClass::SPACES: return type == CharType::SPACE;
+        case RunClass::ALNUMS: return type == CharType::LETTER || type == CharType::DIGIT;
+        case RunClass::DIGITS:
+        default: return type == CharType::DIGIT;
+    }
+}
+
+static inline const char* scanRun(const char* p, const char* end, RunClass runClass) {
+#if defined(LEXER_USE_AVX2) || defined(LEXER_USE_SSE2)
+    while (static_cast<size_t>(end - p) >= SIMD_WIDTH) {
+        uint32_t outside = ~classMask(simdLoad(p), runClass);
+        if (outside != 0) {
+            return p + __builtin_ctz(outside);
         }
+        p += SIMD_WIDTH;
     }
+#endif
+    while (p < end && inClass(*p, runClass)) ++p;
+    return p;
 }
 
-std::string format(const std::string& key, const std::string& type) {
-    std::stringstream ss;
-    ss << std::setw(KEY_FORMAT_LENGTH) << std::right << key << " " << type;
-    return ss.str();
+const char* scanSpaces(const char* p, const char* end) {
+    return scanRun(p, end, RunClass::SPACES);
 }
 
-void handleWord(std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile) {
+const char* scanAlnums(const char* p, const char* end) {
+    return scanRun(p, end, RunClass::ALNUMS);
+}
+
+const char* scanDigits(const char* p, const char* end) {
+    return scanRun(p, end, RunClass::DIGITS);
+}
+
+void error(ErrorType type, LexerContext& context) {
+    size_t column = static_cast<size_t>(context.currentChar - context.lineStart) + 1;
+    context.diagnostics->report(type, context.currentline, column);
+}
+
+void wordError(ErrorType type, LexerContext& context) {
+    size_t column = static_cast<size_t>(context.wordStart - context.lineStart) + 1;
+    context.diagnostics->report(type, context.currentline, column);
+}
+
+size_t formatRecord(const char* key, size_t keyLength, const std::string& type, char* out) {
+    // Ҷ뵽KEY_FORMAT_LENGTHУʱԭ setw(16) << right Чһ
+    size_t pad = keyLength < KEY_FORMAT_LENGTH ? KEY_FORMAT_LENGTH - keyLength : 0;
+    std::memset(out, ' ', pad);
+    std::memcpy(out + pad, key, keyLength);
+    size_t length = pad + keyLength;
+    out[length++] = ' ';
+    std::memcpy(out + length, type.data(), type.size());
+    return length + type.size();
+}
+
+void emitToken(const char* key, size_t keyLength, TokenKind kind, LexerContext& context) {
+    size_t column = static_cast<size_t>(context.wordStart - context.lineStart) + 1;
+    context.tokens->append(key, keyLength, kind, static_cast<uint32_t>(context.currentline), column);
+    if (context.ring != nullptr && context.tokens->tokens.size() >= context.ring->batchSize) {
+        submitBatch(context);
+    }
+}
+
+void submitBatch(LexerContext& context) {
+    if (context.dydOutput != nullptr) {
+        appendDydRecords(context.tokens->view(), *context.dydOutput, context.dydLine, context.dydBuffer);
+    }
+    context.submitted += context.tokens->tokens.size();
+    context.ring->commitPush();
+    context.tokens = &context.ring->beginPush();
+}
+
+// ʵĵһַλΪԪк
+static inline void startWord(const char* p, LexerContext& context) {
+    if (context.word.empty()) context.wordStart = p;
+}
+
+void handleWord(LexerContext& context) {
+    std::string& word = context.word;
     if (word.length() == 0) return;
     if (word.length() > KEY_FORMAT_LENGTH) {
-        error(ErrorType::IDENTIFIER_TOO_LONG, outErrorFile);
+        wordError(ErrorType::IDENTIFIER_TOO_LONG, context);
         word.clear();
         return;
     }
-    auto it = tokentable.find(word);
-    if (it != tokentable.end()) {
-        std::string key = it->first;
-        std::string type = it->second;
-        if (key.compare("EOF") == 0) {
-            outTargetFile << format(key, type);
-        } else {
-            outTargetFile << format(key, type) << std::endl;
-        }
+    TokenKind kind;
+    if (lookupKeyword(word.data(), word.length(), kind)) {
+        emitToken(word.data(), word.length(), kind, context);
+    } else if (check(word[0]) == CharType::DIGIT) {
+        emitToken(word.data(), word.length(), TokenKind::CONSTANT, context);
     } else if (word[0] != ':') {
-        std::string type = tokentable.find("identifier")->second;
-        std::string key = word;
-        outTargetFile << format(key, type) << std::endl;
+        emitToken(word.data(), word.length(), TokenKind::IDENTIFIER, context);
     } else {
-        error(ErrorType::MISSING_EQUAL_AFTER_COLON, outErrorFile);
+        wordError(ErrorType::MISSING_EQUAL_AFTER_COLON, context);
     }
     word.clear();
 }
 
-void handleSpace(std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState) {
-    if (currentState != State::INITIAL) {
-        handleWord(word, outTargetFile, outErrorFile);
-        currentState = State::INITIAL;
+void handleSpace(LexerContext& context) {
+    if (context.currentState != State::INITIAL) {
+        handleWord(context);
+        context.currentState = State::INITIAL;
     }
 }
 
-void handleLetter(char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState) {
-    if (currentState == State::IN_NUMBER) {
-        error(ErrorType::INVALID_SYMBOL, outErrorFile);
-        word.clear();
-        currentState = State::INITIAL;
-    } else if (currentState != State::INITIAL && currentState != State::IN_WORD) {
-        handleWord(word, outTargetFile, outErrorFile);
+void handleLetter(const char*& p, const char* end, LexerContext& context) {
+    if (context.currentState == State::IN_NUMBER) {
+        wordError(ErrorType::INVALID_SYMBOL, context);
+        context.word.clear();
+        context.currentState = State::INITIAL;
+    } else if (context.currentState != State::INITIAL && context.currentState != State::IN_WORD) {
+        handleWord(context);
     }
-    word += c;
-    currentState = State::IN_WORD;
+    // ʶĸͷĸһɨ
+    const char* stop = scanAlnums(p + 1, end);
+    startWord(p, context);
+    context.word.append(p, stop);
+    p = stop - 1;
+    context.currentState = State::IN_WORD;
 }
 
-void handleDigit(char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState) {
-    if (currentState == State::INITIAL) {
-        word += c;
-        currentState = State::IN_NUMBER;
-    } else if (currentState == State::IN_NUMBER || currentState == State::IN_WORD) {
-        word += c;
-    } else {
-        handleWord(word, outTargetFile, outErrorFile);
-        word += c;
-        currentState = State::IN_NUMBER;
+void handleDigit(const char*& p, const char* end, LexerContext& context) {
+    if (context.currentState == State::IN_WORD) {
+        // ʶе֣ͺĸһʶ
+        const char* stop = scanAlnums(p + 1, end);
+        context.word.append(p, stop);
+        p = stop - 1;
+        return;
+    }
+    if (context.currentState != State::INITIAL && context.currentState != State::IN_NUMBER) {
+        handleWord(context);
     }
+    const char* stop = scanDigits(p + 1, end);
+    startWord(p, context);
+    context.word.append(p, stop);
+    p = stop - 1;
+    context.currentState = State::IN_NUMBER;
 }
 
-void handleEqual(char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState) {
+void handleEqual(char c, LexerContext& context) {
+    State currentState = context.currentState;
     if (currentState != State::INITIAL && currentState != State::AFTER_LESS_THAN
         && currentState != State::AFTER_GREATER_THAN && currentState != State::AFTER_COLON) {
-        handleWord(word, outTargetFile, outErrorFile);
-        word += c;
-        currentState = State::AFTER_EQUALS;
+        handleWord(context);
+        startWord(context.currentChar, context);
+        context.word += c;
+        context.currentState = State::AFTER_EQUALS;
     } else {
-        word += c;
-        handleWord(word, outTargetFile, outErrorFile);
-        currentState = State::INITIAL;
+        startWord(context.currentChar, context);
+        context.word += c;
+        handleWord(context);
+        context.currentState = State::INITIAL;
     }
 }
 
-void normalhandle(CharType type, char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState) {
-    handleWord(word, outTargetFile, outErrorFile);
-    word += c;
+void normalhandle(CharType type, char c, LexerContext& context) {
+    handleWord(context);
+    startWord(context.currentChar, context);
+    context.word += c;
     if (type == CharType::MINUS_SIGN) {
-        currentState = State::AFTER_MINUS;
+        context.currentState = State::AFTER_MINUS;
     } else if (type == CharType::MULTIPLY_SIGN) {
-        currentState = State::AFTER_MULTIPLY;
+        context.currentState = State::AFTER_MULTIPLY;
     } else if (type == CharType::LEFT_PAREN) {
-        currentState = State::AFTER_LEFT_PAREN;
+        context.currentState = State::AFTER_LEFT_PAREN;
     } else if (type == CharType::RIGHT_PAREN) {
-        currentState = State::AFTER_RIGHT_PAREN;
+        context.currentState = State::AFTER_RIGHT_PAREN;
     } else if (type == CharType::LESS_THAN) {
-        currentState = State::AFTER_LESS_THAN;
+        context.currentState = State::AFTER_LESS_THAN;
     } else if (type == CharType::COLON) {
-        currentState = State::AFTER_COLON;
+        context.currentState = State::AFTER_COLON;
     } else if (type == CharType::SEMICOLON){
-        currentState = State::AFTER_SEMICOLON;
+        context.currentState = State::AFTER_SEMICOLON;
     }
 }
 
-void handleGreaterThan(char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState) {
-    if (currentState == State::AFTER_LESS_THAN) {
-        word += c;
-        handleWord(word, outTargetFile, outErrorFile);
-        currentState = State::INITIAL;
+void handleGreaterThan(char c, LexerContext& context) {
+    if (context.currentState == State::AFTER_LESS_THAN) {
+        context.word += c;
+        handleWord(context);
+        context.currentState = State::INITIAL;
     }
     else {
-        handleWord(word, outTargetFile, outErrorFile);
-        word += c;
-        currentState = State::AFTER_GREATER_THAN;
+        handleWord(context);
+        startWord(context.currentChar, context);
+        context.word += c;
+        context.currentState = State::AFTER_GREATER_THAN;
     }
 }
 
-void handleNewLine(char c, std::string& word, std::ifstream& infile, std::ofstream& outTargetFile, std::ofstream& outErrorFile) {
-    handleWord(word, outTargetFile, outErrorFile);
-    word = "EOLN";
-    handleWord(word, outTargetFile, outErrorFile);
-    currentline++;
-    if (c == '\r')
-        infile >> std::noskipws >> c;
+void handleNewLine(const char*& p, const char* end, LexerContext& context) {
+    // вԪ֮ĵԪкżһ
+    handleWord(context);
+    context.currentState = State::INITIAL;
+    context.currentline++;
+    // \r\n ΪһУֱڻһַ
+    if (*p == '\r' && p + 1 < end && p[1] == '\n')
+        ++p;
+    context.lineStart = p + 1;
 }
 
-void generateDydFile(std::string sourceFileName) {
-    std::ifstream infile;
-    infile.open(sourceFileName.data(), std::ios::binary);
-    assert(infile.is_open());
-    
-    std::ofstream outTargetFile, outErrorFile;
-    outTargetFile.open(targetFileName.data(), std::ios::out);
-    outErrorFile.open(errorFileName.data(), std::ios::out);
-    assert(outTargetFile.is_open());
-    assert(outErrorFile.is_open());
+// Դʱ󲢵ճʵҪɨĳ
+static size_t checkSourceSize(size_t size, Diagnostics& diagnostics) {
+    if (size <= MAX_SOURCE_SIZE) return size;
+    diagnostics.report(ErrorType::SOURCE_TOO_LARGE, 1, 0, std::to_string(size));
+    return 0;
+}
 
-    std::string word;
-    char c;
-    State currentState = State::INITIAL;
+// ɨѭԪʽcontext
+static void scan(const char* data, size_t size, LexerContext& context) {
+    context.lineStart = data;
+    const char* end = data + size;
 
-    while (infile >> std::noskipws >> c) {
+    for (const char* p = data; p < end; ++p) {
+        char c = *p;
+        context.currentChar = p;
         CharType type = check(c);
         switch (type) {
             case CharType::SPACE: {
-                handleSpace(word, outTargetFile, outErrorFile, currentState);
+                handleSpace(context);
+                // Ŀհףһ
+                p = scanSpaces(p + 1, end) - 1;
                 break;
             }
             case CharType::LETTER: {
-                handleLetter(c, word, outTargetFile, outErrorFile, currentState);
+                handleLetter(p, end, context);
                 break;
             }
             case CharType::DIGIT: {
-                handleDigit(c, word, outTargetFile, outErrorFile, currentState);
+                handleDigit(p, end, context);
                 break;
             }
             case CharType::EQUALS_SIGN: {
-                handleEqual(c, word, outTargetFile, outErrorFile, currentState);
+                handleEqual(c, context);
                 break;
             }
             case CharType::MINUS_SIGN:
@@ -242,37 +535,165 @@ void generateDydFile(std::string sourceFileName) {
             case CharType::LESS_THAN:
             case CharType::COLON:
             case CharType::SEMICOLON: {
-                normalhandle(type, c, word, outTargetFile, outErrorFile, currentState);
+                normalhandle(type, c, context);
                 break;
             }
             case CharType::GREATER_THAN: {
-                handleGreaterThan(c, word, outTargetFile, outErrorFile, currentState);
+                handleGreaterThan(c, context);
                 break;
             }
             case CharType::NEW_LINE: {
-                handleNewLine(c, word, infile, outTargetFile, outErrorFile);
+                handleNewLine(p, end, context);
                 break;
             }
             case CharType::OTHERS: {
-                error(ErrorType::INVALID_SYMBOL, outErrorFile);
+                error(ErrorType::INVALID_SYMBOL, context);
                 break;
             }
         }
     }
-    word = "EOF";
-    handleWord(word, outTargetFile, outErrorFile);
-    infile.close();
-    outTargetFile.close();
-    outErrorFile.close();
+    handleWord(context);
 }
 
-int lexical_analyzer(std::string sourceFileName) {
-	targetFileName = sourceFileName.substr(0, sourceFileName.find_last_of(".")) + ".dyd";
-	errorFileName = "lexicalError.err";
+void tokenize(const char* data, size_t size, TokenBuffer& tokens, Diagnostics& diagnostics) {
+    LexerContext context;
+    context.tokens = &tokens;
+    context.diagnostics = &diagnostics;
+    size = checkSourceSize(size, diagnostics);
+    scan(data, size, context);
+    context.wordStart = data + size;
+    emitToken("EOF", 3, TokenKind::END_OF_FILE, context);
+}
 
-	initTokenTable();
-    initcharTypeTable();
-	generateDydFile(sourceFileName);
+void tokenizeLines(const char* data, size_t size, size_t firstLine, TokenBuffer& tokens, Diagnostics& diagnostics) {
+    LexerContext context;
+    context.tokens = &tokens;
+    context.diagnostics = &diagnostics;
+    context.currentline = firstLine;
+    scan(data, size, context);
+}
 
-	return 0;
-}
\ No newline at end of file
+TokenizeSummary tokenize(const char* data, size_t size, TokenRing& ring, Diagnostics& diagnostics, std::ofstream* dydOutput) {
+    LexerContext context;
+    context.ring = &ring;
+    context.dydOutput = dydOutput;
+    context.diagnostics = &diagnostics;
+    context.tokens = &ring.beginPush();
+    size = checkSourceSize(size, diagnostics);
+    scan(data, size, context);
+    context.wordStart = data + size;
+    emitToken("EOF", 3, TokenKind::END_OF_FILE, context);
+    // һύEOFǡһʱύ
+    if (!context.tokens->tokens.empty()) {
+        if (dydOutput != nullptr) {
+            appendDydRecords(context.tokens->view(), *dydOutput, context.dydLine, context.dydBuffer);
+        }
+        context.submitted += context.tokens->tokens.size();
+        ring.commitPush();
+    }
+    ring.close();
+    TokenizeSummary summary;
+    summary.tokens = context.submitted;
+    summary.lines = context.currentline;
+    return summary;
+}
+
+bool generateDydFile(const std::string& sourceFileName, TokenBuffer& tokens, Diagnostics& diagnostics, const std::string& targetFileName) {
+    SourceBuffer source;
+    if (!openSourceBuffer(sourceFileName, source)) {
+        std::cerr << "Could not open the file - '" << sourceFileName << "'" << std::endl;
+        return false;
+    }
+    tokenize(source.data, source.size, tokens, diagnostics);
+    closeSourceBuffer(source);
+    if (!targetFileName.empty()) {
+        return saveDydFile(tokens.view(), targetFileName);
+    }
+    return true;
+}
+
+bool loadDydFile(const std::string& dydFileName, TokenBuffer& tokenList) {
+    std::ifstream input(dydFileName);
+    if (!input.is_open()) {
+        std::cerr << "Could not open the file - '" << dydFileName << "'" << std::endl;
+        return false;
+    }
+    // ÿΪҶĵʺλֱ룬հзּ
+    std::string line, key, type;
+    uint32_t lineNumber = 1;
+    while (getline(input, line)) {
+        std::istringstream iss(line);
+        while (iss >> key) {
+            if (!(iss >> type)) {
+                std::cerr << "Token list has an odd number of elements." << std::endl;
+                return false;
+            }
+            int code = std::atoi(type.c_str());
+            if (code < static_cast<int>(TokenKind::BEGIN) || code > static_cast<int>(TokenKind::END_OF_FILE)
+                || key.size() > UINT8_MAX) {
+                std::cerr << "Unknown token type '" << type << "'." << std::endl;
+                return false;
+            }
+            // Ԫ͵ʳصλö32λ
+            if (tokenList.tokens.size() >= UINT32_MAX || tokenList.pool.size() + key.size() > UINT32_MAX) {
+                std::cerr << "Token list is too large." << std::endl;
+                return false;
+            }
+            TokenKind kind = static_cast<TokenKind>(code);
+            if (kind == TokenKind::EOLN) {
+                ++lineNumber;
+                continue;
+            }
+            tokenList.append(key.data(), key.size(), kind, lineNumber, 0);
+        }
+    }
+    return true;
+}
+
+void appendDydRecords(const TokenView& tokens, std::ofstream& output, uint32_t& line, std::vector<char>& buffer) {
+    static const std::string& eolnType = tokenCode(TokenKind::EOLN);
+    if (buffer.size() < DYD_BUFFER_SIZE) buffer.resize(DYD_BUFFER_SIZE);
+    size_t used = 0;
+    for (size_t i = 0; i < tokens.count; ++i) {
+        const Token& token = tokens.tokens[i];
+        // кÿһУԭĵԪоһEOLN
+        for (; line < token.line; ++line) {
+            if (used + KEY_FORMAT_LENGTH + eolnType.size() + 2 > buffer.size()) {
+                output.write(buffer.data(), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+            used += formatRecord("EOLN", 4, eolnType, buffer.data() + used);
+            buffer[used++] = '\n';
+        }
+        const std::string& type = tokenCode(token.kind);
+        size_t recordLength = std::max(static_cast<size_t>(token.length), static_cast<size_t>(KEY_FORMAT_LENGTH)) + type.size() + 2;
+        if (used + recordLength > buffer.size()) {
+            output.write(buffer.data(), static_cast<std::streamsize>(used));
+            used = 0;
+            if (recordLength > buffer.size()) buffer.resize(recordLength);
+        }
+        used += formatRecord(tokens.pool + token.offset, token.length, type, buffer.data() + used);
+        if (token.kind != TokenKind::END_OF_FILE) buffer[used++] = '\n';
+    }
+    output.write(buffer.data(), static_cast<std::streamsize>(used));
+}
+
+bool saveDydFile(const TokenView& tokens, const std::string& dydFileName) {
+    std::ofstream output(dydFileName, std::ios::out);
+    if (!output.is_open()) {
+        std::cerr << "Could not open the file - '" << dydFileName << "'" << std::endl;
+        return false;
+    }
+    uint32_t line = 1;
+    std::vector<char> buffer;
+    appendDydRecords(tokens, output, line, buffer);
+    return true;
+}
+
+int lexical_analyzer(std::string sourceFileName, TokenBuffer& tokenList, Diagnostics& diagnostics, bool writeDyd) {
+	std::string targetFileName;
+	if (writeDyd) {
+		targetFileName = sourceFileName.substr(0, sourceFileName.find_last_of(".")) + ".dyd";
+	}
+	return generateDydFile(sourceFileName, tokenList, diagnostics, targetFileName) ? 0 : -1;
+}
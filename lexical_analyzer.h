@@ -2,10 +2,16 @@
 #define LEXICAL_ANALYZER_H
 
 #include <string>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <iosfwd>
+#include "diagnostics.h"
 
 // ַ
 enum class CharType {
-    SPACE, // ո
+    SPACE, // ոƱ
     LETTER, // ĸ
     DIGIT, // 
     EQUALS_SIGN, // =
@@ -21,13 +27,6 @@ enum class CharType {
     OTHERS,
 };
 
-// 
-enum class ErrorType {
-    INVALID_SYMBOL, // Ϸıʶ
-    IDENTIFIER_TOO_LONG, // ʶ
-    MISSING_EQUAL_AFTER_COLON, // ðŲƥ
-};
-
 // ״̬
 enum class State {
     INITIAL, // ʼ̬
@@ -73,49 +72,206 @@ namespace TokenType {
     const std::string END_OF_FILE = "25";
 };
 
-// ʼַͲұñȷַ
-void initcharTypeTable();
+// ֱʾֱֵһһӦ﷨
+enum class TokenKind : unsigned char {
+    BEGIN = 1,
+    END,
+    INTEGER,
+    IF,
+    THEN,
+    ELSE,
+    FUNCTION,
+    READ,
+    WRITE,
+    IDENTIFIER,
+    CONSTANT,
+    EQUALS,
+    NOT_EQUALS,
+    LESS_OR_EQUALS,
+    LESS,
+    GREATER_OR_EQUALS,
+    GREATER,
+    MINUS,
+    MULTIPLY,
+    ASSIGN,
+    OPEN_PAREN,
+    CLOSE_PAREN,
+    SEMICOLON,
+    EOLN,
+    END_OF_FILE,
+};
+
+// ʷԪֱڵкԼڵʳеλã12ֽڣƵԪļеļ¼ͬ
+// вΪԪֻڸԪкϣд.dydʱкŵı仯EOLN
+struct Token {
+    TokenKind kind; // ֱ
+    uint8_t length; // ʳȣʷĵʲ16ַ
+    uint16_t column; // У1ʼֽڼƣΧʱΪֵ.dydʱΪ0ʾδ֪
+    uint32_t line; // 
+    uint32_t offset; // ڵʳеʼλ
+};
+
+// Ԫкšʳеλú͵Ԫ32λģԴ򲻵óóȣԼ4 GB
+// λûƣʳػҪ¹̶ƴдһЩ
+const size_t MAX_SOURCE_SIZE = 0xFFFFF000u;
+
+// ֱӦλֱַ.dyd
+const std::string& tokenCode(TokenKind kind);
+
+// ֡EOLNEOFĹ̶ƴдʶͳnullptr
+const char* tokenSpelling(TokenKind kind);
+
+// ֻĴʷԪУԪӵʳأָTokenBufferҲֱָӳڴĶƵԪļ
+struct TokenView {
+    const Token* tokens = nullptr; // Ԫ
+    size_t count = 0; // Ԫ
+    const char* pool = nullptr; // ʳ
+
+    // iԪĵ
+    std::string lexeme(size_t i) const {
+        return std::string(pool + tokens[i].offset, tokens[i].length);
+    }
+};
+
+// ʷĽԪ͵ʳءֵȹ̶ƴдԤȷڳףֻбʶͳ׷ӵ
+struct TokenBuffer {
+    std::vector<Token> tokens; // Ԫ
+    std::string pool; // ʳ
+
+    TokenBuffer();
+
+    // յԪ͵ʳأѷظʹ
+    void clear();
+
+    // ׷һԪcolumnΪ0ʾкδ֪
+    void append(const char* text, size_t length, TokenKind kind, uint32_t line, size_t column);
+
+    TokenView view() const {
+        TokenView v;
+        v.tokens = tokens.data();
+        v.count = tokens.size();
+        v.pool = pool.data();
+        return v;
+    }
+};
+
+// Դļ뻺ļڴʽṩ״̬ɨ
+struct SourceBuffer {
+    const char* data = nullptr; // ļ׵ַ
+    size_t size = 0; // ļ
+    bool mapped = false; // trueΪmmapӳ䣬falseΪֿĶڴ
+};
 
-// ʼֱձ
-void initTokenTable();
+// Դļֻmmapļ֧ʱڴ
+bool openSourceBuffer(const std::string& fileName, SourceBuffer& buffer);
+
+// ͷԴļ
+void closeSourceBuffer(SourceBuffer& buffer);
+
+class TokenRing;
+
+// ʷȫɱ״̬ÿηһ˶߳̿ͬʱͬԴ
+struct LexerContext {
+    std::string word; // ƴӵĵ
+    State currentState = State::INITIAL;
+    TokenBuffer* tokens = nullptr; // ĶԪʽбˮ߷ʽǻζдһ
+    TokenRing* ring = nullptr; // Ϊnullptrʱύζ
+    std::ofstream* dydOutput = nullptr; // ˮ߷ʽÿύǰд.dydļ
+    std::vector<char> dydBuffer; // ˮ߷ʽ¸õ.dydʽ
+    uint32_t dydLine = 1; // ˮ߷ʽ.dydдУһݴ˲
+    Diagnostics* diagnostics = nullptr; // ʷռ
+    size_t currentline = 1;
+    const char* lineStart = nullptr; // ǰַλãڼк
+    const char* currentChar = nullptr; // ڴַλ
+    const char* wordStart = nullptr; // ƴӵĵʵַλãΪԪк
+    size_t submitted = 0; // ˮ߷ʽύζеĵԪ
+};
+
+// ˮ߷ʽɨԪѽ﷨̣߳ٱֻ
+struct TokenizeSummary {
+    size_t tokens = 0; // ԪEOF
+    size_t lines = 0; // EOFڵУԴ
+};
+
+// ַͲұñȷַ
+std::array<CharType, 256> makeCharTypeTable();
+
+// ʶֺͨkindֱ𣻷򷵻falseɵ߰ʶ
+bool lookupKeyword(const char* s, size_t length, TokenKind& kind);
 
 // 鲢ַc
 CharType check(char c);
 
-// 
-void error(ErrorType type, std::ofstream& outErrorFile);
+// pʼɨĿհסĸֻ֣صһڸַλãend
+const char* scanSpaces(const char* p, const char* end);
+const char* scanAlnums(const char* p, const char* end);
+const char* scanDigits(const char* p, const char* end);
+
+// ¼ϢռУкȡǰַλ
+void error(ErrorType type, LexerContext& context);
 
-// ʽַ
-std::string format(const std::string& key, const std::string& type);
+// ʵĴ󣨱ʶðšֺĸкȡʵĵһַ
+void wordError(ErrorType type, LexerContext& context);
+
+// һԪʽʽҶ16Сոֱ룩дoutдֽд
+size_t formatRecord(const char* key, size_t keyLength, const std::string& type, char* out);
+
+// һԪʽ׷ӵڴеĴʷԪбˮ߷ʽһдύ
+void emitToken(const char* key, size_t keyLength, TokenKind kind, LexerContext& context);
+
+// ύдһζУҪʱд.dydļȻȡһղ
+void submitBatch(LexerContext& context);
 
 // 
-void handleWord(std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile);
+void handleWord(LexerContext& context);
 
 // ո
-void handleSpace(std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState);
+void handleSpace(LexerContext& context);
 
-// ĸ
-void handleLetter(char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState);
+// ĸpָǰַʱָɨ赥ʵһַ
+void handleLetter(const char*& p, const char* end, LexerContext& context);
 
-// 
-void handleDigit(char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState);
+// ֣pָǰַʱָɨ赥ʵһַ
+void handleDigit(const char*& p, const char* end, LexerContext& context);
 
 //  =
-void handleEqual(char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState);
+void handleEqual(char c, LexerContext& context);
 
 // ͨôhandleWord
-void normalhandle(CharType type, char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState);
+void normalhandle(CharType type, char c, LexerContext& context);
 
 //  >
-void handleGreaterThan(char c, std::string& word, std::ofstream& outTargetFile, std::ofstream& outErrorFile, State& currentState);
+void handleGreaterThan(char c, LexerContext& context);
 
 // 
-void handleNewLine(char c, std::string& word, std::ifstream& infile, std::ofstream& outTargetFile, std::ofstream& outErrorFile);
+void handleNewLine(const char*& p, const char* end, LexerContext& context);
+
+// ɨڴеԴɶԪʽ׷ӵtokensдκļ
+// Դ򳬹MAX_SOURCE_SIZEʱSOURCE_TOO_LARGEֻEOF
+void tokenize(const char* data, size_t size, TokenBuffer& tokens, Diagnostics& diagnostics);
+
+// ֻɨУĩβEOFкŴfirstLineʼɨ
+void tokenizeLines(const char* data, size_t size, size_t firstLine, TokenBuffer& tokens, Diagnostics& diagnostics);
+
+// ˮ߷ʽɨڴеԴ򣬶Ԫʽringһ̵߳﷨ȡ
+// dydOutputΪnullptrʱͬʱд.dydļʱرringصԪ
+TokenizeSummary tokenize(const char* data, size_t size, TokenRing& ring, Diagnostics& diagnostics, std::ofstream* dydOutput = nullptr);
+
+// ɨԴļɶԪʽtargetFileNameǿʱд.dydļļ򲻿ʱfalse
+bool generateDydFile(const std::string& sourceFileName, TokenBuffer& tokens, Diagnostics& diagnostics, const std::string& targetFileName);
+
+// ȡе.dydļԭԪʽбEOLNбֻԪкţкżΪ0
+bool loadDydFile(const std::string& dydFileName, TokenBuffer& tokenList);
+
+// һζԪʽ.dydıʽ׷ӵѴ򿪵ļEOF֮󲻻С
+// lineдУԪкűʱȲӦEOLNʱΪһԪС
+// bufferǸʽõĻεʱͬһظʹãֻڵ¼Ųʱ
+void appendDydRecords(const TokenView& tokens, std::ofstream& output, uint32_t& line, std::vector<char>& buffer);
 
-// .dydļ
-void generateDydFile(std::string sourceFileName);
+// ѶԪʽб.dydıʽд
+bool saveDydFile(const TokenView& tokens, const std::string& dydFileName);
 
-// ʷغ
-int lexical_analyzer(std::string sourceFileName);
+// ʷغԪʽֱӴtokenList﷨writeDydΪtrueʱ.dydļʧʱ-1
+int lexical_analyzer(std::string sourceFileName, TokenBuffer& tokenList, Diagnostics& diagnostics, bool writeDyd = false);
 
 #endif
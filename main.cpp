@@ -2,66 +2,687 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <cstdlib>
+#include <cstdint>
+#include <thread>
 #include "lexical_analyzer.h"
 #include "grammar_analyzer.h"
+#include "token_file.h"
+#include "token_stream.h"
+#include "ast.h"
+#include "code_generator.h"
+#include "virtual_machine.h"
+#include "jit_compiler.h"
+#include "optimizer.h"
+#include "program_generator.h"
+#include "benchmark.h"
+#include "phase_profiler.h"
+#include "allocation_tracker.h"
+#include "compile_server.h"
+#include "compile_cache.h"
+
+const std::string varPath = "variableList.var";
+const std::string proPath = "processList.pro";
+const std::string lexErrFile = "lexicalError.err";
+const std::string errFile = "grammarError.err";
+
+// ˮ߷ʽʷ߳ϰѵԪ뻷ζУ﷨ڵǰ߳ͬʱȡ
+int compilePipelined(const std::string& sourceFileName, const std::string& baseName, bool writeDyd, size_t maxErrors, 
+    bool columns, PhaseProfiler& profiler) 
+{
+    SourceBuffer source;
+    if (!openSourceBuffer(sourceFileName, source)) 
+    {
+        std::cerr << "Could not open the file - '" << sourceFileName << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::ofstream dydOutput;
+    if (writeDyd) 
+    {
+        dydOutput.open(baseName + ".dyd", std::ios::out);
+        if (!dydOutput.is_open()) 
+        {
+            std::cerr << "Could not open the file - '" << baseName << ".dyd'" << std::endl;
+            closeSourceBuffer(source);
+            return EXIT_FAILURE;
+        }
+    }
+
+    profiler.begin("pipeline");
+    TokenRing ring;
+    Diagnostics lexicalDiagnostics(lexErrFile, maxErrors, columns);
+    TokenizeSummary scanned;
+    std::thread lexer([&]() 
+    {
+        setAllocationPhase(AllocationPhase::LEXER);
+        scanned = tokenize(source.data, source.size, ring, lexicalDiagnostics, writeDyd ? &dydOutput : nullptr);
+    });
+
+    setAllocationPhase(AllocationPhase::PARSER);
+    Diagnostics grammarDiagnostics(errFile, maxErrors, columns);
+    GrammarAnalyzer analyzer(ring, grammarDiagnostics);
+    analyzer.parseProgram(); // һŷأʱʷ߳ڽ
+    lexer.join();
+    profiler.end();
+    closeSourceBuffer(source);
+
+    setAllocationPhase(AllocationPhase::WRITER);
+    lexicalDiagnostics.flush();
+    grammarDiagnostics.flush();
+    // ˮ߷ʽ浥ԪбԪɴʷ̷߳
+    profiler.count("tokens", scanned.tokens);
+    profiler.count("lines", scanned.lines);
+    profiler.count("symbols", analyzer.getVarList().size() + analyzer.getProList().size());
+    profiler.count("lexical_errors", lexicalDiagnostics.count());
+    profiler.count("grammar_errors", grammarDiagnostics.count());
+    if (analyzer.isStopped()) 
+    {
+        profiler.report(std::cerr);
+        return -1;
+    }
+    profiler.begin("print");
+    analyzer.printFiles(varPath, proPath);
+    profiler.end();
+    setAllocationPhase(AllocationPhase::OTHER);
+    profiler.report(std::cerr);
+    return 0;
+}
+
+// гѡ
+struct RunOptions
+{
+    bool showStatistics = false; // ִеָôÿ
+    bool useJit = false; // Ϊشִ
+    OptimizerOptions optimizer; // ΪֽǰŻ
+    bool showOptimizerStatistics = false; // Żͳ
+    bool memoize = false; // ĵýʵλ
+    size_t memoCapacity = MemoTable::DEFAULT_CAPACITY; // ౣĽ
+};
+
+// ﷨Ϊֽ벢Уӱ׼ȡд׼
+// ͳϢ׼ŻԭͨɵļУ½arena
+int runProgram(const Program* program, Arena& arena, const TokenView& tokens, const GrammarAnalyzer& analyzer, 
+    const RunOptions& options) 
+{
+    Diagnostics semanticDiagnostics;
+    BytecodeProgram bytecode;
+    if (program == nullptr || 
+        !generateBytecode(*program, tokens, analyzer.getVarList(), analyzer.getProList(), semanticDiagnostics, bytecode)) 
+    {
+        std::cerr << semanticDiagnostics.text();
+        return EXIT_FAILURE;
+    }
+    size_t before = bytecode.code.size();
+    OptimizerStatistics optimizerStatistics;
+    if (options.optimizer.any()) 
+    {
+        program = optimizeProgram(*program, analyzer.getVarList().size(), arena, options.optimizer, optimizerStatistics);
+    }
+    std::vector<bool> memoized;
+    size_t memoizedCount = 0;
+    if (options.memoize) 
+    {
+        memoized = findPureFunctions(*program);
+        for (size_t i = 0; i < memoized.size(); ++i) 
+        {
+            if (memoized[i]) ++memoizedCount;
+        }
+    }
+    if (options.optimizer.any() && (memoizedCount == 0 || options.showOptimizerStatistics)) 
+    {
+        // ȲӻָһΣͳŻָֻӳŻ
+        generateBytecode(*program, tokens, analyzer.getVarList(), analyzer.getProList(), semanticDiagnostics, bytecode);
+    }
+    size_t optimized = bytecode.code.size();
+    if (memoizedCount > 0) 
+    {
+        generateBytecode(*program, tokens, analyzer.getVarList(), analyzer.getProList(), semanticDiagnostics, bytecode, 
+            &memoized);
+    }
+    if (options.showOptimizerStatistics) 
+    {
+        optimizerStatistics.print(std::cerr);
+        std::cerr << "bytecode: " << before << " -> " << optimized << " instructions" << std::endl;
+        if (memoizedCount > 0) 
+        {
+            std::cerr << "memo: " << memoizedCount << " functions, " << optimized << " -> " << bytecode.code.size() 
+                << " instructions" << std::endl;
+        }
+    }
+
+    MemoTable memo(options.memoCapacity);
+    MemoTable* table = memoizedCount > 0 ? &memo : nullptr;
+
+    RunStatus status = RunStatus::FINISHED;
+    RunStatistics stats;
+    bool native = false;
+    if (options.useJit) 
+    {
+        JitCompiler jit;
+        jit.setMemoTable(table);
+        if (jit.compile(bytecode)) 
+        {
+            status = jit.run(std::cin, std::cout);
+            stats = jit.statistics();
+            native = true;
+        }
+        else 
+        {
+            std::cerr << "JIT is not available here, interpreting instead." << std::endl;
+        }
+    }
+    if (!native) 
+    {
+        VirtualMachine machine;
+        machine.setMemoTable(table);
+        status = machine.run(bytecode, std::cin, std::cout);
+        stats = machine.statistics();
+    }
+    std::cout.flush();
+    if (options.showStatistics) 
+    {
+        double seconds = stats.seconds > 0 ? stats.seconds : 1e-9;
+        if (native) 
+        {
+            std::cerr << "mode: jit\n";
+        }
+        else 
+        {
+            std::cerr << "instructions: " << stats.instructions << "\n";
+        }
+        std::cerr << "calls: " << stats.calls << "\n"
+                  << "max depth: " << stats.maxDepth << "\n"
+                  << "time: " << stats.seconds << " s\n";
+        if (!native) 
+        {
+            std::cerr << "instructions/sec: " << static_cast<double>(stats.instructions) / seconds << "\n";
+        }
+        std::cerr << "calls/sec: " << static_cast<double>(stats.calls) / seconds << std::endl;
+        if (options.memoize) 
+        {
+            const MemoStatistics& memoStats = memo.statistics();
+            std::cerr << "memoized functions: " << memoizedCount << "\n"
+                      << "memo hits: " << memoStats.hits << "\n"
+                      << "memo misses: " << memoStats.misses << "\n"
+                      << "memo evictions: " << memoStats.evictions << std::endl;
+        }
+    }
+    if (status != RunStatus::FINISHED) 
+    {
+        std::cerr << "Runtime error: " << VirtualMachine::describe(status) << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
+
+// KMG׺1024λֽ
+uint64_t parseSize(const char* text) 
+{
+    char* end = nullptr;
+    uint64_t size = std::strtoull(text, &end, 10);
+    switch (*end) 
+    {
+    case 'G': case 'g':
+        size *= 1024;
+        // fall through
+    case 'M': case 'm':
+        size *= 1024;
+        // fall through
+    case 'K': case 'k':
+        size *= 1024;
+        break;
+    default:
+        break;
+    }
+    return size;
+}
 
 int main(int argc, char* argv[]) 
 {
-    if (argc != 2) 
+    // Դļ-dyd ʾ.dydļ-dydb ʾƵԪļ.dydb
+    // Դļ.dyd.dydbʱʷֱӶ룬ָʽת
+    // -maxerr N ÿ׶¼Ĵ-columns ļкźкţ":"
+    // -pipe ʷ﷨߳ˮУԪн绷ζдݣĵԪб
+    // -run ûдʱѳΪֽ벢У-vmstats к󱨸ָ͵ô
+    // -jit ʱֽ뷭Ϊx86-64شִУƽ̨֧ʱͣ-run
+    // -O ǰȫŻ-Ofold-Odce-Ocse ֱֻ򿪳۵ôɾӱʽ
+    // -optstats Żͳƺָֽı仯-run
+    // -memo ĵýʵλ棬-memosize N ûౣĽ-run-vmstats ͬʱк滻
+    // -generate SIZE 룬ԼSIZEֽڣɴKMG׺ĳдԴļ
+    // -depth N-idlen N-decl P-errors R-seed N ֱúǶײʶȡ˵ռİٷֱȡ
+    // ÿעĸʺ
+    // --stats ʱڱ׼ϰ׶εĺʱӲʱ͵Ԫ
+    // --stats=json ΪJSON
+    // --allocstats ͳƾoperator newķֽֽķֵʷ뵥Ԫļ
+    // ﷨дļ׶ι࣬˳ʱ׼ֽӴòʱ
+    // ûALLOCSTATS=1ӽ̿ʼʱͳ
+    // -server SOCKET ļUnix׽ΪУ-workers N ô߳
+    // -client SOCKET Դļ׽ϵķ룬رķʽдļ
+    // -cache DIR Դݻʷ﷨Ľʱֱдļгʱʹã
+    // -cachesize SIZE ûܴСޣɴKMG׺-cachestats ڱ׼һͳ
+    // -bench ǰ˸׶εĺʱʺڴֵ-generateͬãٲ
+    // -benchruns N ظ-benchout FILE ýļĬΪԴļ.bench.json
+    std::string sourceFileName;
+    bool writeDyd = false;
+    bool writeDydb = false;
+    size_t maxErrors = Diagnostics::DEFAULT_LIMIT;
+    bool columns = false;
+    bool pipeline = false;
+    bool runAfterCompile = false;
+    RunOptions runOptions;
+    bool generate = false;
+    GeneratorOptions generatorOptions;
+    bool benchmark = false;
+    size_t benchmarkRuns = 3;
+    std::string benchmarkOutput;
+    StatsFormat statsFormat = StatsFormat::NONE;
+    std::string serverSocket;
+    std::string clientSocket;
+    size_t workers = std::thread::hardware_concurrency();
+    std::string cacheDirectory;
+    uint64_t cacheBytes = DEFAULT_CACHE_BYTES;
+    bool cacheStatistics = false;
+    for (int i = 1; i < argc; ++i) 
+    {
+        std::string arg = argv[i];
+        if (arg == "-dyd") 
+        {
+            writeDyd = true;
+        }
+        else if (arg == "-dydb") 
+        {
+            writeDydb = true;
+        }
+        else if (arg == "-pipe") 
+        {
+            pipeline = true;
+        }
+        else if (arg == "-run") 
+        {
+            runAfterCompile = true;
+        }
+        else if (arg == "-vmstats") 
+        {
+            runAfterCompile = true;
+            runOptions.showStatistics = true;
+        }
+        else if (arg == "-jit") 
+        {
+            runAfterCompile = true;
+            runOptions.useJit = true;
+        }
+        else if (arg == "-O") 
+        {
+            runAfterCompile = true;
+            runOptions.optimizer = OptimizerOptions::all();
+        }
+        else if (arg == "-Ofold") 
+        {
+            runAfterCompile = true;
+            runOptions.optimizer.foldConstants = true;
+        }
+        else if (arg == "-Odce") 
+        {
+            runAfterCompile = true;
+            runOptions.optimizer.eliminateDeadCode = true;
+        }
+        else if (arg == "-Ocse") 
+        {
+            runAfterCompile = true;
+            runOptions.optimizer.eliminateCommonSubexpressions = true;
+        }
+        else if (arg == "-optstats") 
+        {
+            runAfterCompile = true;
+            runOptions.showOptimizerStatistics = true;
+        }
+        else if (arg == "-memo") 
+        {
+            runAfterCompile = true;
+            runOptions.memoize = true;
+        }
+        else if (arg == "-memosize" && i + 1 < argc) 
+        {
+            runAfterCompile = true;
+            runOptions.memoize = true;
+            runOptions.memoCapacity = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-generate" && i + 1 < argc) 
+        {
+            generate = true;
+            generatorOptions.targetBytes = parseSize(argv[++i]);
+        }
+        else if (arg == "-depth" && i + 1 < argc) 
+        {
+            generatorOptions.maxDepth = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-idlen" && i + 1 < argc) 
+        {
+            generatorOptions.identifierLength = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-decl" && i + 1 < argc) 
+        {
+            generatorOptions.declarationPercent = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-errors" && i + 1 < argc) 
+        {
+            generatorOptions.errorRate = std::strtod(argv[++i], nullptr);
+        }
+        else if (arg == "-seed" && i + 1 < argc) 
+        {
+            generatorOptions.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-bench") 
+        {
+            benchmark = true;
+        }
+        else if (arg == "-benchruns" && i + 1 < argc) 
+        {
+            benchmark = true;
+            benchmarkRuns = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-benchout" && i + 1 < argc) 
+        {
+            benchmark = true;
+            benchmarkOutput = argv[++i];
+        }
+        else if (arg == "--stats" || arg == "--stats=table") 
+        {
+            statsFormat = StatsFormat::TABLE;
+        }
+        else if (arg == "--stats=json") 
+        {
+            statsFormat = StatsFormat::JSON;
+        }
+        else if (arg == "--allocstats") 
+        {
+            enableAllocationTracking();
+        }
+        else if (arg == "-server" && i + 1 < argc) 
+        {
+            serverSocket = argv[++i];
+        }
+        else if (arg == "-workers" && i + 1 < argc) 
+        {
+            workers = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-client" && i + 1 < argc) 
+        {
+            clientSocket = argv[++i];
+        }
+        else if (arg == "-cache" && i + 1 < argc) 
+        {
+            cacheDirectory = argv[++i];
+        }
+        else if (arg == "-cachesize" && i + 1 < argc) 
+        {
+            cacheBytes = parseSize(argv[++i]);
+        }
+        else if (arg == "-cachestats") 
+        {
+            cacheStatistics = true;
+        }
+        else if (arg == "-maxerr" && i + 1 < argc) 
+        {
+            maxErrors = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-columns") 
+        {
+            columns = true;
+        }
+        else if (arg.size() > 1 && arg[0] == '-') 
+        {
+            // ƴѡȱٲֵѡܵԴļ
+            std::cerr << "Unknown option or missing value - '" << arg << "'" << std::endl;
+            std::cerr << "Usage: " << argv[0] << " [options] source" << std::endl;
+            return EXIT_FAILURE;
+        }
+        else 
+        {
+            sourceFileName = arg;
+        }
+    }
+    if (!serverSocket.empty()) 
+    {
+        CompileOptions compileOptions;
+        compileOptions.maxErrors = maxErrors;
+        compileOptions.columns = columns;
+        compileOptions.buildTree = false;
+        return runCompileServer(serverSocket, workers, compileOptions);
+    }
+    if (sourceFileName.empty()) 
     {
         std::cout << "You should enter the name of source code." << std::endl;
+        return EXIT_FAILURE;
     }
 
-    // ʷ
-    std::string sourceFileName = argv[1];
-    lexical_analyzer(sourceFileName);
+    if (generate) 
+    {
+        GeneratorStatistics generated;
+        if (generatorOptions.declarationPercent > 100) generatorOptions.declarationPercent = 100;
+        if (!generateProgram(sourceFileName, generatorOptions, generated)) 
+        {
+            return EXIT_FAILURE;
+        }
+        std::cerr << "generated " << sourceFileName << ": " << generated.bytes << " bytes, " 
+                  << generated.lines << " lines, " << generated.functions << " functions, " 
+                  << generated.variables << " variables, " << generated.statements << " statements, " 
+                  << generated.lexicalErrors << " lexical and " << generated.syntaxErrors << " syntax errors injected" << std::endl;
+    }
+    if (benchmark) 
+    {
+        if (benchmarkOutput.empty()) 
+        {
+            benchmarkOutput = sourceFileName.substr(0, sourceFileName.find_last_of(".")) + ".bench.json";
+        }
+        BenchmarkReport report;
+        if (!runFrontendBenchmark(sourceFileName, varPath, proPath, benchmarkRuns, report) || !report.save(benchmarkOutput)) 
+        {
+            return EXIT_FAILURE;
+        }
+        report.print(std::cout);
+        return 0;
+    }
+    if (generate) 
+    {
+        return 0;
+    }
 
-    // ﷨
-    std::string varPath = "variableList.var";
-    std::string proPath = "processList.pro";
-    std::string errFile = "grammarError.err";
-    std::string inputFile = "test.dyd";
-    // .dydݽṹ
-    std::vector<std::pair<std::string, std::string>> tokenList;
-    std::string temp;
-    std::ifstream input(inputFile);
-
-    // ȡ.dydļ
-    if (input.is_open()) 
-    {
-        while (getline(input, temp)) 
-        {
-            std::istringstream iss(temp);
-            std::vector<std::string> tokens((std::istream_iterator<std::string>(iss)),
-                std::istream_iterator<std::string>());
-            for (size_t i = 0; i < tokens.size(); i += 2) 
+    if (!clientSocket.empty()) 
+    {
+        return runCompileClient(clientSocket, sourceFileName, varPath, proPath, lexErrFile, errFile, writeDyd, writeDydb);
+    }
+
+    PhaseProfiler profiler(statsFormat);
+
+    // ŶԪʽݽṹ
+    TokenBuffer tokenList;
+    size_t lexicalErrors = 0;
+    std::string lexicalErrorText; // Ҫ浽ʱ´ʷı
+    SourceBuffer tokenFile; // ӳڴ.dydbļ
+    TokenView tokens;
+
+    size_t dot = sourceFileName.find_last_of(".");
+    std::string baseName = sourceFileName.substr(0, dot);
+    std::string extension = dot != std::string::npos ? sourceFileName.substr(dot) : "";
+
+    // 뻺ֻǰ˵ĽгҪ﷨뱾ǵԪļʱʷѾʡȥ
+    bool useCache = !cacheDirectory.empty() && !runAfterCompile && extension != ".dydb" && extension != ".dyd";
+    CompileCache cache(cacheDirectory, cacheBytes);
+    CacheKey cacheKey;
+    if (useCache) 
+    {
+        setAllocationPhase(AllocationPhase::LOADER);
+        profiler.begin("cache_lookup");
+        SourceBuffer source;
+        if (!openSourceBuffer(sourceFileName, source)) 
+        {
+            std::cerr << "Could not open the file - '" << sourceFileName << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+        cacheKey = CompileCache::key(source.data, source.size, maxErrors, columns);
+        closeSourceBuffer(source);
+        SourceBuffer entry;
+        DecodedOutputs outputs;
+        bool hit = cache.lookup(cacheKey, entry, outputs);
+        profiler.end();
+        if (hit) 
+        {
+            setAllocationPhase(AllocationPhase::WRITER);
+            profiler.begin("print");
+            int result = writeCompileOutputs(outputs, baseName, varPath, proPath, lexErrFile, errFile, writeDyd, writeDydb);
+            profiler.end();
+            setAllocationPhase(AllocationPhase::OTHER);
+            profiler.count("cache_hits", 1);
+            CacheStatistics statistics = cache.record(true);
+            if (cacheStatistics) 
             {
-                if (i + 1 < tokens.size()) 
-                {
-                    tokenList.push_back({ tokens[i], tokens[i + 1] });
-                }
-                else 
-                {
-                    std::cerr << "Token list has an odd number of elements." << std::endl;
-                    return EXIT_FAILURE;
-                }
+                cache.countEntries(statistics);
+                statistics.print(std::cerr, true, cache.capacity());
             }
+            profiler.report(std::cerr);
+            closeSourceBuffer(entry);
+            return result;
+        }
+    }
+    // ƵԪļļͷҪܵԪҪд.dydbʱֻȵõĵԪб
+    // 뱾ǵԪļʱҲûпصĴʷгʱҪĵԪб
+    // δʱҪĵԪбҲˮ߷ʽ
+    if (pipeline && !writeDydb && !runAfterCompile && !useCache && extension != ".dydb" && extension != ".dyd") 
+    {
+        return compilePipelined(sourceFileName, baseName, writeDyd, maxErrors, columns, profiler);
+    }
+
+    if (extension == ".dydb") 
+    {
+        // ֱӳƵԪļκν
+        setAllocationPhase(AllocationPhase::LOADER);
+        profiler.begin("map_dydb");
+        if (!mapBinaryTokenFile(sourceFileName, tokenFile, tokens)) 
+        {
+            return EXIT_FAILURE;
+        }
+        profiler.end();
+        if (writeDyd) 
+        {
+            setAllocationPhase(AllocationPhase::WRITER);
+            profiler.begin("save_dyd");
+            saveDydFile(tokens, baseName + ".dyd");
+            profiler.end();
+        }
+    }
+    else if (extension == ".dyd") 
+    {
+        // ȡе.dydļ
+        setAllocationPhase(AllocationPhase::LOADER);
+        profiler.begin("load_dyd");
+        if (!loadDydFile(sourceFileName, tokenList)) 
+        {
+            return EXIT_FAILURE;
         }
-        input.close();
+        profiler.end();
+        tokens = tokenList.view();
     }
     else 
     {
-        std::cerr << "Could not open the file - '" << inputFile << "'" << std::endl;
-        return EXIT_FAILURE;
+        // ʷֱӱڴУ-dydʱд.dydҲһ׶
+        setAllocationPhase(AllocationPhase::LEXER);
+        Diagnostics lexicalDiagnostics(lexErrFile, maxErrors, columns);
+        profiler.begin("lex");
+        if (lexical_analyzer(sourceFileName, tokenList, lexicalDiagnostics, writeDyd) != 0) 
+        {
+            return EXIT_FAILURE;
+        }
+        profiler.end();
+        lexicalDiagnostics.flush();
+        lexicalErrors = lexicalDiagnostics.count();
+        if (useCache) 
+        {
+            lexicalErrorText = lexicalDiagnostics.text();
+        }
+        tokens = tokenList.view();
+    }
+    if (writeDydb && extension != ".dydb") 
+    {
+        setAllocationPhase(AllocationPhase::WRITER);
+        profiler.begin("save_dydb");
+        saveBinaryTokenFile(tokens, baseName + ".dydb");
+        profiler.end();
     }
 
-    // ʼ﷨
-    GrammarAnalyzer analyzer(tokenList, errFile);
+    // ﷨
+    setAllocationPhase(AllocationPhase::PARSER);
+    Diagnostics grammarDiagnostics(errFile, maxErrors, columns);
+    Arena arena; // гʱ﷨
+    GrammarAnalyzer analyzer(tokens, grammarDiagnostics);
+    if (runAfterCompile) 
+    {
+        analyzer.setArena(&arena);
+    }
+    profiler.begin("parse");
     analyzer.parseProgram(); // ʼ
+    profiler.end();
+    setAllocationPhase(AllocationPhase::WRITER);
+    grammarDiagnostics.flush();
+    profiler.count("tokens", tokens.count);
+    profiler.count("lines", tokens.count > 0 ? tokens.tokens[tokens.count - 1].line : 0);
+    profiler.count("symbols", analyzer.getVarList().size() + analyzer.getProList().size());
+    profiler.count("lexical_errors", lexicalErrors);
+    profiler.count("grammar_errors", grammarDiagnostics.count());
+    if (useCache) 
+    {
+        profiler.begin("cache_store");
+        CompileStatus status = analyzer.isStopped() ? CompileStatus::STOPPED
+            : lexicalErrors > 0 || grammarDiagnostics.count() > 0 ? CompileStatus::FAILED : CompileStatus::SUCCEEDED;
+        std::string encoded;
+        std::string scratch;
+        // ޷ʱ
+        if (encodeCompileOutputs(status, tokens, analyzer.getVarList(), analyzer.getProList(), lexicalErrorText, 
+            grammarDiagnostics.text(), encoded, scratch)) 
+        {
+            cache.store(cacheKey, encoded);
+        }
+        profiler.end();
+        profiler.count("cache_hits", 0);
+        CacheStatistics statistics = cache.record(false);
+        if (cacheStatistics) 
+        {
+            cache.countEntries(statistics);
+            statistics.print(std::cerr, false, cache.capacity());
+        }
+    }
+    if (analyzer.isStopped()) 
+    {
+        // ֹ͹̱
+        profiler.report(std::cerr);
+        closeSourceBuffer(tokenFile);
+        return -1;
+    }
 
     // ļ
+    profiler.begin("print");
     analyzer.printFiles(varPath, proPath);
-
-    system("pause");
+    profiler.end();
+    setAllocationPhase(AllocationPhase::OTHER);
+    if (runAfterCompile) 
+    {
+        int result = EXIT_FAILURE;
+        if (lexicalErrors > 0 || grammarDiagnostics.count() > 0) 
+        {
+            std::cerr << "The program has errors and was not run." << std::endl;
+        }
+        else 
+        {
+            setAllocationPhase(AllocationPhase::OTHER);
+            profiler.begin("run");
+            result = runProgram(analyzer.getProgram(), arena, tokens, analyzer, runOptions);
+            profiler.end();
+        }
+        profiler.report(std::cerr);
+        closeSourceBuffer(tokenFile);
+        return result;
+    }
+    profiler.report(std::cerr);
+    closeSourceBuffer(tokenFile);
     return 0;
-}
\ No newline at end of file
+}
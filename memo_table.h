@@ -0,0 +1,111 @@
+#ifndef MEMO_TABLE_H
+#define MEMO_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ͳ
+struct MemoStatistics
+{
+    uint64_t hits = 0; // д
+    uint64_t misses = 0; // δд
+    uint64_t evictions = 0; // 滻
+};
+
+// ýĻ棬ԣڹ̱е±꣬ʵΣΪ
+// ̶ţÿֻܷɢֵȷһУʱ滻һ
+class MemoTable
+{
+private:
+    struct Entry
+    {
+        bool used;
+        uint32_t procedure;
+        long long argument;
+        long long value;
+    };
+
+    static const size_t WAYS = 4; // ÿ
+
+    std::vector<Entry> entries; // δ
+    std::vector<unsigned char> victims; // ÿһ滻λ
+    size_t setMask; // 12
+    MemoStatistics stats;
+
+    size_t setOf(uint32_t procedure, long long argument) const
+    {
+        uint64_t hash = static_cast<uint64_t>(argument) * 0x9E3779B97F4A7C15ULL ^ (procedure + 1) * 0xC2B2AE3D27D4EB4FULL;
+        hash ^= hash >> 29;
+        return static_cast<size_t>(hash) & setMask;
+    }
+
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 16;
+
+    // capacityΪౣĽȡΪWAYS2
+    explicit MemoTable(size_t capacity = DEFAULT_CAPACITY)
+    {
+        size_t sets = 1;
+        while (sets * WAYS < capacity) sets *= 2;
+        entries.assign(sets * WAYS, Entry{ false, 0, 0, 0 });
+        victims.assign(sets, 0);
+        setMask = sets - 1;
+    }
+
+    // ջͳ
+    void clear()
+    {
+        entries.assign(entries.size(), Entry{ false, 0, 0, 0 });
+        victims.assign(victims.size(), 0);
+        stats = MemoStatistics();
+    }
+
+    // ҽҵʱvalue
+    bool find(uint32_t procedure, long long argument, long long& value)
+    {
+        const Entry* set = &entries[setOf(procedure, argument) * WAYS];
+        for (size_t i = 0; i < WAYS; ++i)
+        {
+            if (set[i].used && set[i].procedure == procedure && set[i].argument == argument)
+            {
+                ++stats.hits;
+                value = set[i].value;
+                return true;
+            }
+        }
+        ++stats.misses;
+        return false;
+    }
+
+    // ͬһʱ
+    void insert(uint32_t procedure, long long argument, long long value)
+    {
+        size_t index = setOf(procedure, argument);
+        Entry* set = &entries[index * WAYS];
+        Entry* slot = nullptr;
+        for (size_t i = 0; i < WAYS && slot == nullptr; ++i)
+        {
+            if (!set[i].used || (set[i].procedure == procedure && set[i].argument == argument)) slot = &set[i];
+        }
+        if (slot == nullptr)
+        {
+            slot = &set[victims[index]];
+            victims[index] = static_cast<unsigned char>((victims[index] + 1) % WAYS);
+            ++stats.evictions;
+        }
+        *slot = Entry{ true, procedure, argument, value };
+    }
+
+    size_t capacity() const
+    {
+        return entries.size();
+    }
+
+    const MemoStatistics& statistics() const
+    {
+        return stats;
+    }
+};
+
+#endif
@@ -0,0 +1,795 @@
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "optimizer.h"
+
+static const size_t NO_BLOCK = static_cast<size_t>(-1);
+
+// ȱʧӣ0
+static bool isConstant(const Expression* node)
+{
+    return node != nullptr && (node->kind == ExpressionKind::CONSTANT || node->kind == ExpressionKind::EMPTY);
+}
+
+static long long constantValue(const Expression* node)
+{
+    return node->kind == ExpressionKind::CONSTANT ? node->value : 0;
+}
+
+static bool isBinary(const Expression* node)
+{
+    return node->kind == ExpressionKind::MULTIPLY || node->kind == ExpressionKind::SUBTRACT;
+}
+
+// ͬ㰴64λ
+static long long wrapSubtract(long long x, long long y)
+{
+    return static_cast<long long>(static_cast<unsigned long long>(x) - static_cast<unsigned long long>(y));
+}
+
+static long long wrapMultiply(long long x, long long y)
+{
+    return static_cast<long long>(static_cast<unsigned long long>(x) * static_cast<unsigned long long>(y));
+}
+
+static bool compareValues(RelationKind relation, long long x, long long y)
+{
+    switch (relation)
+    {
+    case RelationKind::LESS:
+        return x < y;
+    case RelationKind::LESS_OR_EQUALS:
+        return x <= y;
+    case RelationKind::GREATER:
+        return x > y;
+    case RelationKind::GREATER_OR_EQUALS:
+        return x >= y;
+    case RelationKind::EQUALS:
+        return x == y;
+    default:
+        return x != y;
+    }
+}
+
+// ߶ǳvalueΪֵ
+static bool constantCondition(const Condition* condition, bool& value)
+{
+    if (condition == nullptr || condition->relation == RelationKind::NONE ||
+        !isConstant(condition->left) || !isConstant(condition->right))
+    {
+        return false;
+    }
+    value = compareValues(condition->relation, constantValue(condition->left), constantValue(condition->right));
+    return true;
+}
+
+// ʽвãֵûиãֵĽͬ
+static bool callFree(const Expression* root)
+{
+    std::vector<const Expression*> pending;
+    if (root != nullptr) pending.push_back(root);
+    while (!pending.empty())
+    {
+        const Expression* node = pending.back();
+        pending.pop_back();
+        if (node->kind == ExpressionKind::CALL) return false;
+        if (node->left != nullptr) pending.push_back(node->left);
+        if (node->right != nullptr) pending.push_back(node->right);
+    }
+    return true;
+}
+
+static bool callFree(const Condition* condition)
+{
+    return condition == nullptr || (callFree(condition->left) && callFree(condition->right));
+}
+
+// ηʱʽеĽ㣨ȸ
+static void forEachExpression(const Expression* root, const std::function<void(const Expression*)>& visit)
+{
+    std::vector<const Expression*> pending;
+    if (root != nullptr) pending.push_back(root);
+    while (!pending.empty())
+    {
+        const Expression* node = pending.back();
+        pending.pop_back();
+        visit(node);
+        if (node->right != nullptr) pending.push_back(node->right);
+        if (node->left != nullptr) pending.push_back(node->left);
+    }
+}
+
+// η估Ƕ׵䣨ȸ
+static void forEachStatement(const Statement* root, const std::function<void(const Statement*)>& visit)
+{
+    std::vector<const Statement*> pending;
+    if (root != nullptr) pending.push_back(root);
+    while (!pending.empty())
+    {
+        const Statement* node = pending.back();
+        pending.pop_back();
+        visit(node);
+        if (node->elseBranch != nullptr) pending.push_back(node->elseBranch);
+        if (node->thenBranch != nullptr) pending.push_back(node->thenBranch);
+    }
+}
+
+// ؽʽcombine(ԭ, µ, µ)½㣬ǶҲݹ
+static const Expression* rewriteExpression(const Expression* root,
+    const std::function<const Expression*(const Expression*, const Expression*, const Expression*)>& combine)
+{
+    struct Task
+    {
+        const Expression* node;
+        int state; // Ѵӽ
+    };
+    if (root == nullptr) return nullptr;
+    std::vector<Task> tasks;
+    std::vector<const Expression*> values;
+    tasks.push_back(Task{ root, 0 });
+    while (!tasks.empty())
+    {
+        size_t top = tasks.size() - 1;
+        const Expression* node = tasks[top].node;
+        int children = isBinary(node) ? 2 : (node->kind == ExpressionKind::CALL ? 1 : 0);
+        if (tasks[top].state < children)
+        {
+            const Expression* child = tasks[top].state == 0 ? node->left : node->right;
+            ++tasks[top].state;
+            if (child == nullptr)
+            {
+                values.push_back(nullptr);
+            }
+            else
+            {
+                tasks.push_back(Task{ child, 0 });
+            }
+            continue;
+        }
+        const Expression* right = nullptr;
+        const Expression* left = nullptr;
+        if (children == 2)
+        {
+            right = values.back();
+            values.pop_back();
+        }
+        if (children >= 1)
+        {
+            left = values.back();
+            values.pop_back();
+        }
+        tasks.pop_back();
+        values.push_back(combine(node, left, right));
+    }
+    return values.back();
+}
+
+// ؽ䣺combine(ԭ, µthen֧, µelse֧)䣬nullptrʾɾ
+static const Statement* rewriteStatement(const Statement* root,
+    const std::function<const Statement*(const Statement*, const Statement*, const Statement*)>& combine)
+{
+    struct Task
+    {
+        const Statement* node;
+        int state; // Ѵķ֧
+    };
+    if (root == nullptr) return nullptr;
+    std::vector<Task> tasks;
+    std::vector<const Statement*> results;
+    tasks.push_back(Task{ root, 0 });
+    while (!tasks.empty())
+    {
+        size_t top = tasks.size() - 1;
+        const Statement* node = tasks[top].node;
+        if (node->kind == StatementKind::IF && tasks[top].state < 2)
+        {
+            const Statement* child = tasks[top].state == 0 ? node->thenBranch : node->elseBranch;
+            ++tasks[top].state;
+            if (child == nullptr)
+            {
+                results.push_back(nullptr);
+            }
+            else
+            {
+                tasks.push_back(Task{ child, 0 });
+            }
+            continue;
+        }
+        const Statement* thenBranch = nullptr;
+        const Statement* elseBranch = nullptr;
+        if (node->kind == StatementKind::IF)
+        {
+            elseBranch = results.back();
+            results.pop_back();
+            thenBranch = results.back();
+            results.pop_back();
+        }
+        tasks.pop_back();
+        results.push_back(combine(node, thenBranch, elseBranch));
+    }
+    return results.back();
+}
+
+// ӱʽжͬݣӽѾϲȽָ뼴
+struct ExpressionKey
+{
+    ExpressionKind kind;
+    long long value;
+    bool isProcedure;
+    size_t index;
+    const Expression* left;
+    const Expression* right;
+
+    bool operator==(const ExpressionKey& other) const
+    {
+        return kind == other.kind && value == other.value && isProcedure == other.isProcedure &&
+            index == other.index && left == other.left && right == other.right;
+    }
+};
+
+struct ExpressionKeyHash
+{
+    size_t operator()(const ExpressionKey& key) const
+    {
+        size_t hash = static_cast<size_t>(key.kind);
+        hash = hash * 31 + std::hash<long long>()(key.value);
+        hash = hash * 31 + key.index * 2 + (key.isProcedure ? 1 : 0);
+        hash = hash * 31 + std::hash<const void*>()(key.left);
+        hash = hash * 31 + std::hash<const void*>()(key.right);
+        return hash;
+    }
+};
+
+// ηʸֳеĺ˵ȣǶҲݹ
+static void forEachFunction(const Program& program, const std::function<void(const FunctionDeclaration*)>& visit)
+{
+    std::vector<const Block*> pending;
+    if (program.body != nullptr) pending.push_back(program.body);
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        for (size_t k = 0; k < pending[i]->functionCount; ++k)
+        {
+            const FunctionDeclaration* declaration = pending[i]->functions[k];
+            visit(declaration);
+            if (declaration->body != nullptr) pending.push_back(declaration->body);
+        }
+    }
+}
+
+std::vector<bool> findPureFunctions(const Program& program)
+{
+    std::vector<const FunctionDeclaration*> declarations; // ̱±
+    forEachFunction(program, [&](const FunctionDeclaration* declaration)
+    {
+        if (declaration->procedure >= declarations.size()) declarations.resize(declaration->procedure + 1, nullptr);
+        declarations[declaration->procedure] = declaration;
+    });
+
+    // 麯屾µùϵ
+    std::vector<bool> pure(declarations.size(), false);
+    std::vector<std::vector<size_t>> callers(declarations.size()); // øĺ
+    std::unordered_set<size_t> own; // ǰβκ;ֲ
+    for (size_t p = 0; p < declarations.size(); ++p)
+    {
+        const FunctionDeclaration* declaration = declarations[p];
+        if (declaration == nullptr || declaration->body == nullptr) continue;
+        const Block& body = *declaration->body;
+        own.clear();
+        own.insert(declaration->parameter);
+        own.insert(body.variables, body.variables + body.variableCount);
+
+        bool local = true;
+        // дԼıͷֵѵǼǵĺ
+        auto ownName = [&](const Symbol& symbol)
+        {
+            if (symbol.index == UNRESOLVED) return false;
+            return symbol.isProcedure ? symbol.index == p : own.count(symbol.index) > 0;
+        };
+        auto checkExpression = [&](const Expression* node)
+        {
+            if (node->kind == ExpressionKind::VARIABLE && !ownName(node->symbol))
+            {
+                local = false;
+            }
+            else if (node->kind == ExpressionKind::CALL)
+            {
+                if (!node->symbol.isProcedure || node->symbol.index >= declarations.size())
+                {
+                    local = false;
+                }
+                else
+                {
+                    callers[node->symbol.index].push_back(p);
+                }
+            }
+        };
+        for (size_t k = 0; k < body.statementCount && local; ++k)
+        {
+            forEachStatement(body.statements[k], [&](const Statement* node)
+            {
+                switch (node->kind)
+                {
+                case StatementKind::READ:
+                case StatementKind::WRITE:
+                    local = false;
+                    break;
+                case StatementKind::ASSIGN:
+                    if (!ownName(node->target)) local = false;
+                    forEachExpression(node->value, checkExpression);
+                    break;
+                case StatementKind::IF:
+                    if (node->condition != nullptr)
+                    {
+                        forEachExpression(node->condition->left, checkExpression);
+                        forEachExpression(node->condition->right, checkExpression);
+                    }
+                    break;
+                }
+            });
+        }
+        pure[p] = local;
+    }
+
+    // ˷ǴĺҲǴ
+    std::vector<size_t> worklist;
+    for (size_t p = 0; p < declarations.size(); ++p)
+    {
+        if (!pure[p]) worklist.push_back(p);
+    }
+    while (!worklist.empty())
+    {
+        size_t p = worklist.back();
+        worklist.pop_back();
+        for (size_t caller : callers[p])
+        {
+            if (pure[caller])
+            {
+                pure[caller] = false;
+                worklist.push_back(caller);
+            }
+        }
+    }
+    return pure;
+}
+
+// ִд򿪵ĸŻֳ򰴹ȵ˳չÿǵִ䣬
+// ڲ㵽ؽֳͺ˵
+class Optimizer
+{
+private:
+    // һֳڸд
+    struct BlockInfo
+    {
+        const Block* block;
+        std::vector<size_t> variables;
+        std::vector<const Statement*> statements;
+        std::vector<size_t> children; // ˵ĺӦķֳûкʱΪNO_BLOCK
+    };
+
+    Arena& arena;
+    size_t variableCount;
+    const OptimizerOptions& options;
+    OptimizerStatistics& stats;
+    std::vector<BlockInfo> blocks;
+    std::unordered_map<ExpressionKey, const Expression*, ExpressionKeyHash> canonical; // ǰѳֵıʽ
+    std::vector<bool> pureFunctions; // ̱±
+
+    const Expression* constantNode(uint32_t token, long long value)
+    {
+        Expression node = { ExpressionKind::CONSTANT, token, value, Symbol{ false, UNRESOLVED }, nullptr, nullptr };
+        return arena.create(node);
+    }
+
+    // ӽб仯ʱƽ
+    const Expression* rebuild(const Expression* node, const Expression* left, const Expression* right)
+    {
+        if (left == node->left && right == node->right) return node;
+        Expression copy = *node;
+        copy.left = left;
+        copy.right = right;
+        return arena.create(copy);
+    }
+
+    const Condition* rebuild(const Condition* condition, const Expression* left, const Expression* right)
+    {
+        if (left == condition->left && right == condition->right) return condition;
+        Condition copy = *condition;
+        copy.left = left;
+        copy.right = right;
+        return arena.create(copy);
+    }
+
+    const Statement* rebuild(const Statement* node, const Expression* value, const Condition* condition,
+        const Statement* thenBranch, const Statement* elseBranch)
+    {
+        if (value == node->value && condition == node->condition &&
+            thenBranch == node->thenBranch && elseBranch == node->elseBranch)
+        {
+            return node;
+        }
+        Statement copy = *node;
+        copy.value = value;
+        copy.condition = condition;
+        copy.thenBranch = thenBranch;
+        copy.elseBranch = elseBranch;
+        return arena.create(copy);
+    }
+
+    void collectBlocks(const Block* root)
+    {
+        blocks.push_back(BlockInfo{ root, {}, {}, {} });
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            const Block* block = blocks[i].block;
+            blocks[i].variables.assign(block->variables, block->variables + block->variableCount);
+            blocks[i].statements.assign(block->statements, block->statements + block->statementCount);
+            for (size_t k = 0; k < block->functionCount; ++k)
+            {
+                const Block* body = block->functions[k]->body;
+                blocks[i].children.push_back(body == nullptr ? NO_BLOCK : blocks.size());
+                if (body != nullptr) blocks.push_back(BlockInfo{ body, {}, {}, {} });
+            }
+        }
+    }
+
+    // ÿִӦrewriteȥΪյ
+    void rewriteStatements(const std::function<const Statement*(const Statement*)>& rewrite)
+    {
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            std::vector<const Statement*>& statements = blocks[i].statements;
+            size_t kept = 0;
+            for (size_t k = 0; k < statements.size(); ++k)
+            {
+                const Statement* result = statements[k] == nullptr ? nullptr : rewrite(statements[k]);
+                if (result != nullptr) statements[kept++] = result;
+            }
+            statements.resize(kept);
+        }
+    }
+
+    // ۵ֱ֮x-0x*11*xΪxx*00*xxúʱΪ0
+    // ߶ǳֱֵ任ѡеķ֧
+    const Expression* foldNode(const Expression* node, const Expression* left, const Expression* right)
+    {
+        if (isBinary(node))
+        {
+            bool multiply = node->kind == ExpressionKind::MULTIPLY;
+            if (isConstant(left) && isConstant(right))
+            {
+                ++stats.foldedExpressions;
+                long long x = constantValue(left);
+                long long y = constantValue(right);
+                return constantNode(node->token, multiply ? wrapMultiply(x, y) : wrapSubtract(x, y));
+            }
+            if (!multiply && isConstant(right) && constantValue(right) == 0)
+            {
+                ++stats.foldedExpressions;
+                return left;
+            }
+            if (multiply)
+            {
+                if ((isConstant(left) && constantValue(left) == 1) ||
+                    (isConstant(right) && constantValue(right) == 0 && callFree(left)))
+                {
+                    ++stats.foldedExpressions;
+                    return right;
+                }
+                if ((isConstant(right) && constantValue(right) == 1) ||
+                    (isConstant(left) && constantValue(left) == 0 && callFree(right)))
+                {
+                    ++stats.foldedExpressions;
+                    return left;
+                }
+            }
+        }
+        return rebuild(node, left, right);
+    }
+
+    const Expression* foldExpression(const Expression* root)
+    {
+        return rewriteExpression(root, [this](const Expression* node, const Expression* left, const Expression* right)
+        {
+            return foldNode(node, left, right);
+        });
+    }
+
+    void foldConstants()
+    {
+        rewriteStatements([this](const Statement* root)
+        {
+            return rewriteStatement(root, [this](const Statement* node, const Statement* thenBranch, const Statement* elseBranch)
+            {
+                if (node->kind == StatementKind::ASSIGN)
+                {
+                    return rebuild(node, foldExpression(node->value), node->condition, thenBranch, elseBranch);
+                }
+                if (node->kind != StatementKind::IF || node->condition == nullptr)
+                {
+                    return rebuild(node, node->value, node->condition, thenBranch, elseBranch);
+                }
+                const Condition* condition = rebuild(node->condition,
+                    foldExpression(node->condition->left), foldExpression(node->condition->right));
+                bool value = false;
+                if (constantCondition(condition, value))
+                {
+                    ++stats.foldedConditions;
+                    return value ? thenBranch : elseBranch;
+                }
+                return rebuild(node, node->value, condition, thenBranch, elseBranch);
+            });
+        });
+    }
+
+    // Ƿǿɾľֲ
+    bool isTracked(const Symbol& symbol) const
+    {
+        return !symbol.isProcedure && symbol.index < variableCount;
+    }
+
+    // ɾô룺δȡľֲұ߲úĶĸֵһɾʹٱȡ
+    // 㶨ʱɴķ֧֧Ϊú
+    void eliminateDeadCode()
+    {
+        std::vector<bool> local(variableCount, false);
+        std::vector<size_t> reads(variableCount, 0); // ȡĴ
+        std::vector<size_t> writes(variableCount, 0); // ΪֵĿĴ
+        std::vector<size_t> removedWrites(variableCount, 0);
+        std::unordered_map<size_t, std::vector<const Statement*>> pureAssignments; // ұ߲úĸֵ
+        std::unordered_set<const Statement*> dead;
+
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            for (size_t k = 0; k < blocks[i].variables.size(); ++k)
+            {
+                if (blocks[i].variables[k] < variableCount) local[blocks[i].variables[k]] = true;
+            }
+        }
+        auto countReads = [&](const Expression* node)
+        {
+            if (node->kind == ExpressionKind::VARIABLE && isTracked(node->symbol)) ++reads[node->symbol.index];
+        };
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            for (size_t k = 0; k < blocks[i].statements.size(); ++k)
+            {
+                forEachStatement(blocks[i].statements[k], [&](const Statement* node)
+                {
+                    switch (node->kind)
+                    {
+                    case StatementKind::WRITE:
+                        if (isTracked(node->target)) ++reads[node->target.index];
+                        break;
+                    case StatementKind::READ:
+                        if (isTracked(node->target)) ++writes[node->target.index];
+                        break;
+                    case StatementKind::ASSIGN:
+                        forEachExpression(node->value, countReads);
+                        if (isTracked(node->target))
+                        {
+                            ++writes[node->target.index];
+                            if (callFree(node->value)) pureAssignments[node->target.index].push_back(node);
+                        }
+                        break;
+                    case StatementKind::IF:
+                        if (node->condition != nullptr)
+                        {
+                            forEachExpression(node->condition->left, countReads);
+                            forEachExpression(node->condition->right, countReads);
+                        }
+                        break;
+                    }
+                });
+            }
+        }
+
+        // Ӳȡľֲɾǵĸֵұ߱Ķȡ
+        std::vector<size_t> worklist;
+        for (size_t v = 0; v < variableCount; ++v)
+        {
+            if (local[v] && reads[v] == 0) worklist.push_back(v);
+        }
+        while (!worklist.empty())
+        {
+            size_t v = worklist.back();
+            worklist.pop_back();
+            auto found = pureAssignments.find(v);
+            if (found == pureAssignments.end()) continue;
+            for (const Statement* assignment : found->second)
+            {
+                dead.insert(assignment);
+                ++removedWrites[v];
+                forEachExpression(assignment->value, [&](const Expression* node)
+                {
+                    if (node->kind == ExpressionKind::VARIABLE && isTracked(node->symbol) &&
+                        --reads[node->symbol.index] == 0 && local[node->symbol.index])
+                    {
+                        worklist.push_back(node->symbol.index);
+                    }
+                });
+            }
+            pureAssignments.erase(found);
+        }
+
+        rewriteStatements([&](const Statement* root)
+        {
+            return rewriteStatement(root, [&](const Statement* node, const Statement* thenBranch, const Statement* elseBranch)
+                -> const Statement*
+            {
+                if (node->kind == StatementKind::ASSIGN && dead.count(node) > 0)
+                {
+                    ++stats.removedStatements;
+                    return nullptr;
+                }
+                if (node->kind != StatementKind::IF)
+                {
+                    return node;
+                }
+                bool value = false;
+                if (constantCondition(node->condition, value))
+                {
+                    if ((value ? elseBranch : thenBranch) != nullptr) ++stats.removedBranches;
+                    return value ? thenBranch : elseBranch;
+                }
+                if (thenBranch == nullptr && elseBranch == nullptr && node->condition != nullptr &&
+                    node->condition->relation != RelationKind::NONE && callFree(node->condition))
+                {
+                    ++stats.removedStatements;
+                    return nullptr;
+                }
+                return rebuild(node, node->value, node->condition, thenBranch, elseBranch);
+            });
+        });
+
+        // ٱдľֲռüĴ
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            std::vector<size_t>& variables = blocks[i].variables;
+            size_t kept = 0;
+            for (size_t k = 0; k < variables.size(); ++k)
+            {
+                size_t v = variables[k];
+                if (v < variableCount && reads[v] == 0 && writes[v] == removedWrites[v])
+                {
+                    ++stats.removedVariables;
+                    continue;
+                }
+                variables[kept++] = v;
+            }
+            variables.resize(kept);
+        }
+    }
+
+    // ʽֻôֵ޸καظֵͬ
+    bool sideEffectFree(const Expression* root) const
+    {
+        std::vector<const Expression*> pending;
+        if (root != nullptr) pending.push_back(root);
+        while (!pending.empty())
+        {
+            const Expression* node = pending.back();
+            pending.pop_back();
+            if (node->kind == ExpressionKind::CALL &&
+                (!node->symbol.isProcedure || node->symbol.index >= pureFunctions.size() || !pureFunctions[node->symbol.index]))
+            {
+                return false;
+            }
+            if (node->left != nullptr) pending.push_back(node->left);
+            if (node->right != nullptr) pending.push_back(node->right);
+        }
+        return true;
+    }
+
+    // ѱʽ뵱ǰǰ沿ͬӱʽȳֵǸ
+    const Expression* shareExpression(const Expression* root)
+    {
+        return rewriteExpression(root, [this](const Expression* node, const Expression* left, const Expression* right)
+        {
+            ExpressionKey key = { node->kind, node->value, node->symbol.isProcedure, node->symbol.index, left, right };
+            auto found = canonical.find(key);
+            if (found != canonical.end())
+            {
+                if (isBinary(node) || node->kind == ExpressionKind::CALL) ++stats.sharedSubexpressions;
+                return found->second;
+            }
+            const Expression* result = rebuild(node, left, right);
+            canonical.emplace(key, result);
+            return result;
+        });
+    }
+
+    // ӱʽͬһֵұ߻ͬһߣͬӱʽֵֻһΡ
+    // ˷Ǵıʽ޸еı
+    void eliminateCommonSubexpressions(const Program& program)
+    {
+        pureFunctions = findPureFunctions(program);
+        rewriteStatements([this](const Statement* root)
+        {
+            return rewriteStatement(root, [this](const Statement* node, const Statement* thenBranch, const Statement* elseBranch)
+            {
+                canonical.clear();
+                if (node->kind == StatementKind::ASSIGN && sideEffectFree(node->value))
+                {
+                    return rebuild(node, shareExpression(node->value), node->condition, thenBranch, elseBranch);
+                }
+                if (node->kind == StatementKind::IF && node->condition != nullptr &&
+                    sideEffectFree(node->condition->left) && sideEffectFree(node->condition->right))
+                {
+                    const Expression* left = shareExpression(node->condition->left);
+                    const Expression* right = shareExpression(node->condition->right);
+                    return rebuild(node, node->value, rebuild(node->condition, left, right), thenBranch, elseBranch);
+                }
+                return rebuild(node, node->value, node->condition, thenBranch, elseBranch);
+            });
+        });
+        canonical.clear();
+    }
+
+    // ڲ㵽ؽֳ
+    const Block* rebuildBlocks()
+    {
+        std::vector<const Block*> rebuilt(blocks.size(), nullptr);
+        std::vector<const FunctionDeclaration*> functions;
+        for (size_t i = blocks.size(); i-- > 0;)
+        {
+            const BlockInfo& info = blocks[i];
+            functions.clear();
+            for (size_t k = 0; k < info.children.size(); ++k)
+            {
+                const FunctionDeclaration* declaration = info.block->functions[k];
+                if (info.children[k] != NO_BLOCK)
+                {
+                    FunctionDeclaration copy = *declaration;
+                    copy.body = rebuilt[info.children[k]];
+                    declaration = arena.create(copy);
+                }
+                functions.push_back(declaration);
+            }
+            Block block;
+            block.variableCount = info.variables.size();
+            block.variables = arena.createArray(info.variables.data(), info.variables.size());
+            block.functionCount = functions.size();
+            block.functions = arena.createArray(functions.data(), functions.size());
+            block.statementCount = info.statements.size();
+            block.statements = arena.createArray(info.statements.data(), info.statements.size());
+            rebuilt[i] = arena.create(block);
+        }
+        return rebuilt[0];
+    }
+
+public:
+    Optimizer(Arena& arena, size_t variableCount, const OptimizerOptions& options, OptimizerStatistics& stats)
+        :arena(arena)
+        ,variableCount(variableCount)
+        ,options(options)
+        ,stats(stats)
+    {}
+
+    const Program* optimize(const Program& program)
+    {
+        if (program.body == nullptr || !options.any()) return &program;
+        collectBlocks(program.body);
+        if (options.foldConstants) foldConstants();
+        if (options.eliminateDeadCode) eliminateDeadCode();
+        size_t shared = stats.sharedSubexpressions;
+        if (options.eliminateCommonSubexpressions) eliminateCommonSubexpressions(program);
+        Program result = { rebuildBlocks(), program.sharedExpressions || stats.sharedSubexpressions > shared };
+        return arena.create(result);
+    }
+};
+
+const Program* optimizeProgram(const Program& program, size_t variableCount, Arena& arena,
+    const OptimizerOptions& options, OptimizerStatistics& statistics)
+{
+    Optimizer optimizer(arena, variableCount, options, statistics);
+    return optimizer.optimize(program);
+}
+
+void OptimizerStatistics::print(std::ostream& out) const
+{
+    out << "fold: " << foldedExpressions << " expressions, " << foldedConditions << " conditions\n"
+        << "dce: " << removedStatements << " statements, " << removedBranches << " branches, "
+        << removedVariables << " variables\n"
+        << "cse: " << sharedSubexpressions << " subexpressions" << std::endl;
+}
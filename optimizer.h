@@ -0,0 +1,59 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <iostream>
+#include <vector>
+#include "ast.h"
+
+// ŻĿ
+struct OptimizerOptions
+{
+    bool foldConstants = false; // ۵
+    bool eliminateDeadCode = false; // ɾô
+    bool eliminateCommonSubexpressions = false; // ӱʽ
+
+    // ȫŻ
+    static OptimizerOptions all()
+    {
+        OptimizerOptions options;
+        options.foldConstants = true;
+        options.eliminateDeadCode = true;
+        options.eliminateCommonSubexpressions = true;
+        return options;
+    }
+
+    bool any() const
+    {
+        return foldConstants || eliminateDeadCode || eliminateCommonSubexpressions;
+    }
+};
+
+// Żͳ
+struct OptimizerStatistics
+{
+    // ۵
+    size_t foldedExpressions = 0; // 
+    size_t foldedConditions = 0; // ȡֵ㶨ֱѡ֧
+    // ɾô
+    size_t removedStatements = 0; // ɾĸֵͿյ
+    size_t removedBranches = 0; // ɾĲɴ֧
+    size_t removedVariables = 0; // ɾδʹõľֲ
+    // ӱʽ
+    size_t sharedSubexpressions = 0; // Ϊǰӱʽ
+
+    // ͳ
+    void print(std::ostream& out) const;
+};
+
+// ﷨Żµĳ򣬸ĶĽarenaУδĶĲԭãԭ䡣
+// Żͬһͬӱʽͬһ㣬ɴֵֻһΡ
+// ӱʽ԰ԴĵãfindPureFunctions
+// ֻͨ˴ɼ飨ûδֵȴ󣩵ʹãvariableCountΪĴС
+const Program* optimizeProgram(const Program& program, size_t variableCount, Arena& arena,
+    const OptimizerOptions& options, OptimizerStatistics& statistics);
+
+// ҳд䣬ֻдԼβΡֲͷֵõҲǴݹԼ
+// ĽֻȡʵΣ԰ʵλ档ذ̱±ıǣûгеĺΪfalse
+std::vector<bool> findPureFunctions(const Program& program);
+
+#endif
@@ -0,0 +1,194 @@
+#include <cstring>
+#include <iomanip>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PROFILER_USE_PERF 1
+#endif
+#include "phase_profiler.h"
+
+static const size_t COUNTER_COUNT = 3;
+
+#ifdef PROFILER_USE_PERF
+// һֻͳû̬Ӳ򿪺һֱinheritʹ֮󴴽߳Ҳͳ
+static int openCounter(uint64_t config)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+// ĵǰֵѽ̵߳ļ
+static uint64_t readCounter(int counter)
+{
+    uint64_t value = 0;
+    if (read(counter, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) return 0;
+    return value;
+}
+#endif
+
+PhaseProfiler::PhaseProfiler(StatsFormat format)
+    :format(format)
+    ,hardware(false)
+{
+    for (size_t i = 0; i < COUNTER_COUNT; ++i)
+    {
+        counters[i] = -1;
+        startValues[i] = 0;
+    }
+#ifdef PROFILER_USE_PERF
+    if (format == StatsFormat::NONE) return;
+    static const uint64_t configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+    };
+    hardware = true;
+    for (size_t i = 0; i < COUNTER_COUNT && hardware; ++i)
+    {
+        counters[i] = openCounter(configs[i]);
+        hardware = counters[i] >= 0;
+    }
+    // лȨ޲ʱ򲻿ֻʱ
+    if (!hardware)
+    {
+        for (size_t i = 0; i < COUNTER_COUNT; ++i)
+        {
+            if (counters[i] >= 0) close(counters[i]);
+            counters[i] = -1;
+        }
+    }
+#endif
+}
+
+PhaseProfiler::~PhaseProfiler()
+{
+#ifdef PROFILER_USE_PERF
+    for (size_t i = 0; i < COUNTER_COUNT; ++i)
+    {
+        if (counters[i] >= 0) close(counters[i]);
+    }
+#endif
+}
+
+void PhaseProfiler::beginPhase(const char* name)
+{
+    PhaseRecord record;
+    record.name = name;
+    phases.push_back(record);
+#ifdef PROFILER_USE_PERF
+    // ̵߳ļʱ룬PERF_EVENT_IOC_RESET岻Լֵʱ
+    if (hardware)
+    {
+        for (size_t i = 0; i < COUNTER_COUNT; ++i)
+        {
+            startValues[i] = readCounter(counters[i]);
+        }
+    }
+#endif
+    start = std::chrono::steady_clock::now();
+}
+
+void PhaseProfiler::endPhase()
+{
+    PhaseRecord& record = phases.back();
+    record.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#ifdef PROFILER_USE_PERF
+    if (hardware)
+    {
+        uint64_t values[COUNTER_COUNT];
+        for (size_t i = 0; i < COUNTER_COUNT; ++i)
+        {
+            uint64_t value = readCounter(counters[i]);
+            values[i] = value > startValues[i] ? value - startValues[i] : 0;
+        }
+        record.cycles = values[0];
+        record.instructions = values[1];
+        record.cacheMisses = values[2];
+    }
+#endif
+}
+
+void PhaseProfiler::printTable(std::ostream& out) const
+{
+    out << std::left << std::setw(10) << "phase" << std::right << std::setw(12) << "seconds";
+    if (hardware)
+    {
+        out << std::setw(16) << "cycles" << std::setw(16) << "instructions" << std::setw(8) << "IPC"
+            << std::setw(14) << "cache misses";
+    }
+    out << "\n";
+    for (const PhaseRecord& phase : phases)
+    {
+        out << std::left << std::setw(10) << phase.name << std::right << std::fixed
+            << std::setw(12) << std::setprecision(6) << phase.seconds;
+        if (hardware)
+        {
+            double ipc = phase.cycles > 0 ? static_cast<double>(phase.instructions) / static_cast<double>(phase.cycles) : 0;
+            out << std::setw(16) << phase.cycles << std::setw(16) << phase.instructions
+                << std::setw(8) << std::setprecision(2) << ipc << std::setw(14) << phase.cacheMisses;
+        }
+        out << "\n";
+    }
+    out << std::defaultfloat << std::setprecision(6);
+    if (!hardware)
+    {
+        out << "(hardware counters unavailable)\n";
+    }
+    for (const auto& item : counts)
+    {
+        out << item.first << ": " << item.second << "\n";
+    }
+    out.flush();
+}
+
+void PhaseProfiler::printJson(std::ostream& out) const
+{
+    out << "{\n"
+        << "  \"hardware_counters\": " << (hardware ? "true" : "false") << ",\n"
+        << "  \"phases\": [\n";
+    for (size_t i = 0; i < phases.size(); ++i)
+    {
+        const PhaseRecord& phase = phases[i];
+        out << "    {\n"
+            << "      \"phase\": \"" << phase.name << "\",\n"
+            << "      \"seconds\": " << std::fixed << std::setprecision(6) << phase.seconds << std::defaultfloat;
+        if (hardware)
+        {
+            out << ",\n"
+                << "      \"cycles\": " << phase.cycles << ",\n"
+                << "      \"instructions\": " << phase.instructions << ",\n"
+                << "      \"cache_misses\": " << phase.cacheMisses;
+        }
+        out << "\n"
+            << "    }" << (i + 1 < phases.size() ? "," : "") << "\n";
+    }
+    out << "  ]";
+    for (const auto& item : counts)
+    {
+        out << ",\n"
+            << "  \"" << item.first << "\": " << item.second;
+    }
+    out << "\n"
+        << "}" << std::endl;
+}
+
+void PhaseProfiler::report(std::ostream& out) const
+{
+    switch (format)
+    {
+    case StatsFormat::TABLE:
+        printTable(out);
+        break;
+    case StatsFormat::JSON:
+        printJson(out);
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef PHASE_PROFILER_H
+#define PHASE_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ͳƵʽNONEʾͳ
+enum class StatsFormat
+{
+    NONE,
+    TABLE,
+    JSON,
+};
+
+// һ׶εĲ
+struct PhaseRecord
+{
+    std::string name;
+    double seconds = 0;
+    // ӲʱΪ0
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cacheMisses = 0;
+};
+
+// ׶μʱperf_event_openʱLinuxȡָͻδ
+// 󴴽߳ͬЧˮ߷ʽ´ʷ̵߳Ŀͬһ׶Ρ
+// δʱͷֱӷأ򿪼Ҳʱ
+class PhaseProfiler
+{
+private:
+    StatsFormat format;
+    bool hardware; // ӲǷѴ
+    int counters[3]; // ָδļ
+    uint64_t startValues[3]; // ǰ׶οʼʱֵ
+    std::vector<PhaseRecord> phases;
+    std::vector<std::pair<std::string, uint64_t>> counts; // Ǽǵ˳
+    std::chrono::steady_clock::time_point start; // ǰ׶οʼʱ
+
+    PhaseProfiler(const PhaseProfiler&) = delete;
+    PhaseProfiler& operator=(const PhaseProfiler&) = delete;
+
+    void beginPhase(const char* name);
+    void endPhase();
+    void printTable(std::ostream& out) const;
+    void printJson(std::ostream& out) const;
+
+public:
+    explicit PhaseProfiler(StatsFormat format = StatsFormat::NONE);
+    ~PhaseProfiler();
+
+    bool isEnabled() const
+    {
+        return format != StatsFormat::NONE;
+    }
+
+    // ʼһ׶ΣendɶʹãǶ
+    void begin(const char* name)
+    {
+        if (format == StatsFormat::NONE) return;
+        beginPhase(name);
+    }
+
+    void end()
+    {
+        if (format == StatsFormat::NONE) return;
+        endPhase();
+    }
+
+    // ¼һ絥Ԫ
+    void count(const char* name, uint64_t value)
+    {
+        if (format == StatsFormat::NONE) return;
+        counts.emplace_back(name, value);
+    }
+
+    // ѡĸʽȫ׶κͼδʱʲôҲ
+    void report(std::ostream& out) const;
+};
+
+#endif
@@ -0,0 +1,436 @@
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include "program_generator.h"
+
+// ܵôֽдļ
+static const size_t OUTPUT_CHUNK = 1 << 20;
+// Ԥôֽڣ˵ʣԤ㲻ʱֻ˵
+static const uint64_t MIN_FUNCTION_BYTES = 256;
+// ûŵ
+static const uint64_t NONE = UINT64_MAX;
+// ǰ׺ʮɣ뱣ͬ
+static const char VARIABLE_PREFIX = 'v';
+static const char PARAMETER_PREFIX = 'p';
+static const char FUNCTION_PREFIX = 'f';
+static const char UNDEFINED_PREFIX = 'u'; // עδ˵
+// ʷ16ַ
+static const char* const LONG_IDENTIFIER = "identifiertoolong";
+
+// עĴ
+enum class InjectedError
+{
+    INVALID_CHARACTER, // ǰǷַ
+    LONG_IDENTIFIER, // ʽеıʶ
+    MISSING_THEN, // ȱthen
+    MISSING_PARENTHESIS, // дȱ
+    UNDEFINED_NAME, // δ˵ıֵ
+};
+
+// ȵ˳ɷֳÿֳֽԤ˵ִ䣬ڲ㺯һԤ
+class ProgramGenerator
+{
+private:
+    // һֳ˵кڲɼ
+    struct Scope
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> variables; // ıŶ(׸, )
+        uint64_t variableCount = 0;
+        std::vector<uint64_t> functions; // ĺ
+        uint64_t function = NONE; // ֳĺΪNONE
+        uint64_t parameter = NONE; // β
+    };
+
+    const GeneratorOptions& options;
+    GeneratorStatistics& stats;
+    std::ofstream& output;
+    std::string buffer; // δдļ
+    uint64_t flushed; // дļֽ
+    std::mt19937_64 random;
+    std::vector<Scope> scopes; // 򵽵ǰֳ
+    uint64_t nextName; // һֵţȫֹã֤Ψһ
+
+    uint64_t position() const
+    {
+        return flushed + buffer.size();
+    }
+
+    void flush()
+    {
+        output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        flushed += buffer.size();
+        buffer.clear();
+    }
+
+    // 0n-1֮
+    uint64_t below(uint64_t n)
+    {
+        return random() % n;
+    }
+
+    // Ըptrueֻ㣬ƽ̨޹
+    bool chance(double p)
+    {
+        return static_cast<double>(random() >> 11) * (1.0 / 9007199254740992.0) < p;
+    }
+
+    void newLine(size_t depth)
+    {
+        buffer += '\n';
+        ++stats.lines;
+        buffer.append(depth * 2, ' ');
+        if (buffer.size() >= OUTPUT_CHUNK) flush();
+    }
+
+    // ǰ׺ϲ㳤ȵţųʱ֮ӳȻΨһ
+    void writeName(char prefix, uint64_t id)
+    {
+        char digits[24];
+        size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + id % 10);
+            id /= 10;
+        } while (id != 0);
+        buffer += prefix;
+        if (count + 1 < options.identifierLength)
+        {
+            buffer.append(options.identifierLength - 1 - count, '0');
+        }
+        while (count > 0)
+        {
+            buffer += digits[--count];
+        }
+    }
+
+    // ѡһɼıβΣһȡǰֳ
+    void writeVariable()
+    {
+        const Scope& scope = scopes[chance(0.5) ? scopes.size() - 1 : below(scopes.size())];
+        uint64_t candidates = scope.variableCount + (scope.parameter != NONE ? 1 : 0);
+        uint64_t pick = below(candidates);
+        if (pick == scope.variableCount)
+        {
+            writeName(PARAMETER_PREFIX, scope.parameter);
+            return;
+        }
+        for (const auto& run : scope.variables)
+        {
+            if (pick < run.second)
+            {
+                writeName(VARIABLE_PREFIX, run.first + pick);
+                return;
+            }
+            pick -= run.second;
+        }
+    }
+
+    // ɵõĺĺԼɵĸ㺯
+    uint64_t countFunctions() const
+    {
+        uint64_t count = 0;
+        for (const Scope& scope : scopes)
+        {
+            count += scope.functions.size() + (scope.function != NONE ? 1 : 0);
+        }
+        return count;
+    }
+
+    void writeFunction(uint64_t pick)
+    {
+        for (const Scope& scope : scopes)
+        {
+            if (pick < scope.functions.size())
+            {
+                writeName(FUNCTION_PREFIX, scope.functions[pick]);
+                return;
+            }
+            pick -= scope.functions.size();
+            if (scope.function != NONE)
+            {
+                if (pick == 0)
+                {
+                    writeName(FUNCTION_PREFIX, scope.function);
+                    return;
+                }
+                --pick;
+            }
+        }
+    }
+
+    void writeFactor(bool allowCalls)
+    {
+        uint64_t kind = below(10);
+        uint64_t functions = allowCalls ? countFunctions() : 0;
+        if (kind < 5)
+        {
+            writeVariable();
+        }
+        else if (kind < 8 || functions == 0)
+        {
+            buffer += std::to_string(below(1000));
+        }
+        else
+        {
+            // ʵвǶ׵ãһй
+            writeFunction(below(functions));
+            buffer += '(';
+            writeExpression(false);
+            buffer += ')';
+        }
+    }
+
+    void writeExpression(bool allowCalls)
+    {
+        uint64_t factors = 1 + below(3);
+        for (uint64_t i = 0; i < factors; ++i)
+        {
+            if (i > 0) buffer += chance(0.5) ? '-' : '*';
+            writeFactor(allowCalls);
+        }
+    }
+
+    void writeCondition()
+    {
+        static const char* const relations[] = { "<", "<=", ">", ">=", "=", "<>" };
+        writeExpression(true);
+        buffer += relations[below(6)];
+        writeExpression(true);
+    }
+
+    // ֵ䣬ʱֵ
+    void writeAssignment()
+    {
+        uint64_t function = scopes.back().function;
+        if (function != NONE && chance(0.2))
+        {
+            writeName(FUNCTION_PREFIX, function);
+        }
+        else
+        {
+            writeVariable();
+        }
+        buffer += ":=";
+        writeExpression(true);
+    }
+
+    void writeStatement()
+    {
+        uint64_t kind = below(20);
+        if (kind < 10)
+        {
+            writeAssignment();
+        }
+        else if (kind < 14)
+        {
+            buffer += "if ";
+            writeCondition();
+            buffer += " then ";
+            writeAssignment();
+            if (chance(0.5))
+            {
+                buffer += " else ";
+                writeAssignment();
+            }
+        }
+        else if (kind < 17)
+        {
+            buffer += "write(";
+            writeVariable();
+            buffer += ')';
+        }
+        else
+        {
+            buffer += "read(";
+            writeVariable();
+            buffer += ')';
+        }
+    }
+
+    // һ
+    void writeError(InjectedError error)
+    {
+        switch (error)
+        {
+        case InjectedError::INVALID_CHARACTER:
+            ++stats.lexicalErrors;
+            buffer += '#';
+            writeStatement();
+            break;
+        case InjectedError::LONG_IDENTIFIER:
+            ++stats.lexicalErrors;
+            writeVariable();
+            buffer += ":=";
+            buffer += LONG_IDENTIFIER;
+            break;
+        case InjectedError::MISSING_THEN:
+            ++stats.syntaxErrors;
+            buffer += "if ";
+            writeCondition();
+            buffer += ' ';
+            writeAssignment();
+            break;
+        case InjectedError::MISSING_PARENTHESIS:
+            ++stats.syntaxErrors;
+            buffer += "write(";
+            writeVariable();
+            break;
+        case InjectedError::UNDEFINED_NAME:
+            ++stats.syntaxErrors;
+            writeName(UNDEFINED_PREFIX, below(1000));
+            buffer += ":=";
+            writeExpression(true);
+            break;
+        }
+    }
+
+    void declareVariable(size_t depth)
+    {
+        Scope& scope = scopes.back();
+        uint64_t id = nextName++;
+        if (!scope.variables.empty() && scope.variables.back().first + scope.variables.back().second == id)
+        {
+            ++scope.variables.back().second;
+        }
+        else
+        {
+            scope.variables.emplace_back(id, 1);
+        }
+        ++scope.variableCount;
+        ++stats.variables;
+        buffer += "integer ";
+        writeName(VARIABLE_PREFIX, id);
+        buffer += ';';
+        newLine(depth);
+    }
+
+    // ɺ˵䣬Լռbudgetֽ
+    void declareFunction(uint64_t budget, size_t depth)
+    {
+        uint64_t function = nextName++;
+        uint64_t parameter = nextName++;
+        ++stats.functions;
+        buffer += "integer function ";
+        writeName(FUNCTION_PREFIX, function);
+        buffer += '(';
+        writeName(PARAMETER_PREFIX, parameter);
+        buffer += ");";
+        newLine(depth);
+        generateBlock(budget, depth, function, parameter);
+        buffer += ';';
+        scopes.back().functions.push_back(function);
+    }
+
+public:
+    ProgramGenerator(const GeneratorOptions& options, GeneratorStatistics& statistics, std::ofstream& output)
+        :options(options)
+        ,stats(statistics)
+        ,output(output)
+        ,flushed(0)
+        ,random(options.seed)
+        ,nextName(0)
+    {}
+
+    // ɴbeginendķֳend֮ķֺŻļβɵߴ
+    // Ƕʱķ֮Ԥڲ㺯İָ˵ִ
+    void generateBlock(uint64_t budget, size_t depth, uint64_t function, uint64_t parameter)
+    {
+        Scope scope;
+        scope.function = function;
+        scope.parameter = parameter;
+        scopes.push_back(std::move(scope));
+        bool nested = scopes.size() - 1 < options.maxDepth;
+        uint64_t functionBudget = nested ? budget / 4 * 3 : 0;
+        uint64_t ownBudget = budget - functionBudget;
+        uint64_t variableBudget = ownBudget * options.declarationPercent / 100;
+        uint64_t statementBudget = ownBudget - variableBudget;
+
+        buffer += "begin";
+        newLine(depth + 1);
+        if (parameter != NONE)
+        {
+            buffer += "integer ";
+            writeName(PARAMETER_PREFIX, parameter);
+            buffer += ';';
+            newLine(depth + 1);
+        }
+
+        // ˵֣һǱ˵ִ֤бã
+        // ֮ʣԤѡ˵Ǻ
+        uint64_t variableBytes = 0;
+        uint64_t functionBytes = 0;
+        bool first = true;
+        while (true)
+        {
+            uint64_t variablesLeft = variableBytes < variableBudget ? variableBudget - variableBytes : 0;
+            uint64_t functionsLeft = functionBytes + MIN_FUNCTION_BYTES <= functionBudget ? functionBudget - functionBytes : 0;
+            if (!first && variablesLeft == 0 && functionsLeft == 0) break;
+            uint64_t start = position();
+            if (first || below(variablesLeft + functionsLeft) < variablesLeft)
+            {
+                declareVariable(depth + 1);
+                variableBytes += position() - start;
+            }
+            else
+            {
+                uint64_t size = budget / 16 + below(budget / 16 * 3 + 1);
+                if (size < MIN_FUNCTION_BYTES) size = MIN_FUNCTION_BYTES;
+                if (size > functionsLeft) size = functionsLeft;
+                declareFunction(size, depth + 1);
+                newLine(depth + 1);
+                functionBytes += position() - start;
+            }
+            first = false;
+        }
+
+        // ִһ
+        uint64_t statementStart = position();
+        first = true;
+        while (first || position() - statementStart < statementBudget)
+        {
+            if (!first)
+            {
+                buffer += ';';
+                newLine(depth + 1);
+            }
+            if (options.errorRate > 0 && chance(options.errorRate))
+            {
+                writeError(static_cast<InjectedError>(below(static_cast<uint64_t>(InjectedError::UNDEFINED_NAME) + 1)));
+            }
+            else
+            {
+                writeStatement();
+            }
+            ++stats.statements;
+            first = false;
+        }
+        newLine(depth);
+        buffer += "end";
+        scopes.pop_back();
+    }
+
+    // дʣ
+    bool generate()
+    {
+        generateBlock(options.targetBytes, 0, NONE, NONE);
+        newLine(0);
+        flush();
+        stats.bytes = flushed;
+        return output.good();
+    }
+};
+
+bool generateProgram(const std::string& fileName, const GeneratorOptions& options, GeneratorStatistics& statistics)
+{
+    std::ofstream output(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+    {
+        std::cerr << "Could not open the file - '" << fileName << "'" << std::endl;
+        return false;
+    }
+    statistics = GeneratorStatistics();
+    ProgramGenerator generator(options, statistics, output);
+    return generator.generate();
+}
@@ -0,0 +1,35 @@
+#ifndef PROGRAM_GENERATOR_H
+#define PROGRAM_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+// ɳĲ
+struct GeneratorOptions
+{
+    uint64_t targetBytes = 64 * 1024; // Ĵֽ
+    size_t maxDepth = 3; // Ƕ׵0ʾֻ
+    size_t identifierLength = 8; // ʶĳȣȫʱԶӳ16ıʶǴʷ
+    unsigned declarationPercent = 30; // ÿֳĴ루ڲ㺯б˵ռֽڵİٷֱ
+    double errorRate = 0; // ÿִעһʷ﷨ĸ
+    uint64_t seed = 1; // ӣͬʱɵĳͬ
+};
+
+// ɽͳ
+struct GeneratorStatistics
+{
+    uint64_t bytes = 0;
+    uint64_t lines = 0;
+    uint64_t functions = 0;
+    uint64_t variables = 0; // ˵䣬βε˵
+    uint64_t statements = 0; // ִ䣬еķ֧
+    uint64_t lexicalErrors = 0; // עĴʷ
+    uint64_t syntaxErrors = 0; // ע﷨󣻷һעͬеĴ֮ٱ
+};
+
+// һϷĳдfileNameɱдڴб򣬿GBļ
+// ֶΨһģֻʹλÿɼıͺerrorRate0ʱøִע
+// ļ򲻿дʧʱfalse
+bool generateProgram(const std::string& fileName, const GeneratorOptions& options, GeneratorStatistics& statistics);
+
+#endif
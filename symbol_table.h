@@ -0,0 +1,112 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+// űеһָ̱еļ¼
+struct Symbol 
+{
+    bool isProcedure; // trueʾ̣falseʾβ
+    size_t index; // varListproListе±
+};
+
+// Ƕײ֯ķűÿһϣ뺯ʱѹջ뿪ʱջ
+class SymbolTable 
+{
+public:
+    // Ǽ˳ŵֱֵΪֵһεǼʱźͷ
+    typedef std::unordered_map<std::string, std::pair<size_t, Symbol>> OrderedNames;
+
+private:
+    std::vector<std::unordered_map<std::string, Symbol>> scopes; // ֵŵӳ
+    std::vector<std::string> owners; // ĹΪmain
+    const OrderedNames* inherited; // ʱǰѵǼǵ֣СinheritedLimitĲ
+    size_t inheritedLimit;
+
+    // ڼ̳ев
+    const Symbol* findInherited(const std::string& name) const
+    {
+        if (inherited == nullptr) return nullptr;
+        auto it = inherited->find(name);
+        return it != inherited->end() && it->second.first < inheritedLimit ? &it->second.second : nullptr;
+    }
+
+public:
+    // 캯ڵ
+    SymbolTable()
+        :inherited(nullptr)
+        ,inheritedLimit(0)
+    {
+        enterScope("main");
+    }
+
+    // һ̵
+    void enterScope(const std::string& owner)
+    {
+        scopes.emplace_back();
+        owners.push_back(owner);
+    }
+
+    // 뿪ǰ㲻ᱻ
+    void leaveScope()
+    {
+        if (scopes.size() > 1)
+        {
+            scopes.pop_back();
+            owners.pop_back();
+        }
+    }
+
+    // namesСlimitֵǼǣµǼǣnamesʹڼЧ
+    void inherit(const OrderedNames* names, size_t limit)
+    {
+        inherited = names;
+        inheritedLimit = limit;
+    }
+
+    // ǰĲֻʱΪ1
+    size_t depth() const
+    {
+        return scopes.size();
+    }
+
+    // ǰĹ
+    const std::string& currentOwner() const
+    {
+        return owners.back();
+    }
+
+    // ڵǰǼ֣ͬѴʱԭĵǼǲfalse
+    bool define(const std::string& name, const Symbol& symbol)
+    {
+        if (scopes.size() == 1 && findInherited(name) != nullptr) return false;
+        return scopes.back().emplace(name, symbol).second;
+    }
+
+    // һǼ֣ںⶼܿ
+    bool defineInEnclosing(const std::string& name, const Symbol& symbol)
+    {
+        size_t depth = scopes.size() > 1 ? scopes.size() - 2 : 0;
+        if (depth == 0 && findInherited(name) != nullptr) return false;
+        return scopes[depth].emplace(name, symbol).second;
+    }
+
+    // ֣Ҳnullptr
+    const Symbol* lookup(const std::string& name) const
+    {
+        for (size_t i = scopes.size(); i-- > 0;)
+        {
+            auto it = scopes[i].find(name);
+            if (it != scopes[i].end())
+            {
+                return &it->second;
+            }
+        }
+        return findInherited(name);
+    }
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef TABLE_WRITER_H
+#define TABLE_WRITER_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+
+// ࣺļֻһΣضԭݣ벹ոдɸõĴ󻺳
+// дʱдÿ¼򿪡رһļҲڴеַ
+class TableWriter 
+{
+private:
+    std::ofstream out; // ļ
+    std::string* target; // Ϊnullptrʱ׷ӵַдļ
+    std::string buffer; // ʽ
+    static const size_t FIELD_WIDTH = 10; // ÿп
+    static const size_t FLUSH_SIZE = 1 << 16; // ﵽ64KBʱд
+
+public:
+    // 캯򿪲ضļ
+    explicit TableWriter(const std::string& output_path)
+        :out(output_path, std::ios::out | std::ios::trunc)
+        ,target(nullptr)
+    {
+        if (!out.is_open()) 
+        {
+            std::cerr << "Failed to open file: " << output_path << '\n';
+        }
+        buffer.reserve(FLUSH_SIZE + 256);
+    }
+
+    // ׷ӵtargetдļʱͬ
+    explicit TableWriter(std::string& target)
+        :target(&target)
+    {}
+
+    // ʱдʣ
+    ~TableWriter()
+    {
+        flush();
+    }
+
+    TableWriter(const TableWriter&) = delete;
+    TableWriter& operator=(const TableWriter&) = delete;
+
+    bool isOpen() const
+    {
+        return target != nullptr || out.is_open();
+    }
+
+    // дһַУпʱҲಹո񣬳ʱԭ
+    TableWriter& field(const std::string& value)
+    {
+        buffer.append(value);
+        if (value.size() < FIELD_WIDTH) 
+        {
+            buffer.append(FIELD_WIDTH - value.size(), ' ');
+        }
+        return *this;
+    }
+
+    // дһУֱڻת
+    TableWriter& field(size_t value)
+    {
+        char digits[24];
+        size_t length = 0;
+        do 
+        {
+            digits[sizeof(digits) - 1 - length] = static_cast<char>('0' + value % 10);
+            value /= 10;
+            ++length;
+        } while (value != 0);
+        buffer.append(digits + sizeof(digits) - length, length);
+        if (length < FIELD_WIDTH) 
+        {
+            buffer.append(FIELD_WIDTH - length, ' ');
+        }
+        return *this;
+    }
+
+    // һУʱд
+    void endRow()
+    {
+        buffer.push_back('\n');
+        if (buffer.size() >= FLUSH_SIZE) 
+        {
+            flush();
+        }
+    }
+
+    // ѻһдļ
+    void flush()
+    {
+        if (target != nullptr) 
+        {
+            target->append(buffer);
+        }
+        else if (!buffer.empty() && out.is_open()) 
+        {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+        buffer.clear();
+    }
+};
+
+#endif
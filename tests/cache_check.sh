@@ -0,0 +1,57 @@
+#!/bin/bash
+# 编译缓存的检查：
+# 1. 多个进程同时用同一缓存目录编译若干程序（既有命中也有未命中，上限很小使淘汰频繁发生），
+#    目录中累计的命中和未命中次数之和必须等于编译次数，写出的结果文件必须与不用缓存时相同；
+# 2. 把一个程序的条目换成另一个程序的条目（模拟文件名散列的碰撞），不得当作命中。
+# CACHE_PROCESSES指定每轮同时运行的进程数（默认16），CACHE_ROUNDS指定轮数（默认4）
+set -eu
+source "$(dirname "$0")/common.sh"
+cd "$WORK"
+
+processes=${CACHE_PROCESSES:-16}
+rounds=${CACHE_ROUNDS:-4}
+outputs="variableList.var processList.pro lexicalError.err grammarError.err"
+for i in $(seq 1 "$processes"); do
+    mkdir "p$i"
+    # 只有4个不同的程序，同一轮中就会有命中
+    "$COMPILER" -generate 4K -seed $((i % 4 + 1)) "p$i/source.pas" 2> /dev/null
+    (cd "p$i" && "$COMPILER" source.pas > /dev/null 2>&1 || true)
+    for file in $outputs; do
+        mv "p$i/$file" "p$i/plain.$file"
+    done
+done
+
+for round in $(seq 1 "$rounds"); do
+    for i in $(seq 1 "$processes"); do
+        (cd "p$i" && "$COMPILER" -cache "$WORK/cache" -cachesize 24K source.pas > /dev/null 2>&1 || true) &
+    done
+    wait
+done
+
+hits=$(awk '$1 == "hits" { print $2 }' cache/statistics)
+misses=$(awk '$1 == "misses" { print $2 }' cache/statistics)
+[ $((hits + misses)) -eq $((processes * rounds)) ] \
+    || fail "$((processes * rounds)) compiles recorded as $hits hits and $misses misses"
+echo "$hits hits, $misses misses"
+
+# 最后一轮写出的结果（来自命中或未命中）与不用缓存时相同
+for i in $(seq 1 "$processes"); do
+    for file in $outputs; do
+        cmp -s "p$i/$file" "p$i/plain.$file" || fail "p$i: $file differs from a compile without the cache"
+    done
+done
+
+# 第1个和第2个程序不同（种子2和3），把前者的条目放到后者的文件名下
+rm -rf collision
+(cd p1 && "$COMPILER" -cache "$WORK/collision" source.pas > /dev/null 2>&1 || true)
+first=$(ls collision/*.cache)
+(cd p2 && "$COMPILER" -cache "$WORK/collision" source.pas > /dev/null 2>&1 || true)
+second=$(ls collision/*.cache | grep -v "$first")
+cp "$first" "$second"
+(cd p2 && "$COMPILER" -cache "$WORK/collision" -cachestats source.pas > /dev/null 2> stats.txt || true)
+grep -q "^cache miss" p2/stats.txt || fail "an entry stored for another source was taken as a hit: $(cat p2/stats.txt)"
+for file in $outputs; do
+    cmp -s "p2/$file" "p2/plain.$file" || fail "p2: $file differs after a colliding entry"
+done
+
+finish
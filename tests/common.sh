@@ -0,0 +1,33 @@
+# 各检查脚本共用：建立临时工作目录，准备编译器。
+# 环境变量COMPILER指定已编译好的编译器时直接使用，否则用g++从仓库根目录的源文件编译一份；
+# CXXFLAGS可覆盖默认的编译选项。脚本结束时删除工作目录，KEEP_WORK=1时保留
+ROOT=$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)
+WORK=$(mktemp -d)
+if [ "${KEEP_WORK:-0}" = 1 ]; then
+    echo "work directory: $WORK"
+else
+    trap 'rm -rf "$WORK"' EXIT
+fi
+
+if [ -z "${COMPILER:-}" ]; then
+    COMPILER="$WORK/compiler"
+    ${CXX:-g++} -std=c++17 ${CXXFLAGS:--O2} -pthread "$ROOT"/*.cpp -o "$COMPILER"
+fi
+COMPILER=$(cd "$(dirname "$COMPILER")" && pwd)/$(basename "$COMPILER")
+
+FAILURES=0
+
+fail()
+{
+    echo "FAIL: $*"
+    FAILURES=$((FAILURES + 1))
+}
+
+finish()
+{
+    if [ "$FAILURES" -gt 0 ]; then
+        echo "$FAILURES check(s) failed"
+        exit 1
+    fi
+    echo "all checks passed"
+}
@@ -0,0 +1,13 @@
+begin
+ integer x;
+
+ x:=12;	x:=x-1
+  veryveryverylongidentifier1 := 3 ;
+a<>b<=c>=d<e>f:=g=h(i)*j;
+< 
+> : x :y #
+
+
+12abc abc12 0 007 EOLN EOF identifier constant
+if x then write(x) else read(y)
+end
\ No newline at end of file
@@ -0,0 +1,1491 @@
+begin
+  integer v0000000;
+  integer function f0000001(p0000002);
+  begin
+    integer p0000002;
+    integer v0000003;
+    integer function f0000004(p0000005);
+    begin
+      integer p0000005;
+      integer v0000006;
+      integer v0000007;
+      integer function f0000008(p0000009);
+      begin
+        integer p0000009;
+        integer v0000010;
+        integer v0000011;
+        integer v0000012;
+        v0000012:=677;
+        v0000000:=p0000009-266;
+        if 860*v0000011=v0000010*v0000012*f0000008(652) then f0000008:=v0000012-v0000000-v0000010 else p0000002:=v0000010-v0000006;
+        if 383-v0000006-f0000001(908-976)<=591 then v0000010:=v0000012*286
+      end;
+      integer v0000013;
+      read(v0000003);
+      write(p0000005);
+      if f0000008(v0000000*v0000007)-518*v0000000=p0000005*f0000004(791)*471 then v0000000:=135;
+      p0000005:=914
+    end;
+    integer function f0000014(p0000015);
+    begin
+      integer p0000015;
+      integer v0000016;
+      integer function f0000017(p0000018);
+      begin
+        integer p0000018;
+        integer v0000019;
+        integer v0000020;
+        integer v0000021;
+        v0000019:=923*f0000017(516);
+        if v0000021-804>v0000020*10 v0000021:=p0000018*v0000021;
+        write(v0000003);
+        read(v0000000);
+        v0000000:=575-v0000020*p0000015
+      end;
+      integer function f0000022(p0000023);
+      begin
+        integer p0000023;
+        integer v0000024;
+        integer v0000025;
+        integer v0000026;
+        if p0000023*p0000015>=v0000024*v0000024 then p0000023:=v0000025-f0000001(156-757);
+        v0000025:=v0000026;
+        if 621*v0000024=v0000025-p0000002 then v0000024:=f0000017(432)*f0000004(p0000023*v0000026-181)-f0000004(492-465) else v0000000:=336
+      end;
+      integer v0000027;
+      integer v0000028;
+      integer v0000029;
+      write(v0000027);
+      if v0000027-809*v0000016=v0000016-v0000000-v0000003 then f0000014:=f0000022(v0000003-v0000029);
+      write(p0000015);
+      write(p0000002);
+      v0000028:=f0000014(v0000028-v0000027*v0000027)-v0000028*f0000014(v0000000)
+    end;
+    integer function f0000030(p0000031);
+    begin
+      integer p0000031;
+      integer v0000032;
+      integer function f0000033(p0000034);
+      begin
+        integer p0000034;
+        integer v0000035;
+        integer v0000036;
+        integer v0000037;
+        if 257-v0000036<v0000037-927 then f0000033:=p0000034*988 else f0000033:=v0000035-76-f0000014(771);
+        v0000035:=v0000037;
+        if v0000037*v0000000>51-v0000003 then v0000000:=253-f0000004(v0000037-578)
+      end;
+      integer function f0000038(p0000039);
+      begin
+        integer p0000039;
+        integer v0000040;
+        integer v0000041;
+        integer v0000042;
+        if v0000041-285-v0000040>v0000040 then v0000042:=754*f0000004(v0000040);
+        if p0000039-v0000003*p0000039<=v0000003*v0000032 then v0000041:=f0000001(v0000042)*p0000039*974 else p0000039:=v0000003
+      end;
+      integer function f0000043(p0000044);
+      begin
+        integer p0000044;
+        integer v0000045;
+        integer v0000046;
+        integer v0000047;
+        read(p0000044);
+        if 666<=f0000043(358)-392-v0000000 then v0000046:=391;
+        f0000043:=68-v0000032-p0000044;
+        if p0000044-v0000047-640<=29*264 then p0000002:=f0000030(556-186*901) else v0000045:=v0000032*p0000044
+      end;
+      integer v0000048;
+      integer v0000049;
+      integer v0000050;
+      integer v0000051;
+      read(v0000048);
+      f0000030:=f0000038(v0000003*178-280)-v0000000;
+      v0000032:=147*96;
+      write(v0000000);
+      write(v0000050);
+      if f0000001(112)*666*f0000001(v0000032-660)>=286*v0000048-p0000031 then f0000030:=f0000001(240*322-665);
+      if v0000049*f0000001(v0000051*204)=v0000000 then v0000049:=v0000048*f0000038(v0000050*685-987)*v0000032 else v0000050:=f0000001(365-102)
+    end;
+    integer function f0000052(p0000053);
+    begin
+      integer p0000053;
+      integer v0000054;
+      integer function f0000055(p0000056);
+      begin
+        integer p0000056;
+        integer v0000057;
+        integer v0000058;
+        integer v0000059;
+        write(v0000058);
+        v0000059:=f0000055(v0000057-211)*f0000004(685);
+        v0000059:=p0000053-p0000056;
+        if f0000055(v0000057-v0000057*684)*f0000004(103-726*361)*483=v0000059 then v0000059:=v0000057-f0000001(261) else f0000055:=v0000057
+      end;
+      integer v0000060;
+      integer v0000061;
+      if p0000002-v0000060*p0000002<=339 then v0000061:=v0000000 else p0000002:=p0000002-p0000053;
+      read(p0000053);
+      f0000052:=f0000052(229*346)*f0000001(v0000061*v0000054*v0000061)
+    end;
+    integer function f0000062(p0000063);
+    begin
+      integer p0000063;
+      integer v0000064;
+      integer function f0000065(p0000066);
+      begin
+        integer p0000066;
+        integer v0000067;
+        integer v0000068;
+        integer v0000069;
+        if v0000069<62-v0000000 then p0000066:=p0000002*580;
+        if v0000000=v0000000*f0000001(730) then v0000003:=f0000004(v0000069-v0000069-p0000002)*f0000014(v0000069) else v0000069:=v0000067
+      end;
+      integer function f0000070(p0000071);
+      begin
+        integer p0000071;
+        integer v0000072;
+        integer v0000073;
+        integer v0000074;
+        p0000071:=f0000014(p0000063)*247;
+        v0000073:=p0000063;
+        read(v0000072);
+        v0000073:=v0000073-p0000002*p0000002;
+        v0000000:=p0000002-f0000052(p0000071-p0000063*p0000002)
+      end;
+      integer v0000075;
+      integer v0000076;
+      integer v0000077;
+      p0000063:=p0000002;
+      read(v0000003);
+      v0000000:=f0000052(v0000064-82);
+      read(p0000002);
+      f0000062:=407-v0000076*v0000077;
+      p0000063:=731-v0000077;
+      p0000063:=f0000062(v0000077)-v0000000
+    end;
+    integer v0000078;
+    integer v0000079;
+    integer v0000080;
+    integer v0000081;
+    integer v0000082;
+    integer v0000083;
+    integer v0000084;
+    integer v0000085;
+    integer v0000086;
+    integer v0000087;
+    integer v0000088;
+    integer v0000089;
+    integer v0000090;
+    integer v0000091;
+    integer v0000092;
+    integer v0000093;
+    integer v0000094;
+    integer v0000095;
+    integer v0000096;
+    integer v0000097;
+    integer v0000098;
+    integer v0000099;
+    integer v0000100;
+    integer v0000101;
+    integer v0000102;
+    write(v0000083);
+    if 242>=222-v0000100-v0000000 then v0000084:=f0000004(820*27)-v0000000 else v0000081:=564;
+    if f0000014(v0000084)*639=v0000102 then v0000000:=v0000089 else v0000088:=763-272;
+    f0000001:=495*v0000086;
+    f0000001:=420*f0000030(v0000000);
+    v0000095:=v0000097-v0000000*f0000030(401-574);
+    v0000079:=740;
+    v0000100:=v0000095-v0000080;
+    if v0000080-518=f0000052(773-v0000101) then v0000093:=v0000000-762*20 else v0000000:=v0000078;
+    if v0000000>=v0000081-v0000096 then v0000000:=v0000089-v0000000*v0000086;
+    v0000097:=p0000002-v0000000;
+    v0000101:=48-f0000004(518-660)-23;
+    f0000001:=f0000014(v0000095);
+    f0000001:=245;
+    read(v0000000);
+    write(v0000089);
+    v0000093:=p0000002-f0000052(387*v0000088*v0000079)*572;
+    v0000000:=862-v0000099;
+    v0000000:=v0000091-v0000000;
+    write(v0000003);
+    if 294-v0000093=v0000087*v0000000-585 then v0000086:=116-914*v0000083;
+    write(v0000000);
+    f0000001:=f0000052(982)*943-v0000079;
+    v0000085:=851;
+    f0000001:=v0000093-936;
+    v0000083:=7-f0000052(632*v0000078);
+    if v0000003-362*602<=v0000000 then v0000086:=632*917 else f0000001:=f0000014(p0000002*355-328)-v0000093-796;
+    write(v0000098);
+    if 174*56-v0000000<>v0000089-v0000098 then f0000001:=v0000091*v0000089 else v0000079:=v0000097
+  end;
+  integer function f0000103(p0000104);
+  begin
+    integer p0000104;
+    integer v0000105;
+    integer function f0000106(p0000107);
+    begin
+      integer p0000107;
+      integer v0000108;
+      integer function f0000109(p0000110);
+      begin
+        integer p0000110;
+        integer v0000111;
+        integer v0000112;
+        integer v0000113;
+        integer v0000114;
+        v0000000:=960;
+        if v0000111*v0000105*v0000114<587 then p0000110:=p0000110;
+        if v0000000>=v0000000 then f0000109:=p0000107;
+        p0000104:=423-v0000111;
+        write(v0000114);
+        if 985<=718*f0000109(v0000105*863)-f0000103(626*v0000114-v0000112) then f0000109:=p0000110 else v0000000:=770*v0000114*v0000113
+      end;
+      integer function f0000115(p0000116);
+      begin
+        integer p0000116;
+        integer v0000117;
+        integer v0000118;
+        integer v0000119;
+        integer v0000120;
+        integer v0000121;
+        if f0000103(v0000000*v0000108)-f0000001(508*915*957)-v0000108<p0000116-172 then v0000000:=v0000120*v0000120 else p0000116:=v0000120;
+        read(p0000116);
+        v0000108:=v0000118-472*v0000121;
+        v0000105:=v0000117;
+        v0000121:=553*v0000121*v0000118
+      end;
+      integer v0000122;
+      integer v0000123;
+      integer v0000124;
+      integer v0000125;
+      integer v0000126;
+      v0000126:=f0000109(918*v0000123-p0000107)*p0000107*507;
+      v0000000:=f0000115(803)-735;
+      v0000105:=148;
+      if v0000122<f0000115(994)-p0000104*v0000126 then f0000106:=v0000000*f0000115(904)-v0000108 else v0000000:=v0000105*v0000108*v0000105;
+      v0000123:=v0000000-f0000115(p0000107)*v0000108
+    end;
+    integer function f0000127(p0000128);
+    begin
+      integer p0000128;
+      integer v0000129;
+      integer function f0000130(p0000131);
+      begin
+        integer p0000131;
+        integer v0000132;
+        integer v0000133;
+        integer v0000134;
+        integer v0000135;
+        integer v0000136;
+        integer v0000137;
+        v0000136:=p0000128;
+        v0000129:=452-v0000135*f0000106(v0000105*26*v0000137);
+        v0000105:=f0000127(v0000133)-294;
+        p0000131:=352*v0000137;
+        write(v0000134);
+        read(v0000135);
+        f0000130:=f0000106(911)*705;
+        v0000129:=f0000103(704*738)*f0000106(47*435*v0000000)-v0000129;
+        v0000132:=303
+      end;
+      integer function f0000138(p0000139);
+      begin
+        integer p0000139;
+        integer v0000140;
+        integer v0000141;
+        integer v0000142;
+        v0000105:=644*f0000130(771*777*0);
+        if v0000000-v0000140-423>=p0000139 then v0000142:=428;
+        read(v0000140);
+        read(v0000129);
+        f0000138:=794-p0000139*v0000140
+      end;
+      integer function f0000143(p0000144);
+      begin
+        integer p0000144;
+        integer v0000145;
+        integer v0000146;
+        integer v0000147;
+        integer v0000148;
+        integer v0000149;
+        read(v0000149);
+        v0000145:=v0000146*v0000145*905;
+        if 330*f0000103(v0000148*417*v0000145)=f0000138(114)-v0000149 then v0000146:=v0000149*v0000147;
+        read(v0000105);
+        p0000104:=v0000148*353;
+        write(v0000149);
+        v0000147:=f0000130(269*427);
+        write(v0000000)
+      end;
+      integer v0000150;
+      integer v0000151;
+      integer v0000152;
+      integer v0000153;
+      integer v0000154;
+      integer v0000155;
+      write(v0000129);
+      v0000000:=297*967;
+      f0000127:=p0000104-326;
+      read(v0000150);
+      f0000127:=f0000001(381-974);
+      v0000000:=f0000106(v0000150)-v0000129*622;
+      f0000127:=v0000150*p0000128;
+      v0000153:=v0000151-f0000001(605);
+      v0000154:=811*v0000150;
+      write(v0000152);
+      read(v0000154);
+      v0000154:=619;
+      if 935*v0000152>=f0000106(v0000153) then v0000154:=v0000000-p0000104 else v0000154:=v0000151
+    end;
+    integer function f0000156(p0000157);
+    begin
+      integer p0000157;
+      integer v0000158;
+      integer function f0000159(p0000160);
+      begin
+        integer p0000160;
+        integer v0000161;
+        integer v0000162;
+        integer v0000163;
+        integer v0000164;
+        read(p0000104);
+        write(p0000157);
+        write(v0000161);
+        p0000160:=569*f0000001(576)-f0000001(v0000163);
+        write(v0000158);
+        write(p0000160);
+        v0000000:=296-f0000127(v0000161*v0000162-613)
+      end;
+      integer function f0000165(p0000166);
+      begin
+        integer p0000166;
+        integer v0000167;
+        integer v0000168;
+        integer v0000169;
+        read(v0000167);
+        if f0000001(169-35)-989<=759 then f0000165:=v0000169*408-f0000103(v0000000*33);
+        write(p0000104);
+        if v0000167<>357-724-p0000166 then v0000169:=v0000168-v0000168*f0000001(475) else v0000000:=v0000169-f0000001(624)
+      end;
+      integer v0000170;
+      integer function f0000171(p0000172);
+      begin
+        integer p0000172;
+        integer v0000173;
+        integer v0000174;
+        integer v0000175;
+        integer v0000176;
+        v0000173:=v0000000-f0000001(854);
+        read(v0000105);
+        if 789*p0000104<>v0000000*v0000176 then v0000174:=v0000175-f0000103(v0000173*347) else p0000172:=v0000173;
+        read(p0000172);
+        v0000175:=p0000172-v0000174-f0000165(v0000176-v0000174)
+      end;
+      integer v0000177;
+      integer v0000178;
+      integer v0000179;
+      integer v0000180;
+      v0000180:=601*f0000001(805-p0000157*v0000179)-f0000127(251-v0000170*v0000170);
+      if 699*p0000104=f0000165(v0000000*p0000157) then v0000158:=v0000179;
+      if v0000000-v0000178*836>=f0000156(543-421) then f0000156:=181 else v0000178:=880;
+      write(v0000179);
+      if v0000158*417*84<=f0000171(v0000179-812) then v0000000:=v0000177*929*v0000178 else v0000000:=f0000159(450-599*323)
+    end;
+    integer v0000181;
+    integer function f0000182(p0000183);
+    begin
+      integer p0000183;
+      integer v0000184;
+      integer function f0000185(p0000186);
+      begin
+        integer p0000186;
+        integer v0000187;
+        integer v0000188;
+        integer v0000189;
+        integer v0000190;
+        integer v0000191;
+        v0000187:=v0000190*v0000181;
+        v0000188:=f0000001(833*823)*v0000189;
+        write(v0000000);
+        v0000188:=v0000000-f0000001(364);
+        read(v0000189);
+        p0000186:=973;
+        v0000190:=v0000000*f0000185(522*145);
+        v0000000:=v0000187-f0000185(473*v0000187)
+      end;
+      integer v0000192;
+      integer function f0000193(p0000194);
+      begin
+        integer p0000194;
+        integer v0000195;
+        integer v0000196;
+        integer v0000197;
+        v0000196:=f0000182(v0000197*950-389)-v0000195*v0000195;
+        f0000193:=p0000194;
+        p0000194:=675*f0000106(501)-p0000194;
+        read(v0000000);
+        write(p0000194);
+        if p0000194<=v0000000 then f0000193:=v0000192*106
+      end;
+      integer v0000198;
+      integer v0000199;
+      integer v0000200;
+      v0000198:=p0000104;
+      read(v0000000);
+      read(v0000198);
+      p0000183:=f0000185(533-v0000184*v0000000);
+      write(v0000000);
+      v0000000:=588*v0000192*v0000198;
+      write(p0000104);
+      write(v0000200);
+      if f0000103(193*144-498)-f0000185(v0000181-v0000000-511)<=v0000192 then v0000199:=v0000192-f0000001(v0000199*573*457) else v0000000:=v0000198*465*590
+    end;
+    integer v0000201;
+    integer v0000202;
+    integer v0000203;
+    integer v0000204;
+    integer v0000205;
+    integer v0000206;
+    integer v0000207;
+    integer v0000208;
+    integer v0000209;
+    integer v0000210;
+    integer v0000211;
+    integer v0000212;
+    integer v0000213;
+    integer v0000214;
+    integer v0000215;
+    integer v0000216;
+    integer v0000217;
+    integer v0000218;
+    integer v0000219;
+    integer v0000220;
+    integer v0000221;
+    integer v0000222;
+    integer v0000223;
+    integer v0000224;
+    integer v0000225;
+    integer v0000226;
+    integer v0000227;
+    integer v0000228;
+    integer v0000229;
+    integer v0000230;
+    integer v0000231;
+    if f0000103(774)=453-v0000220*f0000156(436*99*630) then v0000000:=713 else v0000226:=f0000106(v0000215*v0000214)*295;
+    write(v0000204);
+    v0000212:=v0000219-v0000000*f0000001(v0000215-514*258);
+    write(v0000212);
+    v0000219:=v0000206*313-350;
+    v0000208:=109;
+    v0000211:=v0000206;
+    v0000212:=v0000215;
+    if 169*850-f0000182(167)<f0000156(710-v0000230*v0000206) then v0000204:=300-869*v0000000 else f0000103:=f0000156(v0000207)*226*v0000181;
+    v0000211:=525*275;
+    if v0000223=v0000105-v0000222-v0000215 then v0000207:=430*f0000103(536-743);
+    read(v0000207);
+    v0000229:=v0000000;
+    write(v0000230);
+    write(v0000201);
+    write(v0000230;
+    v0000208:=f0000182(225-v0000205)-v0000203*v0000210;
+    v0000221:=108-v0000212-987;
+    v0000000:=602;
+    read(v0000210);
+    write(v0000224);
+    write(v0000105);
+    if v0000000*v0000000-728=v0000217 then f0000103:=399-f0000182(v0000000-v0000224-v0000202)-f0000156(220);
+    f0000103:=v0000000;
+    read(v0000225);
+    write(v0000221);
+    f0000103:=v0000000;
+    read(v0000215);
+    write(v0000219);
+    v0000181:=v0000105*757*v0000221;
+    v0000000:=v0000216*v0000000-v0000000;
+    v0000230:=689;
+    write(v0000222);
+    v0000212:=v0000223;
+    if v0000225*v0000221*v0000219<>v0000201-214 then v0000000:=789*v0000000*739 else v0000213:=f0000106(558-v0000212)*762-v0000000;
+    write(v0000226);
+    read(v0000208);
+    v0000000:=v0000228*f0000103(840-v0000209)*882;
+    v0000208:=51*v0000206;
+    write(v0000207);
+    if 686*f0000106(v0000225-v0000206)=v0000105*525 then v0000213:=v0000000;
+    v0000203:=v0000000*780;
+    read(v0000000);
+    v0000000:=505;
+    read(v0000206);
+    f0000103:=f0000106(705)-v0000221-v0000222
+  end;
+  integer function f0000232(p0000233);
+  begin
+    integer p0000233;
+    integer v0000234;
+    integer function f0000235(p0000236);
+    begin
+      integer p0000236;
+      integer v0000237;
+      integer v0000238;
+      integer function f0000239(p0000240);
+      begin
+        integer p0000240;
+        integer v0000241;
+        integer v0000242;
+        integer v0000243;
+        v0000241:=v0000000*p0000240-v0000242;
+        write(v0000241);
+        f0000239:=584-p0000240*195;
+        p0000240:=v0000242-v0000000*688;
+        write(v0000241);
+        v0000000:=643
+      end;
+      integer v0000244;
+      #write(v0000238);
+      write(v0000238);
+      read(v0000244);
+      if v0000238-257*p0000236=f0000001(914*v0000000)-846 then v0000238:=v0000238
+    end;
+    integer function f0000245(p0000246);
+    begin
+      integer p0000246;
+      integer v0000247;
+      integer function f0000248(p0000249);
+      begin
+        integer p0000249;
+        integer v0000250;
+        integer v0000251;
+        integer v0000252;
+        read(v0000000);
+        p0000249:=f0000245(p0000246-592*v0000251)-227;
+        v0000252:=v0000252-782*v0000000;
+        write(p0000249);
+        if 711*v0000251<=107-p0000249-879 then v0000234:=816 else v0000000:=161-322*47
+      end;
+      integer function f0000253(p0000254);
+      begin
+        integer p0000254;
+        integer v0000255;
+        integer v0000256;
+        integer v0000257;
+        integer v0000258;
+        integer v0000259;
+        v0000255:=750-v0000258*v0000255;
+        if 914*p0000233*p0000254=f0000103(v0000247)*v0000257 then v0000258:=v0000257*904;
+        v0000247:=v0000234-426*f0000248(v0000259);
+        v0000000:=491-p0000233*v0000258;
+        v0000255:=v0000234;
+        write(v0000000)
+      end;
+      integer v0000260;
+      integer v0000261;
+      integer v0000262;
+      integer v0000263;
+      if f0000103(v0000262*572)*f0000253(v0000261)*v0000261<=v0000261 then f0000245:=f0000235(207-v0000261-v0000260) else v0000000:=v0000263;
+      v0000261:=v0000262;
+      f0000245:=572-p0000246;
+      if 105*v0000260-615<589 then p0000246:=6;
+      v0000260:=v0000263*173-v0000262
+    end;
+    integer function f0000264(p0000265);
+    begin
+      integer p0000265;
+      integer v0000266;
+      integer function f0000267(p0000268);
+      begin
+        integer p0000268;
+        integer v0000269;
+        integer v0000270;
+        integer v0000271;
+        v0000234:=f0000267(v0000271*v0000234)-v0000269-p0000268;
+        read(p0000268);
+        f0000267:=f0000264(681*v0000269*363);
+        v0000271:=v0000266-46-v0000270;
+        v0000266:=v0000234-528-p0000268
+      end;
+      integer function f0000272(p0000273);
+      begin
+        integer p0000273;
+        integer v0000274;
+        integer v0000275;
+        integer v0000276;
+        integer v0000277;
+        write(v0000276);
+        read(v0000276);
+        f0000272:=508-565-532;
+        write(v0000275);
+        v0000277:=714*v0000000-987;
+        v0000274:=f0000103(929-698)*p0000273*353;
+        write(v0000275);
+        p0000233:=348-v0000275
+      end;
+      integer v0000278;
+      integer v0000279;
+      integer v0000280;
+      if 711=v0000266-p0000265*565 then f0000264:=f0000267(962-657) else v0000279:=p0000265*v0000266;
+      if v0000278>=f0000235(28*498*41)*511-141 then v0000266:=223-554*131 else p0000265:=p0000265;
+      v0000278:=171;
+      v0000000:=32
+    end;
+    integer function f0000281(p0000282);
+    begin
+      integer p0000282;
+      integer v0000283;
+      integer function f0000284(p0000285);
+      begin
+        integer p0000285;
+        integer v0000286;
+        integer v0000287;
+        integer v0000288;
+        v0000287:=128*f0000245(v0000286*372)*v0000288;
+        v0000286:=v0000000;
+        if p0000285*v0000000*f0000245(803-277)>=v0000000-606*v0000287 then p0000285:=v0000283;
+        v0000287:=p0000233*v0000000*v0000000
+      end;
+      integer v0000289;
+      integer v0000290;
+      v0000290:=181;
+      f0000281:=v0000000-p0000282*548;
+      v0000289:=f0000245(p0000282-865)-137*402;
+      read(p0000233)
+    end;
+    integer function f0000291(p0000292);
+    begin
+      integer p0000292;
+      integer v0000293;
+      integer function f0000294(p0000295);
+      begin
+        integer p0000295;
+        integer v0000296;
+        integer v0000297;
+        integer v0000298;
+        p0000233:=f0000291(v0000296*81)*v0000000-v0000000;
+        v0000234:=539-658;
+        v0000296:=f0000103(v0000297-v0000234-846)-v0000298*286;
+        v0000000:=f0000001(p0000233)*f0000291(760)
+      end;
+      integer v0000299;
+      integer function f0000300(p0000301);
+      begin
+        integer p0000301;
+        integer v0000302;
+        integer v0000303;
+        integer v0000304;
+        v0000303:=703-831*v0000234;
+        p0000301:=983-v0000000;
+        v0000302:=v0000303;
+        p0000301:=v0000293;
+        read(v0000302);
+        v0000234:=272-949;
+        v0000234:=v0000000-v0000299*p0000233
+      end;
+      integer v0000305;
+      p0000292:=f0000264(p0000292)-v0000299;
+      p0000292:=v0000305*f0000232(v0000299*592);
+      write(v0000305);
+      f0000291:=v0000000;
+      write(v0000293);
+      v0000305:=v0000293*p0000233*f0000300(859)
+    end;
+    integer v0000306;
+    integer v0000307;
+    integer v0000308;
+    integer v0000309;
+    integer v0000310;
+    integer v0000311;
+    integer v0000312;
+    integer v0000313;
+    integer v0000314;
+    integer v0000315;
+    integer v0000316;
+    integer v0000317;
+    integer v0000318;
+    integer v0000319;
+    integer v0000320;
+    integer v0000321;
+    integer v0000322;
+    integer v0000323;
+    integer v0000324;
+    integer v0000325;
+    integer v0000326;
+    integer v0000327;
+    if f0000001(447)-f0000235(v0000309-v0000000-180)-139<>v0000320*v0000320 then f0000232:=v0000315-v0000000*v0000326 else f0000232:=v0000324-v0000000;
+    f0000232:=920*454;
+    f0000232:=12;
+    read(v0000234);
+    if v0000321*v0000326-322<=v0000308*v0000322-v0000000 then f0000232:=f0000235(v0000322-v0000311);
+    read(v0000310);
+    read(v0000309);
+    v0000307:=v0000310;
+    v0000323:=330-829;
+    if v0000000>=v0000318-v0000322 then v0000314:=v0000321*v0000000;
+    v0000000:=v0000000*f0000232(954*v0000307-p0000233);
+    if v0000312<>840 then v0000310:=790;
+    if 642-v0000326-v0000324>76-602 then f0000232:=v0000309 else v0000321:=v0000314*v0000324*676;
+    if v0000323*f0000001(v0000000*534*552)-v0000000>v0000318-v0000000*v0000323 then v0000326:=v0000324*71;
+    v0000324:=v0000310*f0000235(467-v0000307*v0000000);
+    if f0000235(29)>v0000315*f0000281(919-612) then v0000317:=720-v0000308;
+    v0000326:=v0000326;
+    v0000000:=47*190-636;
+    f0000232:=f0000281(631);
+    if v0000318-v0000324<v0000314 then p0000233:=f0000264(427-332-499)*v0000317*761;
+    v0000324:=p0000233-v0000000-v0000308;
+    if f0000245(928)<>544*v0000317*p0000233 then p0000233:=63 else f0000232:=v0000306*v0000312*255
+  end;
+  integer v0000328;
+  integer function f0000329(p0000330);
+  begin
+    integer p0000330;
+    integer v0000331;
+    integer function f0000332(p0000333);
+    begin
+      integer p0000333;
+      integer v0000334;
+      integer function f0000335(p0000336);
+      begin
+        integer p0000336;
+        integer v0000337;
+        integer v0000338;
+        integer v0000339;
+        if 230<=f0000001(409*v0000331)-585 then f0000335:=p0000336-v0000337;
+        v0000339:=763;
+        p0000333:=f0000329(v0000331-469)*721*v0000337;
+        v0000339:=v0000000-v0000000-583
+      end;
+      integer function f0000340(p0000341);
+      begin
+        integer p0000341;
+        integer v0000342;
+        integer v0000343;
+        integer v0000344;
+        if f0000001(730-p0000333-722)-v0000343*v0000342<=v0000342 then p0000341:=p0000330 else f0000340:=f0000232(v0000344*439)-v0000000-v0000328;
+        if f0000332(814)*f0000103(v0000343-p0000341-296)>=v0000334-835 then v0000328:=168*898*v0000328
+      end;
+      integer v0000345;
+      integer v0000346;
+      integer v0000347;
+      if v0000345*148>v0000328 then v0000347:=v0000000;
+      v0000331:=v0000345;
+      v0000347:=v0000328-p0000333-p0000333;
+      f0000332:=v0000347;
+      write(v0000000);
+      if f0000335(v0000345*v0000331*p0000330)<>464 then f0000332:=v0000346-494
+    end;
+    integer function f0000348(p0000349);
+    begin
+      integer p0000349;
+      integer v0000350;
+      integer function f0000351(p0000352);
+      begin
+        integer p0000352;
+        integer v0000353;
+        integer v0000354;
+        integer v0000355;
+        integer v0000356;
+        integer v0000357;
+        integer v0000358;
+        p0000330:=v0000353*299*880;
+        v0000358:=f0000348(p0000352-911-674)-f0000332(v0000350);
+        read(v0000358);
+        if 841-402>=734-p0000330-v0000356 then v0000356:=v0000328*v0000000*v0000328 else p0000330:=f0000348(v0000355-p0000349);
+        v0000356:=f0000332(v0000353)-f0000332(v0000354*71*v0000328)-v0000358
+      end;
+      integer function f0000359(p0000360);
+      begin
+        integer p0000360;
+        integer v0000361;
+        integer v0000362;
+        integer v0000363;
+        integer v0000364;
+        integer v0000365;
+        integer v0000366;
+        integer v0000367;
+        v0000362:=230*v0000350;
+        v0000364:=f0000332(v0000366)-332*v0000328;
+        v0000365:=v0000328;
+        v0000328:=f0000332(567*v0000365*p0000360)*903-v0000328;
+        if f0000001(559*920*586)-f0000103(107)>f0000103(58-v0000363)*v0000366-f0000103(v0000361*p0000330-p0000349) then v0000364:=764-v0000365*807;
+        read(v0000331);
+        f0000359:=406*v0000367-67;
+        f0000359:=237-f0000332(517)
+      end;
+      integer function f0000368(p0000369);
+      begin
+        integer p0000369;
+        integer v0000370;
+        integer v0000371;
+        integer v0000372;
+        v0000331:=f0000368(593)-v0000370*f0000332(261-627*p0000369);
+        v0000000:=v0000370;
+        write(v0000371);
+        p0000369:=v0000328;
+        read(v0000000);
+        write(v0000371)
+      end;
+      integer function f0000373(p0000374);
+      begin
+        integer p0000374;
+        integer v0000375;
+        integer v0000376;
+        integer v0000377;
+        v0000376:=754-f0000348(v0000000);
+        if 824*v0000375<f0000332(932-311-v0000377)-f0000103(20*268)-651 then f0000373:=p0000330*v0000375;
+        f0000373:=566;
+        write(p0000374)
+      end;
+      integer v0000378;
+      integer v0000379;
+      integer v0000380;
+      integer v0000381;
+      integer v0000382;
+      integer v0000383;
+      integer v0000384;
+      read(v0000328);
+      v0000350:=v0000380*f0000232(v0000000-886-p0000330);
+      v0000000:=f0000348(p0000330)-v0000381*f0000359(672);
+      if v0000328*861*v0000384=v0000328*p0000330*65 then f0000348:=f0000232(529*v0000328-768)-835-885;
+      v0000328:=v0000378-f0000232(866-302);
+      p0000349:=v0000328-v0000378*907;
+      read(v0000331);
+      read(p0000330);
+      v0000380:=v0000382-v0000000;
+      f0000348:=188*v0000000;
+      write(v0000378)
+    end;
+    integer function f0000385(p0000386);
+    begin
+      integer p0000386;
+      integer v0000387;
+      integer function f0000388(p0000389);
+      begin
+        integer p0000389;
+        integer v0000390;
+        integer v0000391;
+        integer v0000392;
+        integer v0000393;
+        integer v0000394;
+        p0000386:=v0000393-v0000392*745;
+        if v0000328<=v0000331 then p0000386:=517-f0000103(288*v0000393);
+        u0000772:=f0000348(484);
+        v0000331:=f0000103(982-650-v0000392);
+        v0000391:=v0000393;
+        v0000331:=v0000394*567;
+        v0000392:=p0000386;
+        v0000390:=f0000232(43*865)*293
+      end;
+      integer function f0000395(p0000396);
+      begin
+        integer p0000396;
+        integer v0000397;
+        integer v0000398;
+        integer v0000399;
+        integer v0000400;
+        integer v0000401;
+        integer v0000402;
+        read(v0000000);
+        if v0000387<>f0000103(v0000399-p0000386)-770-p0000386 then v0000398:=f0000332(p0000330) else v0000398:=p0000330*292*131;
+        read(v0000402);
+        if 79-f0000395(v0000402*258*398)-f0000329(v0000402*857)=p0000330*f0000385(p0000396) then v0000328:=p0000396-f0000388(807-465*p0000396) else v0000401:=p0000386*v0000397;
+        v0000328:=v0000402*p0000396
+      end;
+      integer function f0000403(p0000404);
+      begin
+        integer p0000404;
+        integer v0000405;
+        integer v0000406;
+        integer v0000407;
+        integer v0000408;
+        integer v0000409;
+        f0000403:=v0000387*v0000407-v0000408;
+        write(v0000406);
+        v0000407:=p0000386*v0000406;
+        if 743>v0000331*p0000386 then f0000403:=949*389*p0000404;
+        v0000408:=v0000406;
+        read(v0000405);
+        write(v0000406);
+        v0000328:=f0000001(v0000000*v0000408-v0000405)*v0000000*v0000409
+      end;
+      integer function f0000410(p0000411);
+      begin
+        integer p0000411;
+        integer v0000412;
+        integer v0000413;
+        integer v0000414;
+        integer v0000415;
+        if p0000411-397>=886*726*376 then v0000415:=v0000387*v0000412 else p0000411:=v0000412*947*p0000411;
+        write(p0000386);
+        v0000415:=867*f0000385(636-956-853);
+        v0000000:=f0000388(v0000414-790)*v0000412*p0000386;
+        p0000411:=v0000000*v0000414
+      end;
+      integer v0000416;
+      integer v0000417;
+      integer v0000418;
+      integer v0000419;
+      integer v0000420;
+      integer v0000421;
+      integer v0000422;
+      integer v0000423;
+      v0000419:=204-v0000387;
+      v0000416:=v0000331-v0000000-f0000329(347);
+      read(v0000387);
+      v0000417:=p0000330-v0000418-v0000387;
+      v0000420:=f0000410(316)-f0000385(p0000386*89);
+      if v0000419<f0000388(615-169-558) then p0000386:=f0000395(978*916*v0000423)-169-f0000332(v0000420-535);
+      v0000422:=734-v0000328;
+      read(p0000330);
+      v0000422:=v0000387*v0000420-f0000410(503-905);
+      v0000328:=885*519*v0000416;
+      f0000385:=265-v0000421;
+      p0000330:=v0000387*v0000419
+    end;
+    integer v0000424;
+    integer function f0000425(p0000426);
+    begin
+      integer p0000426;
+      integer v0000427;
+      integer function f0000428(p0000429);
+      begin
+        integer p0000429;
+        integer v0000430;
+        integer v0000431;
+        integer v0000432;
+        integer v0000433;
+        v0000430:=p0000429-723-v0000328;
+        v0000328:=p0000429*p0000429;
+        read(v0000433);
+        p0000429:=f0000103(v0000433-v0000432*v0000424);
+        if 635<=p0000426*530 then p0000429:=v0000433 else v0000331:=843-v0000427-59;
+        read(v0000427)
+      end;
+      integer function f0000434(p0000435);
+      begin
+        integer p0000435;
+        integer v0000436;
+        integer v0000437;
+        integer v0000438;
+        write(v0000000);
+        write(v0000000);
+        v0000000:=v0000437;
+        v0000437:=v0000436;
+        v0000427:=f0000428(v0000436*309)*685*v0000436;
+        if v0000331=p0000426-628 then v0000437:=163-v0000436 else v0000427:=f0000348(390-v0000328)*v0000438
+      end;
+      integer v0000439;
+      integer v0000440;
+      integer v0000441;
+      integer v0000442;
+      if p0000426=f0000329(v0000440)-f0000232(v0000000-v0000439*930) then v0000441:=827;
+      f0000425:=v0000440-v0000439;
+      f0000425:=v0000439*v0000000*v0000441;
+      p0000426:=96*28*367;
+      v0000427:=v0000328-v0000442;
+      if f0000428(39*221)-134>=608*v0000442 then v0000440:=v0000328 else v0000427:=f0000434(v0000442-651-v0000427)
+    end;
+    integer v0000443;
+    integer v0000444;
+    integer v0000445;
+    integer v0000446;
+    integer v0000447;
+    integer v0000448;
+    integer v0000449;
+    integer v0000450;
+    integer v0000451;
+    integer v0000452;
+    integer v0000453;
+    integer v0000454;
+    integer v0000455;
+    integer v0000456;
+    integer v0000457;
+    integer v0000458;
+    integer v0000459;
+    integer v0000460;
+    integer v0000461;
+    integer v0000462;
+    integer v0000463;
+    integer v0000464;
+    integer v0000465;
+    integer v0000466;
+    integer v0000467;
+    integer v0000468;
+    integer v0000469;
+    integer v0000470;
+    integer v0000471;
+    integer v0000472;
+    integer v0000473;
+    integer v0000474;
+    integer v0000475;
+    integer v0000476;
+    integer v0000477;
+    integer v0000478;
+    integer v0000479;
+    write(p0000330);
+    write(v0000328);
+    if v0000450*f0000103(v0000460*832)>v0000473*f0000332(886*623*v0000328) then v0000472:=v0000474;
+    read(v0000457);
+    write(p0000330);
+    if 13>v0000469*v0000000 then v0000471:=f0000348(v0000328-v0000443)*v0000470;
+    f0000329:=v0000456;
+    write(v0000447);
+    v0000472:=v0000328-v0000000-609;
+    if 942-v0000000<v0000000 then v0000456:=v0000424-v0000453;
+    v0000328:=326*v0000445;
+    v0000461:=v0000465*v0000000-v0000461;
+    f0000329:=v0000474;
+    v0000468:=f0000348(883*873-246)-377-v0000328;
+    read(v0000477);
+    if 880*v0000443*v0000328>v0000471-f0000385(919) then v0000000:=v0000472-620;
+    v0000455:=64-v0000474;
+    write(v0000460);
+    if f0000001(439)*v0000467<=474-v0000328 v0000328:=v0000466*f0000103(v0000460*361-v0000457);
+    write(v0000460);
+    write(v0000000);
+    if 428-488*f0000425(632*408-v0000444)<>v0000000-940-315 then v0000448:=f0000232(932) else v0000452:=635*v0000328-v0000475;
+    v0000458:=v0000453-819;
+    v0000462:=v0000475-v0000331;
+    f0000329:=621-991-v0000458;
+    v0000454:=621;
+    v0000456:=455-f0000103(v0000475-390);
+    v0000465:=f0000425(v0000454)*v0000328*v0000455;
+    read(v0000464);
+    v0000458:=v0000449*v0000470-v0000000;
+    if f0000425(675*v0000328-363)<>v0000467*207 then f0000329:=158-v0000454-325 else v0000462:=v0000328-604*v0000451;
+    if f0000329(v0000461-v0000446)-v0000000<>v0000466*642-v0000445 then f0000329:=323-587-950 else v0000424:=v0000328-v0000448*v0000328;
+    write(v0000445);
+    v0000448:=v0000459-v0000473;
+    if v0000331-874=f0000001(v0000467)-v0000446 then v0000468:=f0000348(v0000474-81)*f0000332(474-v0000470)-f0000332(v0000450*728);
+    v0000477:=v0000474-v0000445-v0000448;
+    v0000465:=258;
+    v0000453:=v0000331-v0000328;
+    v0000328:=v0000328-639*f0000329(v0000465-824);
+    v0000473:=v0000460-714*f0000332(v0000478*635-142);
+    write(v0000466);
+    if v0000459<=v0000453 then v0000328:=f0000001(v0000474)*f0000329(v0000444)
+  end;
+  integer v0000480;
+  integer v0000481;
+  integer function f0000482(p0000483);
+  begin
+    integer p0000483;
+    integer v0000484;
+    integer function f0000485(p0000486);
+    begin
+      integer p0000486;
+      integer v0000487;
+      f0000485:=p0000486;
+      read(v0000481);
+      v0000487:=p0000486
+    end;
+    integer function f0000488(p0000489);
+    begin
+      integer p0000489;
+      integer v0000490;
+      v0000490:=p0000489;
+      v0000480:=p0000489-p0000489-p0000489
+    end;
+    integer function f0000491(p0000492);
+    begin
+      integer p0000492;
+      integer v0000493;
+      if 611*291>=490*879 then v0000493:=p0000492 else p0000492:=611
+    end;
+    integer function f0000494(p0000495);
+    begin
+      integer p0000495;
+      integer v0000496;
+      if v0000496*v0000480-v0000484<>v0000328-0 then v0000000:=p0000495
+    end;
+    integer v0000497;
+    integer v0000498;
+    integer v0000499;
+    integer v0000500;
+    if 702-184-f0000491(v0000000-v0000497*60)<v0000484-v0000500 then f0000482:=v0000497-v0000499 else v0000484:=347-v0000498;
+    read(v0000484);
+    v0000499:=v0000480;
+    write(v0000000);
+    read(v0000328);
+    v0000497:=684
+  end;
+  integer v0000501;
+  integer v0000502;
+  integer v0000503;
+  integer v0000504;
+  integer v0000505;
+  integer v0000506;
+  integer v0000507;
+  integer v0000508;
+  integer v0000509;
+  integer v0000510;
+  integer v0000511;
+  integer v0000512;
+  integer v0000513;
+  integer v0000514;
+  integer v0000515;
+  integer v0000516;
+  integer v0000517;
+  integer v0000518;
+  integer v0000519;
+  integer v0000520;
+  integer v0000521;
+  integer v0000522;
+  integer v0000523;
+  integer v0000524;
+  integer v0000525;
+  integer v0000526;
+  integer v0000527;
+  integer v0000528;
+  integer v0000529;
+  integer v0000530;
+  integer v0000531;
+  integer v0000532;
+  integer v0000533;
+  integer v0000534;
+  integer v0000535;
+  integer v0000536;
+  integer v0000537;
+  integer v0000538;
+  integer v0000539;
+  integer v0000540;
+  integer v0000541;
+  integer v0000542;
+  integer v0000543;
+  integer v0000544;
+  integer v0000545;
+  integer v0000546;
+  integer v0000547;
+  integer v0000548;
+  integer v0000549;
+  integer v0000550;
+  integer v0000551;
+  integer v0000552;
+  integer v0000553;
+  integer v0000554;
+  integer v0000555;
+  integer v0000556;
+  integer v0000557;
+  integer v0000558;
+  integer v0000559;
+  integer v0000560;
+  integer v0000561;
+  integer v0000562;
+  integer v0000563;
+  integer v0000564;
+  integer v0000565;
+  integer v0000566;
+  integer v0000567;
+  integer v0000568;
+  integer v0000569;
+  integer v0000570;
+  integer v0000571;
+  integer v0000572;
+  integer v0000573;
+  integer v0000574;
+  integer v0000575;
+  integer v0000576;
+  integer v0000577;
+  integer v0000578;
+  integer v0000579;
+  integer v0000580;
+  integer v0000581;
+  integer v0000582;
+  integer v0000583;
+  integer v0000584;
+  integer v0000585;
+  integer v0000586;
+  integer v0000587;
+  integer v0000588;
+  integer v0000589;
+  integer v0000590;
+  integer v0000591;
+  integer v0000592;
+  integer v0000593;
+  integer v0000594;
+  integer v0000595;
+  integer v0000596;
+  integer v0000597;
+  integer v0000598;
+  integer v0000599;
+  integer v0000600;
+  integer v0000601;
+  integer v0000602;
+  integer v0000603;
+  integer v0000604;
+  integer v0000605;
+  integer v0000606;
+  integer v0000607;
+  integer v0000608;
+  integer v0000609;
+  integer v0000610;
+  integer v0000611;
+  integer v0000612;
+  integer v0000613;
+  integer v0000614;
+  integer v0000615;
+  integer v0000616;
+  integer v0000617;
+  integer v0000618;
+  integer v0000619;
+  integer v0000620;
+  integer v0000621;
+  integer v0000622;
+  integer v0000623;
+  integer v0000624;
+  integer v0000625;
+  integer v0000626;
+  integer v0000627;
+  integer v0000628;
+  integer v0000629;
+  integer v0000630;
+  integer v0000631;
+  integer v0000632;
+  integer v0000633;
+  integer v0000634;
+  integer v0000635;
+  integer v0000636;
+  integer v0000637;
+  integer v0000638;
+  integer v0000639;
+  integer v0000640;
+  integer v0000641;
+  integer v0000642;
+  integer v0000643;
+  integer v0000644;
+  integer v0000645;
+  integer v0000646;
+  integer v0000647;
+  integer v0000648;
+  integer v0000649;
+  integer v0000650;
+  integer v0000651;
+  integer v0000652;
+  integer v0000653;
+  integer v0000654;
+  integer v0000655;
+  integer v0000656;
+  integer v0000657;
+  integer v0000658;
+  integer v0000659;
+  integer v0000660;
+  integer v0000661;
+  integer v0000662;
+  integer v0000663;
+  integer v0000664;
+  integer v0000665;
+  integer v0000666;
+  integer v0000667;
+  integer v0000668;
+  integer v0000669;
+  integer v0000670;
+  integer v0000671;
+  integer v0000672;
+  integer v0000673;
+  integer v0000674;
+  integer v0000675;
+  integer v0000676;
+  integer v0000677;
+  integer v0000678;
+  integer v0000679;
+  integer v0000680;
+  integer v0000681;
+  v0000554:=v0000540*v0000533;
+  if v0000550*v0000547<=832-855-f0000103(v0000552-v0000541) then v0000573:=103;
+  read(v0000598);
+  write(v0000535);
+  v0000642:=f0000103(v0000520-653*316)-278*v0000650;
+  v0000626:=v0000650;
+  v0000672:=754-f0000001(v0000548-v0000610);
+  if v0000615=v0000530 then v0000642:=966 else v0000556:=v0000644*v0000523-352;
+  v0000628:=v0000591-v0000530;
+  v0000527:=f0000232(v0000550*v0000634*v0000534)*v0000629;
+  v0000620:=v0000505;
+  v0000517:=4;
+  v0000552:=v0000633;
+  v0000680:=v0000607*913;
+  v0000629:=v0000656-v0000534-v0000622;
+  read(v0000623);
+  v0000620:=v0000587*v0000569*v0000676;
+  v0000328:=v0000539;
+  v0000644:=56*v0000530;
+  if f0000001(v0000612*v0000657-v0000527)*f0000232(v0000628*327*983)*v0000507<=f0000482(967*v0000668-37) then v0000531:=v0000545 else v0000615:=f0000001(570*v0000637);
+  v0000600:=f0000103(662-v0000599)-366;
+  v0000568:=v0000583-v0000549-f0000001(959);
+  write(v0000649);
+  write(v0000538);
+  if 702=7-f0000329(957)-f0000482(v0000610-v0000556) then v0000554:=f0000103(691) else v0000662:=f0000329(935);
+  if v0000623*v0000575<>674-623*748 then v0000582:=750 else v0000550:=v0000616-v0000593-f0000482(993-v0000593-977);
+  read(v0000606);
+  v0000516:=v0000606-f0000482(61-v0000660)-v0000629;
+  write(v0000662);
+  v0000546:=790-f0000329(v0000606*v0000573);
+  v0000564:=717-f0000232(744-206);
+  write(v0000480);
+  if v0000676*f0000329(140)-387<712 then v0000621:=v0000560*f0000232(v0000583-749)*487;
+  v0000567:=f0000232(v0000656*v0000515-270);
+  v0000544:=v0000574*v0000680;
+  read(v0000641);
+  write(v0000573);
+  v0000659:=740;
+  write(v0000584);
+  v0000519:=400*v0000609;
+  write(v0000558);
+  write(v0000598);
+  if v0000679*v0000506*v0000570>v0000665*v0000597 then v0000585:=v0000572-f0000482(383) else v0000536:=v0000671*v0000526*932;
+  if 907-196-v0000645>=554 then v0000586:=62-633;
+  v0000586:=852-f0000232(576*v0000605)*v0000504;
+  read(v0000613);
+  v0000547:=v0000597*f0000001(v0000519-v0000517);
+  v0000596:=f0000103(v0000662-v0000536)-v0000607*674;
+  v0000513:=f0000001(v0000545);
+  v0000503:=196*481*v0000584;
+  v0000645:=v0000504;
+  write(v0000554);
+  v0000507:=v0000638*v0000669-v0000593;
+  v0000588:=v0000554*f0000103(632-v0000556)-v0000549;
+  v0000608:=294;
+  v0000503:=v0000636-0;
+  if v0000620*f0000103(921*735)>=v0000621-v0000619*238 then v0000574:=v0000520;
+  v0000658:=f0000232(554*v0000640)*856-v0000597;
+  write(v0000575);
+  read(v0000591);
+  v0000624:=v0000661;
+  read(v0000574);
+  write(v0000559);
+  v0000558:=v0000589*294-995;
+  v0000644:=f0000001(805*v0000582-525)*v0000565*v0000672;
+  v0000678:=v0000613-v0000642;
+  read(v0000528);
+  write(v0000515);
+  if v0000573-446>363-v0000567 then v0000602:=v0000573-f0000482(v0000551*v0000584)*v0000505 else v0000502:=264;
+  write(v0000599);
+  write(v0000509);
+  write(v0000574);
+  v0000662:=f0000001(710-v0000515*v0000655);
+  v0000537:=967;
+  v0000528:=identifiertoolong;
+  v0000533:=f0000001(v0000640-v0000547*709);
+  v0000578:=v0000543;
+  if f0000103(83-553-v0000659)*f0000482(v0000672*26)*f0000482(v0000533)<>f0000001(377*v0000680)-v0000531 then v0000533:=787 else v0000599:=709;
+  v0000480:=v0000560;
+  v0000539:=v0000525-808-f0000001(v0000634);
+  v0000657:=v0000604;
+  if v0000506-v0000527-f0000001(892*v0000481-v0000634)=v0000589-v0000628*183 then v0000564:=v0000644;
+  write(v0000657);
+  read(v0000559);
+  v0000651:=v0000547;
+  write(v0000505);
+  v0000512:=v0000664-v0000678;
+  write(v0000578);
+  read(v0000509);
+  if 607>=f0000232(860-v0000576-216) then v0000618:=750*v0000556;
+  v0000619:=f0000103(v0000514)*v0000514-v0000521;
+  if v0000603-228<v0000638*606 then v0000578:=v0000512 else v0000610:=620*844*v0000676;
+  write(v0000630);
+  v0000517:=v0000659;
+  read(v0000626);
+  if v0000560-v0000535<985*909-148 then v0000565:=830*v0000585 else v0000600:=v0000545;
+  if 822-v0000658*376>=f0000103(v0000636-549*713)-v0000578 then v0000546:=856-f0000232(v0000558*v0000652)-v0000666 else v0000523:=f0000001(2-v0000506)-535;
+  v0000645:=f0000103(366-672*625)-v0000651;
+  v0000629:=247*917-234;
+  v0000566:=f0000001(746*728-302)*325-f0000232(792-434);
+  write(v0000554);
+  if 159-217>=712-v0000569-v0000620 then v0000562:=v0000532;
+  v0000502:=v0000655;
+  if 539<=v0000539-296 then v0000536:=322;
+  v0000624:=v0000520*810-v0000676;
+  v0000642:=v0000661;
+  if v0000648=f0000232(v0000540)*v0000606 then v0000619:=f0000329(v0000596-v0000503-804) else v0000615:=v0000627*239;
+  write(v0000620);
+  if v0000578=440-v0000576 then v0000537:=v0000597;
+  write(v0000609);
+  if v0000638>=f0000482(v0000665-v0000536*796)*v0000634 then v0000589:=v0000628;
+  v0000514:=f0000232(552*v0000623)*648-v0000565;
+  if v0000545-f0000001(v0000635-105)<v0000554*f0000482(821)*492 then v0000545:=f0000103(851*v0000606)*f0000482(v0000573*276*v0000537);
+  if f0000329(284*v0000550*v0000508)*v0000593<f0000001(495-292) v0000508:=f0000232(579*v0000669*v0000611)*v0000595;
+  #read(v0000537);
+  if v0000572<188-v0000561 then v0000630:=v0000661;
+  read(v0000564);
+  v0000526:=v0000590-v0000522;
+  if v0000571*765*v0000586<=f0000329(v0000624-v0000555*675)*f0000001(992-787) then v0000585:=v0000545;
+  v0000587:=295-918*v0000613;
+  write(v0000563);
+  write(v0000581);
+  if 715-825*259=66-v0000664 then v0000556:=118 else v0000581:=130;
+  v0000559:=918-f0000482(446*530*154);
+  read(v0000626);
+  v0000508:=116-v0000648;
+  if v0000617-v0000662*157>v0000602-944 then v0000614:=v0000580-v0000656 else v0000538:=v0000589*v0000568*v0000507;
+  read(v0000608);
+  v0000638:=v0000591*v0000645*v0000633;
+  write(v0000533);
+  v0000589:=899*v0000670;
+  v0000621:=v0000624-v0000538;
+  write(v0000552);
+  if v0000610<=633*v0000516*970 then v0000534:=v0000513*47*619;
+  read(v0000596);
+  v0000519:=v0000328;
+  v0000580:=f0000329(v0000601-569)*v0000602-v0000664;
+  write(v0000548);
+  v0000668:=f0000103(v0000555*279);
+  if 88-978>540*v0000507 then v0000528:=f0000329(119-304)-v0000643 else v0000559:=v0000606-v0000549*657;
+  v0000567:=v0000635-v0000663;
+  v0000591:=f0000103(593*v0000576);
+  v0000616:=934-v0000630-669;
+  if 589-f0000482(v0000680*669)<v0000533 then v0000614:=v0000532*v0000659*374 else v0000516:=f0000001(480*v0000633*838);
+  read(v0000663);
+  v0000564:=v0000590;
+  write(v0000526);
+  v0000679:=v0000543;
+  if v0000657-v0000615>=308*v0000596 then v0000561:=572-437;
+  #write(v0000616);
+  read(v0000541);
+  v0000595:=f0000103(209*518*v0000603)*v0000672;
+  v0000642:=v0000651-882-v0000633;
+  read(v0000562);
+  v0000668:=v0000602-970;
+  if v0000637-617=819-v0000669 then v0000564:=593-f0000329(v0000598*647-655)-v0000537;
+  if f0000001(v0000598)<>v0000610 then v0000610:=f0000001(158);
+  v0000672:=f0000329(v0000564-v0000585-v0000583)-286;
+  v0000616:=v0000000-37*788;
+  write(v0000577);
+  v0000677:=v0000505;
+  v0000626:=f0000232(v0000646*v0000518)-v0000523*v0000615;
+  v0000527:=f0000001(589-v0000557);
+  read(v0000644);
+  v0000582:=v0000635-v0000612*808;
+  write(v0000554);
+  v0000629:=v0000539;
+  write(v0000509);
+  if f0000103(v0000642)-v0000481<>v0000527-134*f0000103(471) then v0000586:=v0000570*f0000329(391);
+  v0000612:=f0000482(217-v0000601-655)*f0000103(v0000514*426*v0000535)*806;
+  v0000522:=v0000649-345*v0000519;
+  if v0000615-v0000635<>f0000329(271)*v0000542 then v0000502:=v0000655;
+  if 981*f0000329(813*811-v0000657)*f0000482(v0000564-v0000569*v0000609)=v0000506 then v0000645:=v0000644 else v0000522:=f0000232(v0000566*v0000539*v0000591)-v0000529;
+  read(v0000520);
+  if 702*344*v0000611=v0000542 then v0000660:=v0000640-v0000646 else v0000531:=470-f0000103(v0000522);
+  write(v0000586);
+  v0000547:=v0000562;
+  v0000558:=v0000636-v0000613*f0000232(v0000582);
+  if 713-v0000680<=227*v0000643 then v0000513:=v0000628-223-v0000531 else v0000675:=v0000637-959;
+  if v0000579<>v0000578-v0000668 then v0000674:=v0000605;
+  write(v0000654);
+  v0000528:=v0000559-v0000583;
+  write(v0000669);
+  if v0000576*f0000329(33*977)*v0000525<v0000531-717-f0000001(v0000577) then v0000512:=f0000329(63*657)-f0000103(889*v0000509-v0000525);
+  write(v0000535);
+  v0000562:=f0000103(885)-v0000510;
+  if 456-v0000605<f0000001(252-8*v0000648) then v0000559:=v0000540-447*f0000103(v0000662-51);
+  read(v0000622);
+  read(v0000505);
+  read(v0000669);
+  if 649-711-v0000561=982 then v0000631:=v0000667 else v0000564:=951;
+  write(v0000541);
+  v0000630:=v0000558-v0000511;
+  write(v0000547);
+  read(v0000545);
+  if v0000612*v0000537-v0000602>f0000103(658*v0000538)*513-378 then v0000658:=f0000232(v0000545*487)*v0000599-v0000595;
+  read(v0000605);
+  v0000508:=v0000553;
+  if v0000557=f0000103(894)-f0000232(359-48) then v0000658:=v0000633*244*f0000329(v0000647*252) else v0000635:=f0000232(305)*711*v0000531;
+  v0000553:=v0000664*v0000655
+end
@@ -0,0 +1,46 @@
+#!/bin/bash
+# .dyd格式化的检查：
+# 1. tests/dyd/expected中是改用formatRecord之前（stringstream加setw(16)）的编译器对同名源程序写出的.dyd，
+#    现在的输出必须逐字节相同，分别经词法分析、-pipe流水线和由.dydb转换三条路径写出；
+# 2. 把tests/dyd/generated.pas重复160遍得到约8MB的源程序，其.dyd逐行按"%16s %s"重新排版，结果必须与原文件相同；
+# 3. 在同一次运行中对这一程序用旧的格式化和现在的词法分析写出.dyd（驱动程序见dyd_throughput.cpp），
+#    两者的吞吐率之比不得低于tests/dyd/throughput.baseline中记录值的DYD_TOLERANCE倍（默认0.5），
+#    DYD_BASELINE可直接给出记录值
+set -eu
+source "$(dirname "$0")/common.sh"
+cd "$WORK"
+
+for source in "$ROOT"/tests/dyd/*.pas "$ROOT"/benchmarks/*.pas; do
+    name=$(basename "$source" .pas)
+    expected="$ROOT/tests/dyd/expected/$name.dyd"
+    cp "$source" "$name.pas"
+    "$COMPILER" -dyd -dydb "$name.pas" > /dev/null 2>&1 || true
+    cmp -s "$name.dyd" "$expected" || fail "$name.dyd differs from the old formatter"
+    rm -f "$name.dyd"
+    "$COMPILER" -pipe -dyd "$name.pas" > /dev/null 2>&1 || true
+    cmp -s "$name.dyd" "$expected" || fail "$name.dyd written by -pipe differs from the old formatter"
+    rm -f "$name.dyd"
+    "$COMPILER" -dyd "$name.dydb" > /dev/null 2>&1 || true
+    cmp -s "$name.dyd" "$expected" || fail "$name.dyd converted from .dydb differs from the old formatter"
+done
+
+# 重复后不再是一个合法的程序，但.dyd只取决于词法分析
+for i in $(seq 1 160); do
+    cat "$ROOT/tests/dyd/generated.pas"
+done > big.pas
+"$COMPILER" -dyd big.pas > /dev/null 2>&1 || true
+# 最后一条EOF记录后没有换行，awk补上换行后比较
+awk '{ printf "%16s %s\n", $1, $2 }' big.dyd > reformatted.dyd
+{ cat big.dyd; echo; } | cmp -s - reformatted.dyd || fail "big.dyd is not in the fixed-width layout"
+
+sources=$(ls "$ROOT"/*.cpp | grep -v '/main\.cpp$')
+${CXX:-g++} -std=c++17 ${CXXFLAGS:--O2} -pthread -I"$ROOT" "$ROOT/tests/dyd_throughput.cpp" $sources -o dyd_throughput
+./dyd_throughput big.pas 3 > throughput.txt || fail "$(cat throughput.txt)"
+cat throughput.txt
+measured=$(awk '$1 == "speedup" { print $2 }' throughput.txt)
+baseline=${DYD_BASELINE:-$(awk '$1 == "dyd_speedup" { print $2 }' "$ROOT/tests/dyd/throughput.baseline")}
+minimum=$(awk -v b="$baseline" -v t="${DYD_TOLERANCE:-0.5}" 'BEGIN { printf "%.1f", b * t }')
+awk -v m="$measured" -v n="$minimum" 'BEGIN { exit !(m >= n) }' \
+    || fail ".dyd writing is only $measured times as fast as with the old formatter (minimum $minimum)"
+
+finish
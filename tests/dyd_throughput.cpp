@@ -0,0 +1,109 @@
+// .dydʽʶաڲֿĿ¼±룺
+//     g++ -std=c++17 -O2 -pthread -I. tests/dyd_throughput.cpp $(ls *.cpp | grep -v main.cpp) -o dyd_throughput
+// ÷
+//     ./dyd_throughput Դ []
+//         ԴֱִظɴΣĬ3ΣȡһΣһǴʷд.dydþɵĸʽ
+//         ÿԪһstringstreamsetw(16)std::endlˢ£ѵԪдǰĿ¼reference.dyd
+//         Ǵʷд.dydߵÿ뵥ԪֵдĽͬʱ1
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include "lexical_analyzer.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int KEY_WIDTH = 16;
+
+// ΪformatRecord֮ǰĸʽհ
+static std::string format(const std::string& key, const std::string& type)
+{
+    std::stringstream ss;
+    ss << std::setw(KEY_WIDTH) << std::right << key << " " << type;
+    return ss.str();
+}
+
+// ɵдд.dydдEOLNEOF֮󲻻
+static void saveReference(const TokenView& tokens, const std::string& fileName)
+{
+    std::ofstream output(fileName, std::ios::out);
+    uint32_t line = 1;
+    for (size_t i = 0; i < tokens.count; ++i)
+    {
+        const Token& token = tokens.tokens[i];
+        for (; line < token.line; ++line)
+        {
+            output << format("EOLN", tokenCode(TokenKind::EOLN)) << std::endl;
+        }
+        if (token.kind == TokenKind::END_OF_FILE)
+        {
+            output << format(tokens.lexeme(i), tokenCode(token.kind));
+        }
+        else
+        {
+            output << format(tokens.lexeme(i), tokenCode(token.kind)) << std::endl;
+        }
+    }
+}
+
+static std::string readFile(const std::string& fileName)
+{
+    std::ifstream input(fileName, std::ios::binary);
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    return buffer.str();
+}
+
+// ظrunsΣһε
+template <typename Run>
+static double fastest(int runs, Run run)
+{
+    double best = 0;
+    for (int r = 0; r < runs; ++r)
+    {
+        Clock::time_point start = Clock::now();
+        run();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (r == 0 || seconds < best) best = seconds;
+    }
+    return best > 0 ? best : 1e-9;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: %s source [runs]\n", argv[0]);
+        return 2;
+    }
+    std::string sourceFileName = argv[1];
+    std::string dydFileName = sourceFileName.substr(0, sourceFileName.find_last_of(".")) + ".dyd";
+    int runs = argc > 2 ? std::atoi(argv[2]) : 3;
+    TokenBuffer tokens;
+    Diagnostics diagnostics("lexicalError.err");
+
+    double reference = fastest(runs, [&]()
+    {
+        tokens = TokenBuffer();
+        lexical_analyzer(sourceFileName, tokens, diagnostics, false);
+        saveReference(tokens.view(), "reference.dyd");
+    });
+    double current = fastest(runs, [&]()
+    {
+        tokens = TokenBuffer();
+        lexical_analyzer(sourceFileName, tokens, diagnostics, true);
+    });
+    double count = static_cast<double>(tokens.tokens.size());
+    std::printf("old formatter: %.0f tokens/s\n", count / reference);
+    std::printf("new formatter: %.0f tokens/s\n", count / current);
+    std::printf("speedup %.1f\n", reference / current);
+    if (readFile("reference.dyd") != readFile(dydFileName))
+    {
+        std::printf("the two formatters wrote different files\n");
+        return 1;
+    }
+    return 0;
+}
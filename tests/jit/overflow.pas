@@ -0,0 +1,13 @@
+begin
+ integer n;
+ integer r;
+ integer function D(k);
+  begin
+   integer k;
+   if k<=0 then D:=0
+   else D:=D(k-1)-1
+  end;
+ read(n);
+ r:=D(n);
+ write(r)
+end
@@ -0,0 +1,15 @@
+begin
+ integer a;
+ integer s;
+ s:=0;
+ read(a);
+ write(a);
+ s:=s-a;
+ read(a);
+ write(a);
+ s:=s-a;
+ read(a);
+ write(a);
+ s:=s-a;
+ write(s)
+end
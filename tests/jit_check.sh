@@ -0,0 +1,83 @@
+#!/bin/bash
+# -jit与-run的对照检查：同一程序和输入分别用虚拟机（-run）和本地代码（-jit）运行，
+# 不加优化、-O、-memo、-O -memo四种组合下，标准输出、退出码和运行时错误信息都必须相同。
+# 程序包括：
+#   1. -generate生成的程序（读完输入后以读语句失败结束，部分以调用栈溢出结束），输入是随机整数；
+#   2. benchmarks中的程序和README中的示例程序；
+#   3. tests/jit中的程序：调用栈溢出、读语句失败（输入耗尽或不是整数）。
+# JIT_SEEDS指定生成程序的个数（默认6）
+set -eu
+source "$(dirname "$0")/common.sh"
+cd "$WORK"
+
+CASES=0
+
+# 用一组选项运行，输出写入前缀为$3的三个文件：stdout、退出码、stderr中的运行时错误
+run()
+{
+    local source=$1 input=$2 prefix=$3
+    shift 3
+    local status=0
+    timeout "${JIT_TIMEOUT:-120}" "$COMPILER" "$@" "$source" < "$input" > "$prefix.out" 2> "$prefix.err" || status=$?
+    echo "$status" > "$prefix.status"
+    grep -q "JIT is not available" "$prefix.err" && NATIVE=0
+    grep "^Runtime error" "$prefix.err" > "$prefix.error" || true
+}
+
+# check 名称 源程序 输入文件
+check()
+{
+    local name=$1 source=$2 input=$3
+    for flags in "" "-O" "-memo" "-O -memo"; do
+        run "$source" "$input" vm -run $flags
+        run "$source" "$input" jit -jit $flags
+        CASES=$((CASES + 1))
+        local label="$name${flags:+ $flags}"
+        cmp -s vm.status jit.status || fail "$label: exit status $(cat vm.status) with -run, $(cat jit.status) with -jit"
+        cmp -s vm.out jit.out || fail "$label: output differs between -run and -jit"
+        cmp -s vm.error jit.error || fail "$label: runtime error '$(cat vm.error)' with -run, '$(cat jit.error)' with -jit"
+    done
+}
+
+# input 文件名 内容：写出一个输入文件
+input()
+{
+    printf '%s\n' "$2" > "$1"
+}
+
+NATIVE=1
+awk 'BEGIN { srand(7); for (i = 0; i < 5000; ++i) printf "%d\n", int(rand() * 41) - 20 }' > random.in
+for seed in $(seq 1 "${JIT_SEEDS:-6}"); do
+    "$COMPILER" -generate 16K -seed "$seed" "generated$seed.pas" 2> /dev/null
+    check "generated$seed" "generated$seed.pas" random.in
+done
+
+input twenty.in 20
+input zero.in 0
+input negative.in -3
+input empty.in ""
+input letters.in "abc"
+input deep.in 100000000
+for name in calls recursion; do
+    for data in twenty zero negative empty letters; do
+        check "$name < $data" "$ROOT/benchmarks/$name.pas" "$data.in"
+    done
+done
+check "recursion < deep" "$ROOT/benchmarks/recursion.pas" deep.in
+for data in twenty empty; do
+    check "readme < $data" "$ROOT/tests/dyd/readme.pas" "$data.in"
+done
+
+for data in twenty deep empty; do
+    check "overflow < $data" "$ROOT/tests/jit/overflow.pas" "$data.in"
+done
+input three.in "1 2 3"
+input two.in "1 2"
+input mixed.in "1 x 3"
+for data in three two mixed empty; do
+    check "reads < $data" "$ROOT/tests/jit/reads.pas" "$data.in"
+done
+
+echo "$CASES comparisons"
+[ "$NATIVE" = 1 ] || echo "note: the JIT is not available on this machine, -jit ran the interpreter"
+finish
@@ -0,0 +1,102 @@
+#!/bin/bash
+# 语法分析的深度和长度检查：在256 KB的栈上（ulimit -s 256）分别编译
+#   1. 主程序中有100万条语句的程序；
+#   2. 嵌套20万层的条件语句；
+#   3. 嵌套10万层的函数说明；
+#   4. 嵌套20万层的函数调用。
+# 普通路径和-pipe流水线都必须正常结束、没有任何错误，变量表和过程表的行数与程序一致。
+# STRESS_SCALE可按比例缩小规模（如0.1），便于快速试跑
+set -eu
+source "$(dirname "$0")/common.sh"
+cd "$WORK"
+
+scale=${STRESS_SCALE:-1}
+count()
+{
+    awk -v n="$1" -v s="$scale" 'BEGIN { printf "%d", n * s }'
+}
+statements=$(count 1000000)
+conditions=$(count 200000)
+functions=$(count 100000)
+calls=$(count 200000)
+
+awk -v n="$statements" 'BEGIN {
+    print "begin"
+    print "  integer x;"
+    print "  read(x);"
+    for (i = 1; i < n; ++i) print "  x:=x-1;"
+    print "  write(x)"
+    print "end"
+}' > statements.pas
+
+awk -v n="$conditions" 'BEGIN {
+    print "begin"
+    print "  integer x;"
+    print "  read(x);"
+    for (i = 0; i < n; ++i) printf "if x>%d then ", i
+    print "x:=0"
+    for (i = 0; i < n; i += 2) printf "else x:=%d ", i
+    print ";"
+    print "  write(x)"
+    print "end"
+}' > conditions.pas
+
+awk -v n="$functions" 'BEGIN {
+    print "begin"
+    print "  integer x;"
+    for (i = 1; i <= n; ++i)
+    {
+        printf "integer function f%d(p%d);\nbegin\n", i, i
+    }
+    printf "integer v;\nv:=p%d;\nf%d:=v\nend\n", n, n
+    for (i = n - 1; i >= 1; --i)
+    {
+        printf ";\nf%d:=f%d(p%d)\nend\n", i, i + 1, i
+    }
+    print ";"
+    print "  read(x);"
+    print "  x:=f1(x);"
+    print "  write(x)"
+    print "end"
+}' > functions.pas
+
+awk -v n="$calls" 'BEGIN {
+    print "begin"
+    print "  integer x;"
+    print "  integer function f(a);"
+    print "  begin"
+    print "    integer b;"
+    print "    f:=a-1"
+    print "  end;"
+    print "  read(x);"
+    printf "  x:="
+    for (i = 0; i < n; ++i) printf "f("
+    printf "x"
+    for (i = 0; i < n; ++i) printf ")"
+    print ";"
+    print "  write(x)"
+    print "end"
+}' > calls.pas
+
+# 期望的变量表和过程表行数
+declare -A variables=([statements]=1 [conditions]=1 [functions]=$((2 + functions)) [calls]=3)
+declare -A procedures=([statements]=0 [conditions]=0 [functions]=$functions [calls]=1)
+
+for name in statements conditions functions calls; do
+    for mode in plain pipe; do
+        rm -f variableList.var processList.pro lexicalError.err grammarError.err
+        flags=""
+        [ "$mode" = pipe ] && flags="-pipe"
+        if ! (ulimit -s 256 && exec "$COMPILER" $flags "$name.pas") > output.txt 2>&1; then
+            fail "$name ($mode) did not finish under a 256 KB stack: $(tail -n 3 output.txt)"
+            continue
+        fi
+        [ -s lexicalError.err ] && fail "$name ($mode) reported lexical errors: $(head -n 3 lexicalError.err)"
+        [ -s grammarError.err ] && fail "$name ($mode) reported grammar errors: $(head -n 3 grammarError.err)"
+        [ "$(wc -l < variableList.var)" -eq "${variables[$name]}" ] || fail "$name ($mode): unexpected variable table"
+        [ "$(wc -l < processList.pro)" -eq "${procedures[$name]}" ] || fail "$name ($mode): unexpected procedure table"
+    done
+    echo "$name: $(wc -l < "$name.pas") lines"
+done
+
+finish
@@ -0,0 +1,189 @@
+// Ựļ顣ڲֿĿ¼±룺
+//     g++ -std=c++17 -O2 -pthread -I. tests/session_edits.cpp $(ls *.cpp | grep -v main.cpp) -o session_edits
+// ÷
+//     ./session_edits Դ  ༭
+//         ༭롢ɾ滻Сз󣩣ÿα༭Լ
+//         ȫĵcompileSourceĽȽϣһʱȫдsession_failure.pas1
+//     ./session_edits -time Դ []
+//         ĩβִϸһɾһոɾÿα༭ƽʱĺʱ
+//         Щ༭·򣬻ƽʱĶʮ֮һʱ1
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include "compile_session.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static std::string dumpVars(const std::vector<VarUnit>& vars)
+{
+    std::string text;
+    for (const auto& var : vars)
+    {
+        text += var.vName + "|" + var.vProc + "|" + std::to_string(var.vKind) + "|" + std::to_string(var.vLev) + "|" + std::to_string(var.vAdr) + "\n";
+    }
+    return text;
+}
+
+static std::string dumpPros(const std::vector<ProUnit>& pros)
+{
+    std::string text;
+    for (const auto& pro : pros)
+    {
+        text += pro.pName + "|" + std::to_string(pro.pLev) + "|" + std::to_string(pro.fAdr) + "|" + std::to_string(pro.lAdr) + "\n";
+    }
+    return text;
+}
+
+// ỰĽȫĽǷһ
+static bool matches(const CompileSession& session, const std::string& text, const CompileOptions& options)
+{
+    CompileResult expected;
+    compileSource(text, options, expected);
+    return dumpVars(expected.varList) == dumpVars(session.getVarList())
+        && dumpPros(expected.proList) == dumpPros(session.getProList())
+        && expected.lexicalDiagnostics.text() == session.lexicalDiagnostics().text()
+        && expected.grammarDiagnostics.text() == session.grammarDiagnostics().text()
+        && expected.stopped == session.isStopped();
+}
+
+// пͷȫеλãеĹỰͬ
+static std::vector<size_t> lineStarts(const std::string& text)
+{
+    std::vector<size_t> starts(1, 0);
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] == '\r' && i + 1 < text.size() && text[i + 1] == '\n') ++i;
+        if (text[i] == '\n' || text[i] == '\r') starts.push_back(i + 1);
+    }
+    return starts;
+}
+
+// ȫpositionǵڼеڼУ1ʼ
+static TextEdit editAt(const std::string& text, size_t position)
+{
+    std::vector<size_t> starts = lineStarts(text);
+    size_t line = 0;
+    while (line + 1 < starts.size() && starts[line + 1] <= position) ++line;
+    return TextEdit{ line + 1, position - starts[line] + 1, 0, std::string() };
+}
+
+static int checkEdits(const std::string& source, unsigned seed, int edits)
+{
+    static const char* const snippets[] = { "x", " ", ";", "\n", "v1:=2", "integer q;\n", "begin", "end", "(", ")",
+        "\r\n", "\r", "?", "  write(v1);\n", "integer function g(a);\nbegin integer b; b:=a end;\n",
+        "if v1<2 then v1:=1\n", ":", "m", "k:=k-1;\n", "  integer w;\n", "  m:=zz;\n", "*2", "-m" };
+    CompileOptions options;
+    options.maxErrors = 20;
+    options.columns = true; // кҲͬ
+    CompileSession session(options);
+    session.open(source);
+    std::mt19937 random(seed);
+    for (int e = 0; e < edits; ++e)
+    {
+        std::string before = session.text();
+        size_t position = random() % (before.size() + 1);
+        TextEdit edit = editAt(before, position);
+        unsigned kind = random() % 3;
+        if (kind != 1) edit.text = snippets[random() % (sizeof(snippets) / sizeof(snippets[0]))];
+        if (kind != 0) edit.length = random() % 8;
+        // ɾĳȰֽڼƣ\r\nм䣬ȫĵʵʱ仯Ϊ׼
+        std::string after = before.substr(0, position) + edit.text
+            + (position + edit.length < before.size() ? before.substr(position + edit.length) : std::string());
+        if (!session.applyEdit(edit) || session.text() != after || !matches(session, after, options))
+        {
+            std::printf("seed %u edit %d (line %zu column %zu length %zu) differs from a full compile\n",
+                seed, e, edit.line, edit.column, edit.length);
+            std::ofstream("session_failure.pas", std::ios::binary) << after;
+            return 1;
+        }
+        if (random() % 4 != 0)
+        {
+            // ɾıŻɾı
+            TextEdit undo = editAt(after, position);
+            undo.length = edit.text.size();
+            undo.text = before.substr(position, std::min(edit.length, before.size() - position));
+            if (!session.applyEdit(undo) || session.text() != before || !matches(session, before, options))
+            {
+                std::printf("seed %u undo of edit %d differs from a full compile\n", seed, e);
+                std::ofstream("session_failure.pas", std::ios::binary) << before;
+                return 1;
+            }
+        }
+        if (session.isStopped() && random() % 4 == 0) session.open(source);
+    }
+    std::printf("seed %u: %d edits, %zu full and %zu local parses\n", seed, edits, session.fullParseCount(), session.localParseCount());
+    return 0;
+}
+
+static int timeEdits(const std::string& source, int rounds)
+{
+    CompileOptions options;
+    CompileSession session(options);
+    session.open(source);
+    std::vector<size_t> starts = lineStarts(source);
+    if (starts.size() < 3)
+    {
+        std::printf("the program is too short\n");
+        return 1;
+    }
+    size_t window = std::min<size_t>(200, starts.size() - 2); // һend֮ǰ
+    size_t fullBefore = session.fullParseCount();
+    std::mt19937 random(1);
+    double total = 0;
+    for (int r = 0; r < rounds; ++r)
+    {
+        size_t line = starts.size() - 1 - random() % window;
+        std::string copy = source.substr(starts[line - 1], starts[line] - starts[line - 1]);
+        Clock::time_point start = Clock::now();
+        session.applyEdit(TextEdit{ line, 1, 0, copy });
+        session.grammarDiagnostics();
+        session.applyEdit(TextEdit{ line, 1, copy.size(), std::string() });
+        session.grammarDiagnostics();
+        session.applyEdit(TextEdit{ line, 1, 0, " " });
+        session.grammarDiagnostics();
+        session.applyEdit(TextEdit{ line, 1, 1, std::string() });
+        session.grammarDiagnostics();
+        total += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+    double perEdit = total / (rounds * 4.0);
+    Clock::time_point start = Clock::now();
+    CompileResult result;
+    compileSource(source, options, result);
+    double full = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    size_t fullParses = session.fullParseCount() - fullBefore;
+    std::printf("%zu lines: %.1f us per edit, full compile %.1f us, %zu full parses during the edits\n",
+        starts.size(), perEdit, full, fullParses);
+    if (session.text() != source || fullParses != 0 || perEdit * 20 > full)
+    {
+        std::printf("edits near the end of the main program are not local\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    bool timing = argc > 1 && std::string(argv[1]) == "-time";
+    if (argc < (timing ? 3 : 4))
+    {
+        std::fprintf(stderr, "Usage: %s source seed edits | -time source [rounds]\n", argv[0]);
+        return 2;
+    }
+    std::ifstream input(argv[timing ? 2 : 1], std::ios::binary);
+    if (!input.is_open())
+    {
+        std::fprintf(stderr, "Could not open the file - '%s'\n", argv[timing ? 2 : 1]);
+        return 2;
+    }
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    if (timing)
+    {
+        return timeEdits(buffer.str(), argc > 3 ? std::atoi(argv[3]) : 200);
+    }
+    return checkEdits(buffer.str(), static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)), std::atoi(argv[3]));
+}
@@ -0,0 +1,25 @@
+#!/bin/bash
+# 增量编译会话的检查（驱动程序见session_edits.cpp）：
+# 1. 在tests/dyd和benchmarks中的程序以及生成的带错误的程序上随机编辑，每次编辑和撤销后的结果
+#    都必须与完整编译相同，SESSION_EDITS指定每个种子的编辑次数（默认300）；
+# 2. 在生成的8M程序的主程序末尾编辑，不得重新分析整个程序，每次编辑的耗时不得超过完整编译的二十分之一
+set -eu
+source "$(dirname "$0")/common.sh"
+cd "$WORK"
+
+sources=$(ls "$ROOT"/*.cpp | grep -v '/main\.cpp$')
+${CXX:-g++} -std=c++17 ${CXXFLAGS:--O2} -pthread -I"$ROOT" "$ROOT/tests/session_edits.cpp" $sources -o session_edits
+
+for seed in 1 2 3; do
+    "$COMPILER" -generate 32K -seed "$seed" -errors 0.02 "generated$seed.pas" 2> /dev/null
+done
+for source in "$ROOT"/tests/dyd/*.pas "$ROOT"/benchmarks/*.pas generated*.pas; do
+    for seed in 1 2 3 4; do
+        ./session_edits "$source" "$seed" "${SESSION_EDITS:-300}" > result.txt || fail "$(basename "$source"): $(cat result.txt)"
+    done
+done
+
+"$COMPILER" -generate 8M -seed 1 big.pas 2> /dev/null
+./session_edits -time big.pas || fail "edits at the end of the main program of big.pas re-parse too much"
+
+finish
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include "token_file.h"
+
+bool encodeBinaryTokens(const TokenView& tokens, std::string& out) {
+    if (tokens.count > UINT32_MAX) return false;
+    // ½ȥصĵʳأд¼offset
+    std::vector<Token> records(tokens.tokens, tokens.tokens + tokens.count);
+    std::string pool;
+    std::unordered_map<std::string, uint32_t> offsets;
+    for (auto& record : records) {
+        std::string lexeme(tokens.pool + record.offset, record.length);
+        auto it = offsets.find(lexeme);
+        if (it == offsets.end()) {
+            if (pool.size() + lexeme.size() > UINT32_MAX) return false;
+            it = offsets.emplace(lexeme, static_cast<uint32_t>(pool.size())).first;
+            pool += lexeme;
+        }
+        record.offset = it->second;
+    }
+
+    TokenFileHeader header;
+    std::memcpy(header.magic, "DYDB", 4);
+    header.version = TOKEN_FILE_VERSION;
+    header.tokenCount = static_cast<uint32_t>(records.size());
+    header.poolSize = static_cast<uint32_t>(pool.size());
+
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Token));
+    out.append(pool);
+    return true;
+}
+
+bool saveBinaryTokenFile(const TokenView& tokens, const std::string& fileName) {
+    std::string image;
+    if (!encodeBinaryTokens(tokens, image)) {
+        std::cerr << "Token list is too large for a token file - '" << fileName << "'" << std::endl;
+        return false;
+    }
+    std::ofstream output(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Could not open the file - '" << fileName << "'" << std::endl;
+        return false;
+    }
+    output.write(image.data(), static_cast<std::streamsize>(image.size()));
+    return output.good();
+}
+
+bool viewBinaryTokens(const char* data, size_t size, TokenView& view) {
+    TokenFileHeader header;
+    if (size < sizeof(header)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, "DYDB", 4) != 0 || header.version != TOKEN_FILE_VERSION) return false;
+    // ósize_tֻ32λʱ˻Ҳ
+    size_t rest = size - sizeof(header);
+    if (header.tokenCount > rest / sizeof(Token)
+        || rest - static_cast<size_t>(header.tokenCount) * sizeof(Token) != header.poolSize) {
+        return false;
+    }
+    view.tokens = reinterpret_cast<const Token*>(data + sizeof(header));
+    view.count = header.tokenCount;
+    view.pool = data + sizeof(header) + static_cast<size_t>(header.tokenCount) * sizeof(Token);
+    // ÿ¼ڵʳڣ֮﷨ԲӼʹ
+    for (size_t i = 0; i < view.count; ++i) {
+        const Token& token = view.tokens[i];
+        if (static_cast<size_t>(token.offset) + token.length > header.poolSize
+            || token.kind < TokenKind::BEGIN || token.kind > TokenKind::END_OF_FILE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool mapBinaryTokenFile(const std::string& fileName, SourceBuffer& file, TokenView& view) {
+    if (!openSourceBuffer(fileName, file)) {
+        std::cerr << "Could not open the file - '" << fileName << "'" << std::endl;
+        return false;
+    }
+    if (!viewBinaryTokens(file.data, file.size, view)) {
+        std::cerr << "Invalid token file - '" << fileName << "'" << std::endl;
+        closeSourceBuffer(file);
+        return false;
+    }
+    return true;
+}
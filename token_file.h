@@ -0,0 +1,36 @@
+#ifndef TOKEN_FILE_H
+#define TOKEN_FILE_H
+
+#include <string>
+#include <cstdint>
+#include "lexical_analyzer.h"
+
+// ƵԪļ(.dydb)ļͷĵԪ¼飨Token飩ȥغĵʳδţ
+// ¼еoffsetָ򵥴ʳءֽСˣţӳڴֱӽ﷨ʹ
+struct TokenFileHeader {
+    char magic[4]; // ̶Ϊ"DYDB"
+    uint32_t version; // ʽ汾
+    uint32_t tokenCount; // Ԫ
+    uint32_t poolSize; // ʳֽ
+};
+
+// 汾2¼дкţҲEOLNԪ
+const uint32_t TOKEN_FILE_VERSION = 2;
+static_assert(sizeof(Token) == 12, "Token must match the on-disk record layout");
+
+// ѵԪаƵԪļĸʽ׷ӵoutʳͬĵֻһݣ
+// Ԫ򵥴ʳصĳȳļͷ32λķΧʱfalseout
+bool encodeBinaryTokens(const TokenView& tokens, std::string& out);
+
+// ѵԪдɶƵԪļԪʱ󲢷false
+bool saveBinaryTokenFile(const TokenView& tokens, const std::string& fileName);
+
+// ڴеĶƵԪļӳͨviewֱеļ¼͵ʳأdata밴4ֽڶ룬
+// ʽԡļͷеĸ볤Ȳм¼Խʳʱfalse
+bool viewBinaryTokens(const char* data, size_t size, TokenView& view);
+
+// ѶƵԪļӳڴ棬ļͷͨviewֱеļ¼͵ʳأ
+// fileʹviewڼ뱣ִ򿪣closeSourceBufferͷ
+bool mapBinaryTokenFile(const std::string& fileName, SourceBuffer& file, TokenView& view);
+
+#endif
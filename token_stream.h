@@ -0,0 +1,247 @@
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "lexical_analyzer.h"
+
+// ʷ̺߳﷨֮߳н絥ߵ߻ζС
+// ÿһԪʽTokenBuffer֮ѭã
+// ڴռֻȡڲÿĴСԴܵԪ޹
+class TokenRing
+{
+private:
+    std::vector<TokenBuffer> slots; // Ԫʽ
+    alignas(64) std::atomic<size_t> head; // ύ
+    alignas(64) std::atomic<size_t> tail; // ͷŵ
+    std::atomic<bool> closed; // ύһ
+
+public:
+    static const size_t DEFAULT_SLOTS = 8;
+    static const size_t DEFAULT_BATCH = 4096;
+
+    const size_t batchSize; // ÿĵԪдύ
+
+    // 캯Ϊ2֤ǰ֮⻹һ
+    explicit TokenRing(size_t slotCount = DEFAULT_SLOTS, size_t batchSize = DEFAULT_BATCH)
+        :slots(slotCount < 2 ? 2 : slotCount)
+        ,head(0)
+        ,tail(0)
+        ,closed(false)
+        ,batchSize(batchSize < 4 ? 4 : batchSize)
+    {}
+
+    TokenRing(const TokenRing&) = delete;
+    TokenRing& operator=(const TokenRing&) = delete;
+
+    // 
+    size_t capacity() const
+    {
+        return slots.size();
+    }
+
+    // ߣȡһղۣʱȴͷţصĲ
+    TokenBuffer& beginPush()
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        while (h - tail.load(std::memory_order_acquire) >= slots.size())
+        {
+            std::this_thread::yield();
+        }
+        TokenBuffer& slot = slots[h % slots.size()];
+        slot.clear();
+        return slot;
+    }
+
+    // ߣύbeginPushȡõĲ
+    void commitPush()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ߣύµ
+    void close()
+    {
+        closed.store(true, std::memory_order_release);
+    }
+
+    // ߣȡõǰ֮ĵkk=0Ϊǰδʱȴ
+    // ѽûһʱnullptrkСڲ
+    const TokenBuffer* peek(size_t k)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        while (head.load(std::memory_order_acquire) <= t + k)
+        {
+            if (closed.load(std::memory_order_acquire))
+            {
+                // close֮ǰύѿɼȷһ
+                if (head.load(std::memory_order_acquire) <= t + k) return nullptr;
+                break;
+            }
+            std::this_thread::yield();
+        }
+        return &slots[(t + k) % slots.size()];
+    }
+
+    // ߣͷŵǰ
+    void pop()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+// ﷨ȡԪαꡣԪһĵԪУ
+// ҲTokenRingһֻеǰǰһ
+class TokenReader
+{
+private:
+    const Token* tokens; // ǰεĵԪ
+    const char* pool; // ǰεĵʳ
+    size_t count; // ǰεĵԪ
+    size_t position; // ڵǰеλ
+    size_t base; // ǰ֮ǰѶĵԪ
+    TokenRing* ring; // Ϊnullptrʱоǵǰ
+
+    // ʱȡoffsetԪoffsetӵǰλ𣩣ûʱnullptr
+    // segmentPoolظõԪڶεĵʳ
+    const Token* farToken(size_t offset, const char*& segmentPool) const
+    {
+        if (ring == nullptr) return nullptr;
+        size_t index = position + offset - count;
+        for (size_t k = 1; k < ring->capacity(); ++k)
+        {
+            const TokenBuffer* batch = ring->peek(k);
+            if (batch == nullptr) return nullptr;
+            if (index < batch->tokens.size())
+            {
+                segmentPool = batch->pool.data();
+                return &batch->tokens[index];
+            }
+            index -= batch->tokens.size();
+        }
+        return nullptr;
+    }
+
+    // װ뻷ζеĵǰ
+    void loadBatch()
+    {
+        const TokenBuffer* batch = ring->peek(0);
+        if (batch == nullptr)
+        {
+            tokens = nullptr;
+            pool = nullptr;
+            count = 0;
+        }
+        else
+        {
+            tokens = batch->tokens.data();
+            pool = batch->pool.data();
+            count = batch->tokens.size();
+        }
+        position = 0;
+    }
+
+public:
+    // ȡһĵԪ
+    explicit TokenReader(const TokenView& view)
+        :tokens(view.tokens)
+        ,pool(view.pool)
+        ,count(view.count)
+        ,position(0)
+        ,base(0)
+        ,ring(nullptr)
+    {}
+
+    // ӻζжȡһδʱȴ
+    explicit TokenReader(TokenRing& source)
+        :tokens(nullptr)
+        ,pool(nullptr)
+        ,count(0)
+        ,position(0)
+        ,base(0)
+        ,ring(&source)
+    {
+        loadBatch();
+    }
+
+    // ûκεԪ
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    // ǰԪԪе±
+    size_t index() const
+    {
+        return base + position;
+    }
+
+    // ǰoffsetԪֱԽʱΪļ
+    TokenKind kind(size_t offset = 0) const
+    {
+        if (position + offset < count) return tokens[position + offset].kind;
+        const char* segmentPool;
+        const Token* token = farToken(offset, segmentPool);
+        return token != nullptr ? token->kind : TokenKind::END_OF_FILE;
+    }
+
+    // ǰԪڵУûκεԪʱΪ1
+    uint32_t line() const
+    {
+        return count > 0 ? tokens[position].line : 1;
+    }
+
+    // ǰԪڵУ0ʾδ֪
+    uint16_t column() const
+    {
+        return count > 0 ? tokens[position].column : 0;
+    }
+
+    // ǰoffsetԪĵʣԽʱΪմ
+    std::string lexeme(size_t offset = 0) const
+    {
+        if (position + offset < count)
+        {
+            const Token& token = tokens[position + offset];
+            return std::string(pool + token.offset, token.length);
+        }
+        const char* segmentPool = nullptr;
+        const Token* token = farToken(offset, segmentPool);
+        return token != nullptr ? std::string(segmentPool + token->offset, token->length) : std::string();
+    }
+
+    // ƵһԪһԪʱfalse
+    bool step()
+    {
+        if (position + 1 < count)
+        {
+            ++position;
+            return true;
+        }
+        if (ring == nullptr || ring->peek(1) == nullptr) return false;
+        base += count;
+        ring->pop();
+        loadBatch();
+        return true;
+    }
+
+    // һԪȡζʱʣµȫȡ꣬ʹܹ
+    void skipToEnd()
+    {
+        if (ring == nullptr)
+        {
+            if (count > 0) position = count - 1;
+            return;
+        }
+        while (ring->peek(1) != nullptr)
+        {
+            base += ring->peek(0)->tokens.size();
+            ring->pop();
+        }
+        loadBatch();
+        if (count > 0) position = count - 1;
+    }
+};
+
+#endif
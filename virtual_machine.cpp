@@ -0,0 +1,297 @@
+#include <chrono>
+#include "virtual_machine.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VM_THREADED_DISPATCH 1
+#endif
+
+// ԤָhandlerǴòıǩֱַʱΪnullptr
+struct ThreadedInstruction
+{
+    const void* handler;
+    Opcode op;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+};
+
+// ߵֳ
+struct CallFrame
+{
+    const ThreadedInstruction* returnPc; // غִеָ
+    size_t base; // ֡
+    uint32_t frameSize; // ֡ĴС
+    uint32_t level; // ߵĲ
+    uint32_t result; // ŷֵĵ߼Ĵ
+};
+
+// 㰴64λƣз
+static inline long long wrapSubtract(long long x, long long y)
+{
+    return static_cast<long long>(static_cast<unsigned long long>(x) - static_cast<unsigned long long>(y));
+}
+
+static inline long long wrapMultiply(long long x, long long y)
+{
+    return static_cast<long long>(static_cast<unsigned long long>(x) * static_cast<unsigned long long>(y));
+}
+
+RunStatus VirtualMachine::run(const BytecodeProgram& program, std::istream& input, std::ostream& output)
+{
+    auto start = std::chrono::steady_clock::now();
+    stats = RunStatistics();
+    if (memo != nullptr) memo->clear();
+
+#ifdef VM_THREADED_DISPATCH
+    // ˳Opcodeһ
+    static const void* const handlers[] = {
+        &&op_MOVE, &&op_CONSTANT, &&op_GET_GLOBAL, &&op_SET_GLOBAL, &&op_GET_OUTER, &&op_SET_OUTER,
+        &&op_SUBTRACT, &&op_MULTIPLY, &&op_JUMP,
+        &&op_JUMP_IF_LESS, &&op_JUMP_IF_LESS_OR_EQUALS, &&op_JUMP_IF_GREATER,
+        &&op_JUMP_IF_GREATER_OR_EQUALS, &&op_JUMP_IF_EQUALS, &&op_JUMP_IF_NOT_EQUALS,
+        &&op_CALL, &&op_CALL_MEMO, &&op_MEMO_STORE, &&op_RETURN, &&op_READ, &&op_WRITE, &&op_HALT,
+    };
+    static_assert(sizeof(handlers) / sizeof(handlers[0]) == static_cast<size_t>(Opcode::HALT) + 1,
+        "handler table must cover every opcode");
+#endif
+    std::vector<ThreadedInstruction> code(program.code.size());
+    for (size_t i = 0; i < code.size(); ++i)
+    {
+        const Instruction& instruction = program.code[i];
+#ifdef VM_THREADED_DISPATCH
+        code[i].handler = handlers[static_cast<size_t>(instruction.op)];
+#else
+        code[i].handler = nullptr;
+#endif
+        code[i].op = instruction.op;
+        code[i].a = instruction.a;
+        code[i].b = instruction.b;
+        code[i].c = instruction.c;
+    }
+
+    const long long* constants = program.constants.data();
+    const FunctionCode* functions = program.functions.data();
+    std::vector<CallFrame> frames;
+    registers.assign(program.mainFrameSize > 64 ? program.mainFrameSize : 64, 0);
+    long long* stack = registers.data(); // ȫ֡㣬ȡ
+    size_t base = 0; // ǰ֡
+    long long* r = stack; // ǰ֡ļĴ
+    uint32_t frameSize = program.mainFrameSize;
+    uint32_t level = 0;
+    const ThreadedInstruction* pc = code.data();
+    uint64_t executed = 0;
+    uint64_t calls = 0;
+    size_t deepest = 0;
+    RunStatus status = RunStatus::FINISHED;
+
+#ifdef VM_THREADED_DISPATCH
+#define HANDLER(name) op_##name:
+#define DISPATCH() do { ++executed; goto *pc->handler; } while (0)
+#else
+#define HANDLER(name) case Opcode::name:
+#define DISPATCH() goto dispatch
+#endif
+#define NEXT() do { ++pc; DISPATCH(); } while (0)
+
+#ifdef VM_THREADED_DISPATCH
+    DISPATCH();
+#else
+dispatch:
+    ++executed;
+    switch (pc->op)
+    {
+#endif
+
+    HANDLER(MOVE)
+        r[pc->a] = r[pc->b];
+        NEXT();
+
+    HANDLER(CONSTANT)
+        r[pc->a] = constants[pc->b];
+        NEXT();
+
+    HANDLER(GET_GLOBAL)
+        r[pc->a] = stack[pc->b];
+        NEXT();
+
+    HANDLER(SET_GLOBAL)
+        stack[pc->b] = r[pc->a];
+        NEXT();
+
+    HANDLER(GET_OUTER)
+    {
+        size_t frame = base;
+        for (uint32_t k = pc->c; k > 0; --k)
+        {
+            frame = static_cast<size_t>(stack[frame + STATIC_LINK_SLOT]);
+        }
+        r[pc->a] = stack[frame + pc->b];
+        NEXT();
+    }
+
+    HANDLER(SET_OUTER)
+    {
+        size_t frame = base;
+        for (uint32_t k = pc->c; k > 0; --k)
+        {
+            frame = static_cast<size_t>(stack[frame + STATIC_LINK_SLOT]);
+        }
+        stack[frame + pc->b] = r[pc->a];
+        NEXT();
+    }
+
+    HANDLER(SUBTRACT)
+        r[pc->a] = wrapSubtract(r[pc->b], r[pc->c]);
+        NEXT();
+
+    HANDLER(MULTIPLY)
+        r[pc->a] = wrapMultiply(r[pc->b], r[pc->c]);
+        NEXT();
+
+    HANDLER(JUMP)
+        pc = code.data() + pc->c;
+        DISPATCH();
+
+    HANDLER(JUMP_IF_LESS)
+        pc = r[pc->a] < r[pc->b] ? code.data() + pc->c : pc + 1;
+        DISPATCH();
+
+    HANDLER(JUMP_IF_LESS_OR_EQUALS)
+        pc = r[pc->a] <= r[pc->b] ? code.data() + pc->c : pc + 1;
+        DISPATCH();
+
+    HANDLER(JUMP_IF_GREATER)
+        pc = r[pc->a] > r[pc->b] ? code.data() + pc->c : pc + 1;
+        DISPATCH();
+
+    HANDLER(JUMP_IF_GREATER_OR_EQUALS)
+        pc = r[pc->a] >= r[pc->b] ? code.data() + pc->c : pc + 1;
+        DISPATCH();
+
+    HANDLER(JUMP_IF_EQUALS)
+        pc = r[pc->a] == r[pc->b] ? code.data() + pc->c : pc + 1;
+        DISPATCH();
+
+    HANDLER(JUMP_IF_NOT_EQUALS)
+        pc = r[pc->a] != r[pc->b] ? code.data() + pc->c : pc + 1;
+        DISPATCH();
+
+    HANDLER(CALL_MEMO)
+    {
+        long long cached = 0;
+        if (memo != nullptr && memo->find(pc->b, r[pc->c], cached))
+        {
+            r[pc->a] = cached;
+            pc += 2;
+            DISPATCH();
+        }
+        goto call;
+    }
+
+    HANDLER(MEMO_STORE)
+        if (memo != nullptr) memo->insert(pc->b, r[pc->c], r[pc->a]);
+        NEXT();
+
+    HANDLER(CALL)
+    call:
+    {
+        const FunctionCode& callee = functions[pc->b];
+        if (frames.size() >= maxDepth)
+        {
+            status = RunStatus::STACK_OVERFLOW;
+            goto finished;
+        }
+        // ֱڵǰ֡ľ̬ϣͬĺңڲ㺯ǵǰ֡
+        size_t link = base;
+        for (uint32_t k = level + 1 - callee.level; k > 0; --k)
+        {
+            link = static_cast<size_t>(stack[link + STATIC_LINK_SLOT]);
+        }
+        size_t calleeBase = base + frameSize;
+        if (calleeBase + callee.frameSize > registers.size())
+        {
+            size_t grown = registers.size() * 2;
+            registers.resize(grown > calleeBase + callee.frameSize ? grown : calleeBase + callee.frameSize);
+            stack = registers.data();
+            r = stack + base;
+        }
+        long long argument = r[pc->c];
+        frames.push_back(CallFrame{ pc + 1, base, frameSize, level, pc->a });
+        if (frames.size() > deepest) deepest = frames.size();
+        ++calls;
+        base = calleeBase;
+        r = stack + base;
+        frameSize = callee.frameSize;
+        level = callee.level;
+        r[RETURN_SLOT] = 0;
+        r[STATIC_LINK_SLOT] = static_cast<long long>(link);
+        r[PARAMETER_SLOT] = argument;
+        for (uint32_t k = PARAMETER_SLOT + 1; k < callee.variableCount; ++k)
+        {
+            r[k] = 0;
+        }
+        pc = code.data() + callee.entry;
+        DISPATCH();
+    }
+
+    HANDLER(RETURN)
+    {
+        long long value = r[RETURN_SLOT];
+        const CallFrame& caller = frames.back();
+        base = caller.base;
+        frameSize = caller.frameSize;
+        level = caller.level;
+        pc = caller.returnPc;
+        r = stack + base;
+        r[caller.result] = value;
+        frames.pop_back();
+        DISPATCH();
+    }
+
+    HANDLER(READ)
+    {
+        long long value = 0;
+        if (!(input >> value))
+        {
+            status = RunStatus::READ_FAILED;
+            goto finished;
+        }
+        r[pc->a] = value;
+        NEXT();
+    }
+
+    HANDLER(WRITE)
+        output << r[pc->a] << '\n';
+        NEXT();
+
+    HANDLER(HALT)
+        goto finished;
+
+#ifndef VM_THREADED_DISPATCH
+    }
+#endif
+#undef HANDLER
+#undef DISPATCH
+#undef NEXT
+
+finished:
+    stats.instructions = executed;
+    stats.calls = calls;
+    stats.maxDepth = deepest;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return status;
+}
+
+const char* VirtualMachine::describe(RunStatus status)
+{
+    switch (status)
+    {
+    case RunStatus::FINISHED:
+        return "finished";
+    case RunStatus::READ_FAILED:
+        return "read: no integer in input";
+    case RunStatus::STACK_OVERFLOW:
+        return "call stack overflow";
+    }
+    return "";
+}
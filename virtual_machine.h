@@ -0,0 +1,64 @@
+#ifndef VIRTUAL_MACHINE_H
+#define VIRTUAL_MACHINE_H
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "bytecode.h"
+#include "memo_table.h"
+
+// һеͳ
+struct RunStatistics
+{
+    uint64_t instructions = 0; // ִеָ
+    uint64_t calls = 0; // ô
+    size_t maxDepth = 0; // ĵò
+    double seconds = 0; // ʱ
+};
+
+// еĽ
+enum class RunStatus
+{
+    FINISHED, // 
+    READ_FAILED, // ûж
+    STACK_OVERFLOW, // ò
+};
+
+// ִֽ֡ļĴηһУʱڵǰ֮֡󿪱֡
+// GCCClangֱĽѭÿָԤȻɴıǩַswitch
+class VirtualMachine
+{
+private:
+    std::vector<long long> registers; // ȫ֡ļĴ
+    size_t maxDepth; // ò
+    MemoTable* memo; // CALL_MEMOMEMO_STOREʹõĻ棬ΪnullptrʱCALL_MEMOͬCALL
+    RunStatistics stats;
+
+public:
+    static const size_t DEFAULT_MAX_DEPTH = 4000000;
+
+    explicit VirtualMachine(size_t maxDepth = DEFAULT_MAX_DEPTH)
+        :maxDepth(maxDepth)
+        ,memo(nullptr)
+    {}
+
+    // ý棬ÿпʼʱ
+    void setMemoTable(MemoTable* table)
+    {
+        memo = table;
+    }
+
+    // г򣬶inputȡдÿֵһдoutput
+    RunStatus run(const BytecodeProgram& program, std::istream& input, std::ostream& output);
+
+    // һеͳ
+    const RunStatistics& statistics() const
+    {
+        return stats;
+    }
+
+    // н˵
+    static const char* describe(RunStatus status);
+};
+
+#endif